@@ -0,0 +1,100 @@
+/**
+ * @file actionLog.cpp
+ *
+ * Appends to the action log with and without waiting for the disk, and the recovery of
+ * many games.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <cstdio>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "actionLog.hpp"
+
+namespace
+{
+char const* const PATH = "actionLog_benchmark.log";
+const unsigned GAMES = 2000;
+const unsigned MOVES = 200;
+
+msm::Action move(unsigned i)
+{
+	return msm::Action(i % 7 ? msm::AT_REVEAL : msm::AT_CYCLEMARK, (i * 13) % 30, (i * 5) % 16);
+}
+}
+
+BENCHMARK(actionLog)
+{
+	msm::Dimensions const d(30, 16, 99);
+	std::remove(PATH);
+
+	// Without waiting: The writer syncs whatever piled up meanwhile
+	{
+		msm::ActionLog log(PATH);
+		bench::Timer t;
+		uint64_t last = 0;
+		for (unsigned g = 0; g < GAMES; ++g)
+		{
+			log.logReset(g, d, g);
+			for (unsigned i = 0; i < MOVES; ++i)
+				last = log.logAction(g, move(i));
+		}
+		double const appendMs = t.elapsedMs();
+		log.commit(last);
+		double const durableMs = t.elapsedMs();
+		bench::report("append", appendMs, last);
+		std::ostringstream what;
+		what << "append until durable (" << log.getSyncs() << " syncs)";
+		bench::report(what.str().c_str(), durableMs, last);
+	}
+
+	// Each move waits for the disk, the waiting players share the syncs
+	for (unsigned threads = 1; threads <= 16; threads *= 4)
+	{
+		std::remove(PATH);
+		msm::ActionLog log(PATH);
+		unsigned const moves = 2000 / threads;
+		bench::Timer t;
+		std::vector<std::thread> players;
+		for (unsigned p = 0; p < threads; ++p)
+			players.push_back(std::thread([&log, p, moves]()
+			{
+				for (unsigned i = 0; i < moves; ++i)
+					log.commit(log.logAction(p, move(i)));
+			}));
+		for (size_t p = 0; p < players.size(); ++p)
+			players[p].join();
+		double const ms = t.elapsedMs();
+
+		std::ostringstream what;
+		what << "append and commit, " << threads << " players (" << log.getAppended() / (double) log.getSyncs()
+				<< " per sync)";
+		bench::report(what.str().c_str(), ms, log.getAppended());
+	}
+
+	// Recovery of the log of the first part
+	std::remove(PATH);
+	{
+		msm::ActionLog log(PATH);
+		for (unsigned g = 0; g < GAMES; ++g)
+		{
+			log.logReset(g, d, g);
+			for (unsigned i = 0; i < MOVES; ++i)
+				log.logAction(g, move(i));
+		}
+	}
+	std::vector<msm::RecoveredGame> games;
+	bench::Timer t;
+	uint64_t const records = msm::ActionLog::recover(PATH, games);
+	std::ostringstream what;
+	what << "recover " << games.size() << " games";
+	bench::report(what.str().c_str(), t.elapsedMs(), records);
+	std::remove(PATH);
+}
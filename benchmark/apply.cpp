@@ -0,0 +1,93 @@
+/**
+ * @file apply.cpp
+ *
+ * Moves of a bot one by one versus one batch with Matrix::apply(), with a board view
+ * and an event channel as observers.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <vector>
+
+#include "boardView.hpp"
+#include "eventChannel.hpp"
+
+namespace
+{
+const uint16_t SIZE = 200;
+const int ROUNDS = 20;
+
+/// Marks and unmarks every field and reveals the fields without a bomb.
+void moves(msm::Matrix const& m, std::vector<msm::Action>& actions)
+{
+	actions.clear();
+	for (uint16_t y = 0; y < SIZE; ++y)
+		for (uint16_t x = 0; x < SIZE; ++x)
+		{
+			for (int i = 0; i < 3; ++i)
+				actions.push_back(msm::Action(msm::AT_CYCLEMARK, x, y));
+			if (!dynamic_cast<msm::Bomb const*>(&m.at(x, y)))
+				actions.push_back(msm::Action(msm::AT_REVEAL, x, y));
+		}
+}
+
+struct Consumer: public msm::BoardViewObserver
+{
+	Consumer() :
+			calls(0)
+	{
+	}
+	void onCellsChanged(msm::BoardView const&, int32_t const*, uint32_t)
+	{
+		++calls;
+	}
+	void onBoardReset(msm::BoardView const&)
+	{
+	}
+	uint64_t calls;
+};
+}
+
+BENCHMARK(apply)
+{
+	msm::Dimensions const d(SIZE, SIZE, (uint32_t) SIZE * SIZE / 8);
+	msm::Matrix m;
+	msm::BoardView view(m);
+	msm::EventChannel channel(1 << 16, msm::OP_DROP);
+	m.addObserver(&channel);
+	Consumer consumer;
+	view.addObserver(&consumer);
+
+	std::vector<msm::Action> actions;
+	std::vector<msm::Event> events(1 << 16);
+	double single = 0, batch = 0;
+	uint64_t count = 0;
+	for (int r = 0; r < ROUNDS; ++r)
+	{
+		m.reset(d, (uint32_t) r);
+		moves(m, actions);
+		count += actions.size();
+		channel.drain(&events[0], events.size());
+		bench::Timer t;
+		for (std::vector<msm::Action>::const_iterator it = actions.begin(); it != actions.end(); ++it)
+		{
+			if (it->type == msm::AT_REVEAL)
+				view.reveal(it->x, it->y);
+			else
+				view.cycleMark(it->x, it->y);
+		}
+		single += t.elapsedMs();
+
+		m.reset(d, (uint32_t) r);
+		channel.drain(&events[0], events.size());
+		t.reset();
+		view.apply(&actions[0], (uint32_t) actions.size());
+		batch += t.elapsedMs();
+	}
+	bench::report("one by one", single, count);
+	bench::report("Matrix::apply()", batch, count);
+	bench::doNotOptimize(consumer.calls);
+}
@@ -0,0 +1,65 @@
+/**
+ * @file benchmark.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+
+namespace
+{
+typedef std::vector<std::pair<char const*, Function> > Registry;
+
+Registry& registry()
+{
+	static Registry r;
+	return r;
+}
+}
+
+Registrar::Registrar(char const* name, Function function)
+{
+	registry().push_back(std::make_pair(name, function));
+}
+
+void report(char const* what, double ms, uint64_t items)
+{
+	std::cout << "  " << std::left << std::setw(48) << what << std::right << std::fixed << std::setprecision(3)
+			<< std::setw(12) << ms << " ms";
+	if (items > 0)
+		std::cout << std::setw(12) << std::setprecision(2) << (ms * 1e6 / items) << " ns/item";
+	std::cout << "\n";
+}
+
+} // namespace bench
+
+int main(int argc, char** argv)
+{
+	bench::Registry const& r = bench::registry();
+
+	for (bench::Registry::const_iterator it = r.begin(); it != r.end(); ++it)
+	{
+		bool run = (argc < 2);
+		for (int i = 1; i < argc && !run; ++i)
+			run = (std::strcmp(argv[i], it->first) == 0);
+
+		if (run)
+		{
+			std::cout << it->first << "\n";
+			it->second();
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,75 @@
+/**
+ * @file benchmark.hpp
+ *
+ * Minimal benchmark harness. Each benchmark is a function registered with
+ * the BENCHMARK macro. The main function runs all benchmarks or the ones
+ * named on the command line.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef BENCHMARK_HPP_
+#define BENCHMARK_HPP_
+
+#include <stdint.h>
+#include <chrono>
+
+namespace bench
+{
+
+typedef void (*Function)();
+
+/// Registers a benchmark function at static initialization time.
+struct Registrar
+{
+	Registrar(char const* name, Function function);
+};
+
+/// Wall clock stop watch.
+class Timer
+{
+public:
+	Timer() :
+			start(std::chrono::steady_clock::now())
+	{
+	}
+	/// Restart the timer.
+	void reset()
+	{
+		start = std::chrono::steady_clock::now();
+	}
+	/// Milliseconds since construction or the last reset.
+	double elapsedMs() const
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+private:
+	std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Print one result line.
+ * \param what Description of the measured variant.
+ * \param ms The measured time in milliseconds.
+ * \param items The count of processed items (e.g. cells).
+ */
+void report(char const* what, double ms, uint64_t items);
+
+/// Prevent the compiler from optimizing away a computed value.
+template<typename T>
+inline void doNotOptimize(T const& value)
+{
+	asm volatile("" : : "g"(&value) : "memory");
+}
+
+} // namespace bench
+
+/// Define and register a benchmark function.
+#define BENCHMARK(name) \
+	static void name(); \
+	static bench::Registrar registrar_##name(#name, name); \
+	static void name()
+
+#endif /* BENCHMARK_HPP_ */
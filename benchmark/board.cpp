@@ -0,0 +1,76 @@
+/**
+ * @file board.cpp
+ *
+ * The generic board in 2D versus the hand-written simulation board, and in 3D.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <vector>
+
+#include "board.hpp"
+#include "simulation.hpp"
+
+namespace
+{
+const uint32_t SEED = 4711;
+const int ROUNDS = 5;
+
+/// Reset the board and reveal every field without a bomb.
+template<typename Board, typename Reset>
+void play(char const* name, Board& board, Reset reset, std::vector<uint8_t> const& bombs)
+{
+	double resetMs = 0, revealMs = 0;
+	for (int r = 0; r < ROUNDS; ++r)
+	{
+		bench::Timer t;
+		reset();
+		resetMs += t.elapsedMs();
+
+		t.reset();
+		uint32_t opened = 0;
+		for (uint32_t i = 0; i < bombs.size(); ++i)
+			if (!bombs[i])
+				opened += board.reveal(i);
+		revealMs += t.elapsedMs();
+		bench::doNotOptimize(opened);
+	}
+
+	std::string what(name);
+	bench::report((what + ", reset").c_str(), resetMs / ROUNDS, bombs.size());
+	bench::report((what + ", reveal all").c_str(), revealMs / ROUNDS, bombs.size());
+}
+}
+
+BENCHMARK(board)
+{
+	msm::Dimensions d(1000, 1000, 1000 * 1000 / 6);
+	std::vector<uint8_t> bombs(1000 * 1000);
+	msm::placeBombs(d, SEED, &bombs[0]);
+
+	msm::SimulationBoard simulation;
+	play("2D simulation board", simulation, [&]()
+	{	simulation.reset(d, SEED);}, bombs);
+
+	msm::Board<2> plane;
+	msm::Board<2>::Point const extents = { { 1000, 1000 } };
+	play("Board<2>", plane, [&]()
+	{	plane.reset(extents, d.getBombs(), SEED);}, bombs);
+
+	// Find the bombs of the cube by revealing everything once
+	msm::Board<3> cube;
+	msm::Board<3>::Point const edges = { { 100, 100, 100 } };
+	uint32_t const cubeBombs = 100 * 100 * 100 / 20;
+	cube.reset(edges, cubeBombs, SEED);
+	std::vector<uint8_t> cubeLayout(cube.getSize());
+	for (uint32_t i = 0; i < cube.getSize(); ++i)
+	{
+		cube.reveal(i);
+		cubeLayout[i] = cube.getFieldStatus(i) == msm::FS_BOMB;
+	}
+	play("Board<3>", cube, [&]()
+	{	cube.reset(edges, cubeBombs, SEED);}, cubeLayout);
+}
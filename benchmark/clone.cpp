@@ -0,0 +1,47 @@
+/**
+ * @file clone.cpp
+ *
+ * Cost of Matrix::clone() and of a move on a clone.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <vector>
+
+#include "matrixClone.hpp"
+
+namespace
+{
+const uint16_t SIZE = 1000;
+const int CLONES = 10000;
+}
+
+BENCHMARK(clone)
+{
+	msm::Matrix m;
+	m.reset(msm::Dimensions(SIZE, SIZE, (uint32_t) SIZE * SIZE / 6), 4711);
+
+	bench::Timer t;
+	msm::MatrixClone first = m.clone();
+	bench::report("first clone (builds the layout)", t.elapsedMs(), (uint64_t) SIZE * SIZE);
+
+	std::vector<msm::MatrixClone> clones(CLONES);
+	t.reset();
+	for (int i = 0; i < CLONES; ++i)
+		clones[i] = m.clone();
+	bench::report("clone", t.elapsedMs(), CLONES);
+
+	t.reset();
+	for (int i = 0; i < CLONES; ++i)
+		clones[i].cycleMark((i * 97) % SIZE, (i * 13) % SIZE);
+	bench::report("first modification of a clone", t.elapsedMs(), CLONES);
+
+	t.reset();
+	for (int i = 0; i < CLONES; ++i)
+		clones[i].cycleMark((i * 97 + 1) % SIZE, (i * 13) % SIZE);
+	bench::report("second modification of a clone", t.elapsedMs(), CLONES);
+	bench::doNotOptimize(clones.back().getRemainingBombs());
+}
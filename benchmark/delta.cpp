@@ -0,0 +1,69 @@
+/**
+ * @file delta.cpp
+ *
+ * Size and throughput of the deltas of a large cascade (see delta.hpp).
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <iostream>
+#include <vector>
+
+#include "delta.hpp"
+#include "eventChannel.hpp"
+
+namespace
+{
+const uint16_t SIZE = 1000;
+const int ROUNDS = 10;
+}
+
+BENCHMARK(delta)
+{
+	// Few bombs: One click opens most of the board
+	msm::Matrix m;
+	msm::DeltaEncoder encoder;
+	m.addObserver(&encoder);
+	m.reset(msm::Dimensions(SIZE, SIZE, (uint32_t) SIZE * SIZE / 100), 4711);
+	for (uint16_t y = 0; y < SIZE && !encoder.getPending(); ++y)
+		for (uint16_t x = 0; x < SIZE && !encoder.getPending(); ++x)
+			if (m.at(x, y).getAdjacentBombs() == 0)
+				m.at(x, y).reveal();
+	m.removeObserver(&encoder);
+
+	// Keep a copy of the changes to encode them again
+	std::vector<uint8_t> cells;
+	std::vector<uint32_t> indices;
+	for (msm::CellIterator it = m.begin(); it != m.end(); ++it)
+		if (it->getStatus() == msm::FS_UNHIDDEN)
+		{
+			indices.push_back(it->getPosition().Y * SIZE + it->getPosition().X);
+			cells.push_back(msm::packCell(it->getStatus(), it->getAdjacentBombs()));
+		}
+	encoder.clear();
+
+	std::vector<uint8_t> wire;
+	bench::Timer t;
+	for (int r = 0; r < ROUNDS; ++r)
+	{
+		wire.clear();
+		for (size_t i = 0; i < indices.size(); ++i)
+			encoder.add(indices[i], cells[i]);
+		encoder.flush(wire);
+	}
+	bench::report("encode", t.elapsedMs(), (uint64_t) ROUNDS * indices.size());
+
+	msm::MirrorBoard mirror;
+	mirror.reset(SIZE, SIZE);
+	t.reset();
+	for (int r = 0; r < ROUNDS; ++r)
+		mirror.apply(&wire[0], wire.size());
+	bench::report("apply", t.elapsedMs(), (uint64_t) ROUNDS * indices.size());
+
+	std::cout << "  " << indices.size() << " revealed cells, " << wire.size() << " bytes ("
+			<< (double) wire.size() / indices.size() << " bytes per cell, "
+			<< sizeof(msm::Event) * indices.size() << " bytes as events)" << std::endl;
+}
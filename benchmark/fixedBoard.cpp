@@ -0,0 +1,77 @@
+/**
+ * @file fixedBoard.cpp
+ *
+ * Whole games on the fixed boards of the standard difficulties versus the simulation
+ * board and the matrix.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <string>
+#include <vector>
+
+#include "fixedBoard.hpp"
+#include "simulation.hpp"
+
+namespace
+{
+const uint32_t GAMES = 20000;
+
+/// Reset and reveal every field without a bomb, one game per seed.
+template<typename Reset, typename Reveal>
+void play(std::string const& what, msm::Dimensions const& d, Reset reset, Reveal reveal)
+{
+	uint32_t const size = (uint32_t) d.getX() * d.getY();
+	std::vector<uint8_t> bombs(size);
+	double resetMs = 0, revealMs = 0;
+	uint32_t sum = 0;
+	for (uint32_t seed = 1; seed <= GAMES; ++seed)
+	{
+		msm::placeBombs(d, seed, &bombs[0]);
+		bench::Timer t;
+		reset(seed);
+		resetMs += t.elapsedMs();
+
+		t.reset();
+		for (uint32_t i = 0; i < size; ++i)
+			if (!bombs[i])
+				sum += reveal(i % d.getX(), i / d.getX());
+		revealMs += t.elapsedMs();
+	}
+	bench::doNotOptimize(sum);
+	bench::report((what + ", reset").c_str(), resetMs, GAMES);
+	bench::report((what + ", reveal all").c_str(), revealMs, GAMES);
+}
+
+template<typename Fixed>
+void compare(char const* name)
+{
+	msm::Dimensions const d = Fixed::getDimensions();
+	std::string const what(name);
+
+	Fixed fixed;
+	play(what + " fixed board", d, [&](uint32_t seed)
+	{	fixed.reset(seed);}, [&](uint16_t x, uint16_t y)
+	{	return fixed.reveal(x, y);});
+
+	msm::SimulationBoard simulation;
+	play(what + " simulation board", d, [&](uint32_t seed)
+	{	simulation.reset(d, seed);}, [&](uint16_t x, uint16_t y)
+	{	return simulation.reveal((uint32_t) y * d.getX() + x);});
+
+	msm::Matrix matrix;
+	play(what + " matrix", d, [&](uint32_t seed)
+	{	matrix.reset(d, seed);}, [&](uint16_t x, uint16_t y)
+	{	return matrix.reveal(x, y);});
+}
+}
+
+BENCHMARK(fixedBoard)
+{
+	compare<msm::BeginnerBoard>("beginner");
+	compare<msm::IntermediateBoard>("intermediate");
+	compare<msm::ExpertBoard>("expert");
+}
@@ -0,0 +1,68 @@
+/**
+ * @file hugePages.cpp
+ *
+ * Cascades over a giant board with the fields on normal pages versus huge pages.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <iostream>
+#include <string>
+
+#include "matrix.hpp"
+#include "memory.hpp"
+
+namespace
+{
+const uint16_t SIZE = 4000;
+const uint32_t SEED = 4711;
+
+/// Reveal every field without adjacent bombs by the cascade of Field::reveal().
+void revealAreas(msm::Matrix& m)
+{
+	for (uint16_t y = 0; y < SIZE; ++y)
+		for (uint16_t x = 0; x < SIZE; ++x)
+			if (m.at(x, y).getAdjacentBombs() == 0 && m.at(x, y).getStatus() == msm::FS_HIDDEN)
+				m.at(x, y).reveal();
+}
+
+void measure(std::string const& name, msm::MemoryResource* resource, msm::LAYOUT layout)
+{
+	uint64_t const size = (uint64_t) SIZE * SIZE;
+	msm::Matrix m;
+	m.setThreadCount(1);
+	m.setMemoryResource(resource);
+	m.setLayout(layout);
+
+	bench::Timer t;
+	m.reset(msm::Dimensions(SIZE, SIZE, (uint32_t) (size / 500)), SEED);
+	bench::report((name + ", reset").c_str(), t.elapsedMs(), size);
+
+	t.reset();
+	revealAreas(m);
+	bench::report((name + ", Field::reveal()").c_str(), t.elapsedMs(), size);
+}
+}
+
+BENCHMARK(hugePages)
+{
+	msm::HugePageResource transparent(msm::HP_TRANSPARENT);
+	msm::HugePageResource reserved(msm::HP_EXPLICIT);
+
+	measure("normal pages, rows", 0, msm::LT_ROWS);
+	measure("transparent huge pages, rows", &transparent, msm::LT_ROWS);
+	measure("normal pages, tiles", 0, msm::LT_TILES);
+	measure("transparent huge pages, tiles", &transparent, msm::LT_TILES);
+
+	// Without reserved huge pages (vm.nr_hugepages) this falls back to transparent ones
+	{
+		msm::Matrix m;
+		m.setMemoryResource(&reserved);
+		m.reset(msm::Dimensions(SIZE, SIZE, (uint32_t) SIZE * SIZE / 500), SEED);
+		std::cout << "  reserved huge pages: " << (reserved.getExplicitBytes() >> 20) << " MiB reserved, "
+				<< (reserved.getTransparentBytes() >> 20) << " MiB transparent\n";
+	}
+}
@@ -0,0 +1,71 @@
+/**
+ * @file layout.cpp
+ *
+ * Cascades over the fields stored row by row versus tile by tile.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <string>
+
+#include "matrix.hpp"
+
+namespace
+{
+const uint32_t SEED = 4711;
+const int ROUNDS = 3;
+
+/// Reveal every field without adjacent bombs that is still hidden. Returns the count of calls.
+uint64_t revealAreas(msm::Matrix& m, bool cascade)
+{
+	msm::Dimensions const& d = m.getDimensions();
+	uint64_t calls = 0;
+	for (uint16_t y = 0; y < d.getY(); ++y)
+		for (uint16_t x = 0; x < d.getX(); ++x)
+			if (m.at(x, y).getAdjacentBombs() == 0 && m.at(x, y).getStatus() == msm::FS_HIDDEN)
+			{
+				cascade ? m.at(x, y).reveal() : m.reveal(x, y);
+				++calls;
+			}
+	return calls;
+}
+
+void measure(std::string const& name, msm::Dimensions const& d)
+{
+	msm::Matrix m;
+	m.setThreadCount(1);
+	uint64_t const size = (uint64_t) d.getX() * d.getY();
+	char const* const layouts[] = { "rows", "tiles" };
+	for (int cascade = 1; cascade >= 0; --cascade)
+		for (int l = msm::LT_ROWS; l <= msm::LT_TILES; ++l)
+		{
+			m.setLayout((msm::LAYOUT) l);
+			double best = 0;
+			for (int r = 0; r < ROUNDS; ++r)
+			{
+				m.reset(d, SEED);
+				if (!cascade)
+					m.getOpenings();
+				bench::Timer t;
+				bench::doNotOptimize(revealAreas(m, cascade));
+				double ms = t.elapsedMs();
+				if (r == 0 || ms < best)
+					best = ms;
+			}
+			std::string const what = name + (cascade ? ", Field::reveal(), " : ", Matrix::reveal(), ") + layouts[l];
+			bench::report(what.c_str(), best, size);
+		}
+}
+}
+
+BENCHMARK(layout)
+{
+	// Few bombs: Most of the board is one large area
+	measure("8000 x 400", msm::Dimensions(8000, 400, 8000 * 400 / 500));
+	measure("1500 x 1500", msm::Dimensions(1500, 1500, 1500 * 1500 / 500));
+	// More bombs: Many small areas
+	measure("8000 x 400 dense", msm::Dimensions(8000, 400, 8000 * 400 / 8));
+}
@@ -0,0 +1,84 @@
+/**
+ * @file reset.cpp
+ *
+ * Serial versus parallel Matrix::reset(), uniform versus weighted placement of the bombs.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <sstream>
+#include <vector>
+
+#include "generator.hpp"
+#include "matrix.hpp"
+#include "threadPool.hpp"
+
+namespace
+{
+const uint16_t SIZE = 1000;
+const int ROUNDS = 3;
+
+double measure(msm::Matrix& m, msm::Dimensions const& d)
+{
+	double best = 0;
+	for (int r = 0; r < ROUNDS; ++r)
+	{
+		bench::Timer t;
+		m.reset(d, 4711);
+		double ms = t.elapsedMs();
+		if (r == 0 || ms < best)
+			best = ms;
+	}
+	return best;
+}
+}
+
+BENCHMARK(reset)
+{
+	msm::Dimensions d(SIZE, SIZE, (uint32_t) SIZE * SIZE / 6);
+	uint64_t const items = (uint64_t) SIZE * SIZE;
+
+	msm::Matrix m;
+	m.setThreadCount(1);
+	double serial = measure(m, d);
+	bench::report("serial", serial, items);
+
+	unsigned const hw = msm::ThreadPool::hardwareThreads();
+	for (unsigned threads = 2; threads <= 2 * hw && threads <= 16; threads *= 2)
+	{
+		m.setThreadCount(threads);
+		double ms = measure(m, d);
+
+		std::ostringstream what;
+		what << threads << " threads (speedup " << serial / ms << "x)";
+		bench::report(what.str().c_str(), ms, items);
+	}
+}
+
+BENCHMARK(weighted)
+{
+	// Uniform placement versus weights with clusters and a forbidden zone
+	uint16_t const size = 2000;
+	msm::Dimensions d(size, size, (uint32_t) size * size / 6);
+	std::vector<uint8_t> bombs((size_t) size * size);
+
+	bench::Timer t;
+	msm::placeBombs(d, 4711, &bombs[0]);
+	bench::report("uniform", t.elapsedMs(), d.getBombs());
+
+	msm::WeightMap weights(size, size);
+	weights.fill(size / 2 - 50, size / 2 - 50, 100, 100, 0);
+	for (uint16_t c = 0; c < 100; ++c)
+		weights.addCluster((c * 7919) % size, (c * 104729) % size, 20, 10);
+	t.reset();
+	msm::placeWeightedBombs(d, 4711, weights.getWeights(), &bombs[0]);
+	bench::report("weighted, dense (exponential keys)", t.elapsedMs(), d.getBombs());
+
+	msm::Dimensions sparse(size, size, (uint32_t) size * size / 100);
+	t.reset();
+	msm::placeWeightedBombs(sparse, 4711, weights.getWeights(), &bombs[0]);
+	bench::report("weighted, sparse (tree)", t.elapsedMs(), sparse.getBombs());
+}
@@ -0,0 +1,106 @@
+/**
+ * @file reveal.cpp
+ *
+ * Serial Field::reveal() versus Matrix::reveal() of a large empty area: Once with the
+ * precomputed opening, once searched in parallel, once breadth first with the waves.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <sstream>
+
+#include "matrix.hpp"
+#include "threadPool.hpp"
+
+namespace
+{
+const uint16_t SIZE = 1500;
+const int ROUNDS = 3;
+
+enum MODE
+{
+	CASCADE, OPENING, PARALLEL, WAVES
+};
+
+/// Reveal the first field without adjacent bombs. Returns the count of revealed fields.
+uint64_t revealArea(msm::Matrix& m, MODE mode)
+{
+	if (mode == PARALLEL)
+	{
+		// A mark in the opening disables the precomputed opening
+		for (uint16_t x = SIZE; x-- > 0;)
+			if (m.at(x, SIZE - 1).getAdjacentBombs() == 0)
+			{
+				m.at(x, SIZE - 1).cycleMark();
+				break;
+			}
+	}
+
+	for (uint16_t y = 0; y < SIZE; ++y)
+		for (uint16_t x = 0; x < SIZE; ++x)
+			if (m.at(x, y).getAdjacentBombs() == 0 && m.at(x, y).getStatus() == msm::FS_HIDDEN)
+			{
+				msm::Waves waves;
+				if (mode == CASCADE)
+					m.at(x, y).reveal();
+				else if (mode == WAVES)
+					m.reveal(x, y, waves);
+				else
+					m.reveal(x, y);
+				uint64_t revealed = 0;
+				m.forEach([&](msm::Field& f)
+				{	revealed += f.getStatus() == msm::FS_UNHIDDEN;});
+				return revealed;
+			}
+	return 0;
+}
+
+double measure(msm::Matrix& m, msm::Dimensions const& d, MODE mode, uint64_t& items)
+{
+	double best = 0;
+	for (int r = 0; r < ROUNDS; ++r)
+	{
+		m.reset(d, 4711);
+		bench::Timer t;
+		items = revealArea(m, mode);
+		double ms = t.elapsedMs();
+		if (r == 0 || ms < best)
+			best = ms;
+	}
+	return best;
+}
+}
+
+BENCHMARK(reveal)
+{
+	// Few bombs: One click opens most of the board
+	msm::Dimensions d(SIZE, SIZE, (uint32_t) SIZE * SIZE / 500);
+	uint64_t items = 0;
+
+	msm::Matrix m;
+	m.setThreadCount(1);
+	double serial = measure(m, d, CASCADE, items);
+	bench::report("Field::reveal()", serial, items);
+
+	double ms = measure(m, d, WAVES, items);
+	bench::report("Matrix::reveal() with waves", ms, items);
+
+	ms = measure(m, d, OPENING, items);
+	std::ostringstream opening;
+	opening << "Matrix::reveal(), opening (speedup " << serial / ms << "x)";
+	bench::report(opening.str().c_str(), ms, items);
+
+	unsigned const hw = msm::ThreadPool::hardwareThreads();
+	for (unsigned threads = 2; threads <= 2 * hw && threads <= 16; threads *= 2)
+	{
+		m.setThreadCount(threads);
+		ms = measure(m, d, PARALLEL, items);
+
+		std::ostringstream what;
+		what << "Matrix::reveal(), marked opening, " << threads << " threads (speedup " << serial / ms << "x)";
+		bench::report(what.str().c_str(), ms, items);
+	}
+}
@@ -0,0 +1,88 @@
+/**
+ * @file scan.cpp
+ *
+ * Full board scans through the different access paths of the matrix.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include "matrix.hpp"
+
+namespace
+{
+const uint16_t SIZE = 512;
+const int ROUNDS = 20;
+
+struct Sum
+{
+	explicit Sum(uint64_t* sum) :
+			sum(sum)
+	{
+	}
+	void operator()(msm::Field& f) const
+	{
+		*sum += f.getAdjacentBombs();
+	}
+	uint64_t* sum;
+};
+}
+
+BENCHMARK(scan)
+{
+	msm::Matrix m(msm::Dimensions(SIZE, SIZE, SIZE * SIZE / 8));
+	uint64_t const items = (uint64_t) SIZE * SIZE * ROUNDS;
+	uint64_t sum = 0;
+
+	bench::Timer t;
+	try
+	{
+		for (int r = 0; r < ROUNDS; ++r)
+			for (uint16_t x = 0; x < SIZE; ++x)
+				for (uint16_t y = 0; y < SIZE; ++y)
+					sum += m[x][y].getAdjacentBombs();
+	} catch (msm::IndexOutOfBoundsException const&)
+	{
+	}
+	bench::report("operator[][] (throwing), columns first", t.elapsedMs(), items);
+
+	t.reset();
+	for (int r = 0; r < ROUNDS; ++r)
+		for (uint16_t y = 0; y < SIZE; ++y)
+			for (uint16_t x = 0; x < SIZE; ++x)
+				sum += m[x][y].getAdjacentBombs();
+	bench::report("operator[][] (throwing), rows first", t.elapsedMs(), items);
+
+	t.reset();
+	for (int r = 0; r < ROUNDS; ++r)
+		for (uint16_t y = 0; y < SIZE; ++y)
+			for (uint16_t x = 0; x < SIZE; ++x)
+			{
+				msm::Field* f = m.tryGet(x, y);
+				if (f)
+					sum += f->getAdjacentBombs();
+			}
+	bench::report("tryGet()", t.elapsedMs(), items);
+
+	t.reset();
+	for (int r = 0; r < ROUNDS; ++r)
+		for (uint16_t y = 0; y < SIZE; ++y)
+			for (uint16_t x = 0; x < SIZE; ++x)
+				sum += m.at(x, y).getAdjacentBombs();
+	bench::report("at() (unchecked)", t.elapsedMs(), items);
+
+	t.reset();
+	for (int r = 0; r < ROUNDS; ++r)
+		for (msm::CellIterator it = m.begin(); it != m.end(); ++it)
+			sum += it->getAdjacentBombs();
+	bench::report("CellIterator", t.elapsedMs(), items);
+
+	t.reset();
+	for (int r = 0; r < ROUNDS; ++r)
+		m.forEach(Sum(&sum));
+	bench::report("forEach()", t.elapsedMs(), items);
+
+	bench::doNotOptimize(sum);
+}
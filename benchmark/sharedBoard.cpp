@@ -0,0 +1,85 @@
+/**
+ * @file sharedBoard.cpp
+ *
+ * Players clicking on the same large board: The shared board with one and more
+ * threads versus the single-threaded simulation board.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "sharedBoard.hpp"
+#include "simulation.hpp"
+#include "threadPool.hpp"
+
+namespace
+{
+const uint16_t SIZE = 1000;
+const uint32_t SEED = 4711;
+
+/// Every player clicks on every field without a bomb, each in another order.
+double play(msm::SharedBoard& board, std::vector<uint8_t> const& bombs, unsigned players)
+{
+	msm::Dimensions const& d = board.getDimensions();
+	board.reset(d, SEED);
+	uint32_t const size = board.getSize();
+
+	bench::Timer t;
+	std::vector<std::thread> threads;
+	for (unsigned p = 0; p < players; ++p)
+		threads.push_back(std::thread([&, p]()
+		{
+			uint32_t opened = 0;
+			for (uint32_t k = 0; k < size; ++k)
+			{
+				uint32_t i = (uint32_t) (((uint64_t) k * 7919 + p * (size / players)) % size);
+				if (!bombs[i])
+					opened += board.reveal(i, (uint16_t) p);
+			}
+			bench::doNotOptimize(opened);
+		}));
+	for (size_t i = 0; i < threads.size(); ++i)
+		threads[i].join();
+	return t.elapsedMs();
+}
+}
+
+BENCHMARK(sharedBoard)
+{
+	msm::Dimensions d(SIZE, SIZE, (uint32_t) SIZE * SIZE / 6);
+	uint32_t const size = (uint32_t) SIZE * SIZE;
+	std::vector<uint8_t> bombs(size);
+	msm::placeBombs(d, SEED, &bombs[0]);
+
+	msm::SimulationBoard serial;
+	serial.reset(d, SEED);
+	bench::Timer t;
+	uint32_t opened = 0;
+	for (uint32_t k = 0; k < size; ++k)
+	{
+		uint32_t i = (uint32_t) ((uint64_t) k * 7919 % size);
+		if (!bombs[i])
+			opened += serial.reveal(i);
+	}
+	bench::doNotOptimize(opened);
+	bench::report("simulation board, 1 player", t.elapsedMs(), size);
+
+	unsigned const threads = std::max(2u, msm::ThreadPool::hardwareThreads());
+	msm::SharedBoard shared, single(1);
+	shared.reset(d, SEED);
+	single.reset(d, SEED);
+	for (unsigned players = 1; players <= threads; players *= 2)
+	{
+		std::ostringstream what;
+		what << "shared board, " << players << " players";
+		bench::report(what.str().c_str(), play(shared, bombs, players), size);
+		what << ", one counter shard";
+		bench::report(what.str().c_str(), play(single, bombs, players), size);
+	}
+}
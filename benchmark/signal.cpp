@@ -0,0 +1,67 @@
+/**
+ * @file signal.cpp
+ *
+ * Emissions of msm::Signal versus boost::signals2 (if the Boost headers are available).
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <sstream>
+
+#include "signal.hpp"
+
+#if defined(__has_include)
+#if __has_include(<boost/signals2.hpp>)
+#include <boost/signals2.hpp>
+#define HAVE_SIGNALS2 1
+#endif
+#endif
+
+namespace
+{
+const uint64_t EMISSIONS = 10000000;
+
+uint64_t counter = 0;
+
+void slot(int value)
+{
+	counter += value;
+}
+
+template<typename S>
+double emit(S& signal)
+{
+	bench::Timer t;
+	for (uint64_t i = 0; i < EMISSIONS; ++i)
+		signal(1);
+	return t.elapsedMs();
+}
+}
+
+BENCHMARK(signal)
+{
+	for (int slots = 1; slots <= 4; slots *= 4)
+	{
+		msm::Signal<void(int)> own;
+		for (int s = 0; s < slots; ++s)
+			own.connect(&slot);
+		double ms = emit(own);
+		std::ostringstream what;
+		what << "msm::Signal, " << slots << " slot(s)";
+		bench::report(what.str().c_str(), ms, EMISSIONS);
+
+#if HAVE_SIGNALS2
+		boost::signals2::signal<void(int)> boost;
+		for (int s = 0; s < slots; ++s)
+			boost.connect(&slot);
+		double bms = emit(boost);
+		std::ostringstream bwhat;
+		bwhat << "boost::signals2, " << slots << " slot(s) (msm::Signal " << bms / ms << "x faster)";
+		bench::report(bwhat.str().c_str(), bms, EMISSIONS);
+#endif
+	}
+	bench::doNotOptimize(counter);
+}
@@ -0,0 +1,83 @@
+/**
+ * @file simulation.cpp
+ *
+ * Games per second of the headless simulation versus the same games on a Matrix.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <sstream>
+#include <vector>
+
+#include "simulation.hpp"
+
+namespace
+{
+const uint64_t GAMES = 5000;
+
+struct Preset
+{
+	char const* name;
+	msm::Dimensions dimensions;
+};
+
+/// Play the logged moves of the games on a matrix (without the strategy).
+double replay(msm::Dimensions const& d, msm::Strategy const& strategy)
+{
+	msm::SimulationBoard board;
+	std::vector<std::vector<msm::Move> > logs(GAMES / 10);
+	for (size_t g = 0; g < logs.size(); ++g)
+		msm::Simulation::play(board, d, (uint32_t) g, strategy, &logs[g]);
+
+	msm::Matrix m;
+	bench::Timer t;
+	for (size_t g = 0; g < logs.size(); ++g)
+	{
+		m.reset(d, (uint32_t) g);
+		for (std::vector<msm::Move>::const_iterator it = logs[g].begin(); it != logs[g].end(); ++it)
+		{
+			msm::Field& f = m.at(it->index % d.getX(), it->index / d.getX());
+			it->type == msm::MT_REVEAL ? (void) f.reveal() : f.cycleMark();
+		}
+	}
+	return t.elapsedMs() * 10;
+}
+}
+
+BENCHMARK(simulation)
+{
+	Preset const presets[] =
+	{
+	{ "beginner", msm::Dimensions(9, 9, 10) },
+	{ "intermediate", msm::Dimensions(16, 16, 40) },
+	{ "expert", msm::Dimensions(30, 16, 99) } };
+
+	msm::SimpleStrategy strategy;
+	msm::Simulation serial(1), parallel(0);
+
+	for (int p = 0; p < 3; ++p)
+	{
+		msm::Dimensions const& d = presets[p].dimensions;
+
+		bench::Timer t;
+		msm::Statistics s = serial.run(d, strategy, GAMES);
+		double ms = t.elapsedMs();
+
+		std::ostringstream what;
+		what << presets[p].name << " (win rate " << s.getWinRate() << ")";
+		bench::report(what.str().c_str(), ms, GAMES);
+
+		t.reset();
+		parallel.run(d, strategy, GAMES);
+		what.str("");
+		what << presets[p].name << ", all cores";
+		bench::report(what.str().c_str(), t.elapsedMs(), GAMES);
+
+		what.str("");
+		what << presets[p].name << ", moves replayed on a Matrix";
+		bench::report(what.str().c_str(), replay(d, strategy), GAMES);
+	}
+}
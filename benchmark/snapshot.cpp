@@ -0,0 +1,145 @@
+/**
+ * @file snapshot.cpp
+ *
+ * Spectators reading a running game: through operator[] of the live matrix under a
+ * mutex, from published snapshots and from the changes of the snapshots.
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "benchmark.hpp"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "snapshot.hpp"
+
+namespace
+{
+const unsigned MOVES = 20000;
+const uint16_t COLUMNS = 30;
+const uint16_t ROWS = 16;
+
+enum MODE
+{
+	LIVE, SNAPSHOT, CHANGES
+};
+
+char const* const NAMES[] = { "live matrix", "snapshots", "changes" };
+
+/// Play the moves on the game thread, reset when the game is over.
+template<typename Publish>
+void play(msm::Matrix& matrix, Publish publish)
+{
+	for (unsigned i = 0; i < MOVES; ++i)
+	{
+		uint16_t const x = (i * 7) % COLUMNS, y = (i * 13) % ROWS;
+		publish([&]()
+		{
+			if (matrix.getStatus() == msm::GS_LOST || matrix.getStatus() == msm::GS_WON)
+				matrix.reset(msm::Dimensions(COLUMNS, ROWS, 99), i);
+			else if (i % 3)
+				matrix.at(x, y).cycleMark();
+			else
+				matrix.reveal(x, y);
+		});
+	}
+}
+
+void run(MODE mode, unsigned readers)
+{
+	msm::Matrix matrix;
+	msm::SnapshotPublisher publisher(readers);
+	matrix.addObserver(&publisher);
+	matrix.reset(msm::Dimensions(COLUMNS, ROWS, 99), 1);
+	publisher.publish(matrix);
+	std::mutex mutex;
+
+	std::atomic<bool> stop(false);
+	std::atomic<uint64_t> reads(0), fields(0);
+	std::vector<std::thread> threads;
+	for (unsigned r = 0; r < readers; ++r)
+		threads.push_back(std::thread([&, r]()
+		{
+			std::vector<uint8_t> board(COLUMNS * ROWS);
+			std::vector<uint32_t> changes;
+			uint64_t seen = 0, n = 0, f = 0;
+			while (!stop)
+			{
+				if (mode == LIVE)
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					for (uint16_t x = 0; x < COLUMNS; ++x)
+						for (uint16_t y = 0; y < ROWS; ++y)
+							board[y * COLUMNS + x] = matrix[x][y].getStatus();
+					f += board.size();
+				}
+				else
+				{
+					msm::SnapshotLock lock(publisher, r);
+					msm::Snapshot const& s = *lock.get();
+					if (mode == CHANGES && s.getChanges(seen, changes))
+					{
+						for (size_t i = 0; i < changes.size(); ++i)
+							board[changes[i]] = s.getFieldStatus(changes[i] % COLUMNS, changes[i] / COLUMNS);
+						f += changes.size();
+					}
+					else
+					{
+						for (uint16_t y = 0; y < ROWS; ++y)
+							for (uint16_t x = 0; x < COLUMNS; ++x)
+								board[y * COLUMNS + x] = s.getFieldStatus(x, y);
+						f += board.size();
+					}
+					seen = s.getVersion();
+				}
+				bench::doNotOptimize(board[0]);
+				++n;
+			}
+			reads += n;
+			fields += f;
+		}));
+
+	bench::Timer t;
+	if (mode == LIVE)
+		play(matrix, [&](std::function<void()> const& move)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			move();
+		});
+	else
+		play(matrix, [&](std::function<void()> const& move)
+		{
+			move();
+			publisher.publish(matrix);
+		});
+	double const ms = t.elapsedMs();
+	stop = true;
+	for (size_t i = 0; i < threads.size(); ++i)
+		threads[i].join();
+	matrix.removeObserver(&publisher);
+
+	uint64_t const r = reads, f = fields;
+	std::ostringstream what;
+	what << NAMES[mode] << ", " << readers << " spectators: moves";
+	bench::report(what.str().c_str(), ms, MOVES);
+	if (!readers)
+		return;
+	what.str("");
+	what << NAMES[mode] << ", " << readers << " spectators: board reads (" << f / (double) (r ? r : 1)
+			<< " fields per read)";
+	bench::report(what.str().c_str(), ms, r);
+}
+}
+
+BENCHMARK(snapshot)
+{
+	for (unsigned readers = 0; readers <= 16; readers = readers ? readers * 4 : 1)
+		for (int mode = LIVE; mode <= CHANGES; ++mode)
+			run((MODE) mode, readers);
+}
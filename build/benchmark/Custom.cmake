@@ -0,0 +1,19 @@
+# This file is included in the root CMakeLists.txt
+
+set(VERSION_MAJOR 2)
+set(VERSION_MINOR 1)
+
+set(CMAKE_BUILD_TYPE "Release")
+
+# Threads (std::thread, std::atomic)
+find_package(Threads REQUIRED)
+set(LIBS ${LIBS} ${CMAKE_THREAD_LIBS_INIT})
+
+# Definitions
+add_definitions(-DJNIREF=1 -DSIGNALS=1)
+
+# CMakeLists in tree are setting SRCS
+add_subdirectory("src")
+add_subdirectory("benchmark")
+
+set(DIRS "src" "benchmark")
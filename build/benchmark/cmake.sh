@@ -0,0 +1,2 @@
+#! /bin/bash
+cmake -DPROJECT="MineSweeperMatrixBenchmark" -DINCLUDE_CMAKE="Custom.cmake" ../..
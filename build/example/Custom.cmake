@@ -5,8 +5,12 @@ set(VERSION_MINOR 1)
 
 set(CMAKE_BUILD_TYPE "Debug")
 
+# Threads (std::thread, std::atomic)
+find_package(Threads REQUIRED)
+set(LIBS ${LIBS} ${CMAKE_THREAD_LIBS_INIT})
+
 # Definitions
-add_definitions(-DJNIREF=1 -DBOOST_SIGNALS=1)
+add_definitions(-DJNIREF=1 -DSIGNALS=1)
 
 # CMakeLists in tree are setting SRCS
 add_subdirectory("src")
@@ -0,0 +1,27 @@
+# This file is included in the root CMakeLists.txt
+# Shared library exporting the C interface (capi.h) only.
+
+set(VERSION_MAJOR 2)
+set(VERSION_MINOR 1)
+
+set(CMAKE_BUILD_TYPE "Release")
+
+set(BUILD "shared")
+
+# Only the symbols marked with MSM_API are exported
+set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -fvisibility=hidden")
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -fvisibility=hidden -fvisibility-inlines-hidden")
+
+# Threads (std::thread, std::atomic)
+find_package(Threads REQUIRED)
+set(LIBS ${LIBS} ${CMAKE_THREAD_LIBS_INIT})
+
+# Definitions
+# No JNI slots and no signals for embedding
+add_definitions(-DJNIREF=0 -DSIGNALS=0)
+
+# CMakeLists in tree are setting SRCS
+add_subdirectory("src")
+
+set(DIRS "src")
+set(PUBLIC_HEADERS "src/capi.h")
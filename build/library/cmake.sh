@@ -0,0 +1,2 @@
+#! /bin/bash
+cmake -DPROJECT="MineSweeperMatrix" -DINCLUDE_CMAKE="Custom.cmake" ../..
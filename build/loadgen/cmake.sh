@@ -0,0 +1,2 @@
+#! /bin/bash
+cmake -DPROJECT="MineSweeperMatrixLoadGenerator" -DINCLUDE_CMAKE="Custom.cmake" ../..
@@ -0,0 +1,2 @@
+#! /bin/bash
+cmake -DPROJECT="MineSweeperMatrixServer" -DINCLUDE_CMAKE="Custom.cmake" ../..
@@ -15,26 +15,26 @@
 
 void dumpMatrix(msm::Matrix& matrix)
 {
-	for (uint16_t iI = 0; iI < matrix.getDimensions().getY(); iI++)
+	// The iterator walks the fields row by row
+	for (msm::CellIterator it = matrix.begin(); it != matrix.end(); ++it)
 	{
-		for (uint16_t iJ = 0; iJ < matrix.getDimensions().getX(); iJ++)
+		if (it->getStatus() == msm::FS_HIDDEN)
+			std::cout << "H ";
+		else if (it->getStatus() == msm::FS_BOMB)
+			std::cout << "X ";
+		else if (it->getStatus() == msm::FS_UNHIDDEN)
 		{
-			if (matrix[iJ][iI].getStatus() == msm::FS_HIDDEN)
-				std::cout << "H ";
-			else if (matrix[iJ][iI].getStatus() == msm::FS_BOMB)
-				std::cout << "X ";
-			else if (matrix[iJ][iI].getStatus() == msm::FS_UNHIDDEN)
-			{
-				uint8_t adjacentBombs = matrix[iJ][iI].getAdjacentBombs();
-				if (adjacentBombs > 0)
-					std::cout << (uint16_t) adjacentBombs;
-				else
-					std::cout << " ";
-
+			uint8_t adjacentBombs = it->getAdjacentBombs();
+			if (adjacentBombs > 0)
+				std::cout << (uint16_t) adjacentBombs;
+			else
 				std::cout << " ";
-			}
+
+			std::cout << " ";
 		}
-		std::cout << "\n";
+
+		if (it->getPosition().X == matrix.getDimensions().getX() - 1)
+			std::cout << "\n";
 	}
 
 	for (int iI = 0; iI < matrix.getDimensions().getX(); iI++)
@@ -96,7 +96,7 @@ int main(int /*argc*/, char** /*argv*/)
 
 	/* If boost is enabled we can add slots to get informed
 	 * by matrix when a field changes its status. */
-#if BOOST_SIGNALS
+#if SIGNALS
 	m->signalFieldStatusChanged.connect(onStateChanged);
 	/*m->signalFieldDelete.connect(onDelete);*/
 #endif
@@ -0,0 +1,451 @@
+/**
+ * @file loadgen.cpp
+ *
+ * A load generator for MineSweeperMatrixServer: Many simulated players on the local
+ * machine, driven by one event loop.
+ *
+ * Each client keeps a mirror of its game (protocol.hpp) and plays random moves on it:
+ * It reveals hidden fields, marks some of them and chords revealed fields. It keeps a
+ * count of requests in flight and starts a new game when the current one is over. At the
+ * end the throughput and the latency from a request to the update that answers it are
+ * reported.
+ *
+ * Usage: MineSweeperMatrixLoadGenerator (-u path | -p port) [-c clients] [-d seconds] [-w window]
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "protocol.hpp"
+
+namespace
+{
+typedef std::chrono::steady_clock Clock;
+
+const int EVENTS = 1024;
+const size_t READ = 64 * 1024;
+/// The count of connects started per tick.
+const unsigned CONNECTS = 512;
+/// The resolution of the latency histogram.
+const uint64_t BUCKET_US = 10;
+/// The count of buckets, latencies above fall into the last one.
+const size_t BUCKETS = 100000;
+
+/// The board of each game (expert).
+msm::Dimensions const BOARD(30, 16, 99);
+
+struct Client
+{
+	explicit Client(uint32_t id) :
+			fd(-1), connected(false), sent(0), requested(0), resetAt(0), random(id * 2654435761u + 1), dirty(false)
+	{
+	}
+	int fd;
+	bool connected;
+	msm::ClientSession session;
+	std::vector<uint8_t> in;
+	std::vector<uint8_t> out;
+	size_t sent;
+	/// The count of requests sent.
+	uint64_t requested;
+	/// The number of the request of the last reset.
+	uint64_t resetAt;
+	/// The send times of the requests in flight.
+	std::deque<Clock::time_point> times;
+	uint32_t random;
+	bool dirty;
+
+	uint32_t next()
+	{
+		// xorshift32
+		random ^= random << 13;
+		random ^= random >> 17;
+		random ^= random << 5;
+		return random;
+	}
+};
+
+struct Options
+{
+	Options() :
+			port(-1), clients(10000), seconds(10), window(1)
+	{
+	}
+	std::string path;
+	int port;
+	unsigned clients;
+	unsigned seconds;
+	unsigned window;
+};
+
+class Generator
+{
+public:
+	explicit Generator(Options const& options);
+	~Generator();
+	int run();
+
+private:
+	Options const options;
+	int epoll;
+	std::vector<Client*> clients;
+	/// Clients not connected yet, or refused by a full listen backlog.
+	std::deque<Client*> waiting;
+	std::vector<Client*> dirty;
+	std::vector<uint8_t> buffer;
+	std::vector<uint64_t> histogram;
+	uint64_t answered;
+	uint64_t games;
+	uint64_t won;
+	uint64_t lost;
+	uint64_t failed;
+
+	void connect(Client& c);
+	void onConnected(Client& c);
+	void read(Client& c);
+	void write(Client& c);
+	void fail(Client& c);
+	void play(Client& c);
+	double percentile(double p) const;
+};
+
+Generator::Generator(Options const& options) :
+		options(options), epoll(epoll_create1(EPOLL_CLOEXEC)), buffer(READ), histogram(BUCKETS), answered(0), games(
+				0), won(0), lost(0), failed(0)
+{
+	for (unsigned i = 0; i < options.clients; ++i)
+	{
+		clients.push_back(new Client(i));
+		waiting.push_back(clients.back());
+	}
+}
+
+Generator::~Generator()
+{
+	for (size_t i = 0; i < clients.size(); ++i)
+	{
+		if (clients[i]->fd >= 0)
+			close(clients[i]->fd);
+		delete clients[i];
+	}
+	close(epoll);
+}
+
+void Generator::connect(Client& c)
+{
+	int const domain = options.path.empty() ? AF_INET : AF_UNIX;
+	c.fd = socket(domain, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (c.fd < 0)
+	{
+		fail(c);
+		return;
+	}
+
+	int result;
+	if (domain == AF_UNIX)
+	{
+		sockaddr_un address;
+		std::memset(&address, 0, sizeof(address));
+		address.sun_family = AF_UNIX;
+		std::strncpy(address.sun_path, options.path.c_str(), sizeof(address.sun_path) - 1);
+		result = ::connect(c.fd, (sockaddr*) &address, sizeof(address));
+	}
+	else
+	{
+		int one = 1;
+		setsockopt(c.fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+		sockaddr_in address;
+		std::memset(&address, 0, sizeof(address));
+		address.sin_family = AF_INET;
+		address.sin_port = htons((uint16_t) options.port);
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		result = ::connect(c.fd, (sockaddr*) &address, sizeof(address));
+	}
+
+	if (result != 0 && errno == EAGAIN)
+	{
+		// The listen backlog of a Unix socket is full, try again later
+		close(c.fd);
+		c.fd = -1;
+		waiting.push_back(&c);
+		return;
+	}
+	if (result != 0 && errno != EINPROGRESS)
+	{
+		fail(c);
+		return;
+	}
+
+	epoll_event e;
+	e.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+	e.data.ptr = &c;
+	epoll_ctl(epoll, EPOLL_CTL_ADD, c.fd, &e);
+	if (result == 0)
+		onConnected(c);
+}
+
+void Generator::onConnected(Client& c)
+{
+	c.connected = true;
+	play(c);
+}
+
+void Generator::play(Client& c)
+{
+	msm::MirrorBoard const& board = c.session.getBoard();
+	while (c.times.size() < options.window)
+	{
+		bool const over = c.session.getStatus() == msm::GS_WON || c.session.getStatus() == msm::GS_LOST;
+		if (!c.requested || (over && c.session.getAnswered() >= c.resetAt))
+		{
+			msm::encodeReset(c.out, BOARD, c.next());
+			c.resetAt = c.requested + 1;
+			++games;
+		}
+		else if (c.session.getAnswered() < c.resetAt)
+			// Wait for the new board
+			break;
+		else
+		{
+			uint32_t const r = c.next();
+			uint32_t const i = r % ((uint32_t) board.getWidth() * board.getHeight());
+			uint16_t const x = (uint16_t) (i % board.getWidth()), y = (uint16_t) (i / board.getWidth());
+			uint8_t const cell = board.getCell(i);
+			msm::MESSAGETYPE type = msm::MT_REVEAL;
+			if ((cell & msm::CELL_STATUS_MASK) == msm::FS_UNHIDDEN)
+				type = msm::MT_CHORD;
+			else if ((cell & msm::CELL_STATUS_MASK) == msm::FS_MARKED || (r >> 24) % 8 == 0)
+				type = msm::MT_MARK;
+			msm::encodeAction(c.out, type, x, y);
+		}
+		++c.requested;
+		c.times.push_back(Clock::now());
+	}
+	if (!c.dirty && c.sent < c.out.size())
+	{
+		c.dirty = true;
+		dirty.push_back(&c);
+	}
+}
+
+void Generator::read(Client& c)
+{
+	for (;;)
+	{
+		ssize_t const n = ::read(c.fd, &buffer[0], buffer.size());
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0 && errno == EAGAIN)
+			break;
+		if (n <= 0)
+		{
+			fail(c);
+			return;
+		}
+		c.in.insert(c.in.end(), buffer.begin(), buffer.begin() + n);
+	}
+	if (c.in.empty())
+		return;
+
+	uint64_t const before = c.session.getAnswered();
+	msm::GAMESTATUS const status = c.session.getStatus();
+	size_t consumed = 0;
+	if (!c.session.receive(&c.in[0], c.in.size(), consumed))
+	{
+		fail(c);
+		return;
+	}
+	c.in.erase(c.in.begin(), c.in.begin() + consumed);
+
+	Clock::time_point const now = Clock::now();
+	for (uint64_t i = before; i < c.session.getAnswered() && !c.times.empty(); ++i)
+	{
+		uint64_t const us = std::chrono::duration_cast<std::chrono::microseconds>(now - c.times.front()).count();
+		++histogram[std::min<uint64_t>(us / BUCKET_US, BUCKETS - 1)];
+		c.times.pop_front();
+		++answered;
+	}
+	if (status != c.session.getStatus())
+	{
+		won += c.session.getStatus() == msm::GS_WON;
+		lost += c.session.getStatus() == msm::GS_LOST;
+	}
+	play(c);
+}
+
+void Generator::write(Client& c)
+{
+	while (c.sent < c.out.size())
+	{
+		ssize_t const n = ::send(c.fd, &c.out[c.sent], c.out.size() - c.sent, MSG_NOSIGNAL);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0 && errno == EAGAIN)
+			return;
+		if (n < 0)
+		{
+			fail(c);
+			return;
+		}
+		c.sent += n;
+	}
+	c.out.clear();
+	c.sent = 0;
+}
+
+void Generator::fail(Client& c)
+{
+	if (c.fd >= 0)
+		close(c.fd);
+	c.fd = -1;
+	c.connected = false;
+	++failed;
+}
+
+int Generator::run()
+{
+	std::vector<epoll_event> events(EVENTS);
+	Clock::time_point const start = Clock::now();
+	Clock::time_point report = start + std::chrono::seconds(1);
+	Clock::time_point const end = start + std::chrono::seconds(options.seconds);
+	uint64_t lastAnswered = 0;
+
+	for (;;)
+	{
+		for (unsigned i = 0; i < CONNECTS && !waiting.empty(); ++i)
+		{
+			Client& c = *waiting.front();
+			waiting.pop_front();
+			connect(c);
+		}
+
+		int const n = epoll_wait(epoll, &events[0], EVENTS, waiting.empty() ? 100 : 1);
+		if (n < 0 && errno != EINTR)
+			return EXIT_FAILURE;
+		for (int i = 0; i < n; ++i)
+		{
+			Client& c = *static_cast<Client*>(events[i].data.ptr);
+			if (c.fd < 0)
+				continue;
+			if (events[i].events & (EPOLLERR | EPOLLHUP))
+			{
+				fail(c);
+				continue;
+			}
+			if (!c.connected && (events[i].events & EPOLLOUT))
+				onConnected(c);
+			if (events[i].events & EPOLLOUT)
+				write(c);
+			if (events[i].events & EPOLLIN)
+				read(c);
+		}
+
+		// Send the requests of the tick, one write per client
+		for (size_t i = 0; i < dirty.size(); ++i)
+		{
+			dirty[i]->dirty = false;
+			if (dirty[i]->fd >= 0)
+				write(*dirty[i]);
+		}
+		dirty.clear();
+
+		Clock::time_point const now = Clock::now();
+		if (now >= report)
+		{
+			unsigned connected = 0;
+			for (size_t i = 0; i < clients.size(); ++i)
+				connected += clients[i]->connected;
+			std::cout << std::chrono::duration_cast<std::chrono::seconds>(now - start).count() << " s: " << connected
+					<< " clients, " << answered - lastAnswered << " requests/s\n";
+			lastAnswered = answered;
+			report += std::chrono::seconds(1);
+		}
+		if (now >= end)
+			break;
+	}
+
+	double const seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	std::cout << "Clients: " << options.clients << " (" << failed << " failed)\n";
+	std::cout << "Requests: " << answered << " in " << seconds << " s, " << answered / seconds << " requests/s\n";
+	std::cout << "Games: " << games << " (" << won << " won, " << lost << " lost)\n";
+	std::cout << "Latency: p50 " << percentile(0.5) << " us, p99 " << percentile(0.99) << " us, p99.9 "
+			<< percentile(0.999) << " us\n";
+	return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+double Generator::percentile(double p) const
+{
+	uint64_t const target = (uint64_t) (answered * p);
+	uint64_t sum = 0;
+	for (size_t i = 0; i < histogram.size(); ++i)
+	{
+		sum += histogram[i];
+		if (sum > target)
+			return (double) (i * BUCKET_US);
+	}
+	return (double) (BUCKETS * BUCKET_US);
+}
+
+int usage()
+{
+	std::cerr << "Usage: MineSweeperMatrixLoadGenerator (-u path | -p port) [-c clients] [-d seconds] [-w window]\n"
+			<< "  -u path     Connect to a Unix socket\n"
+			<< "  -p port     Connect to a TCP port of localhost\n"
+			<< "  -c clients  The count of clients (default 10000)\n"
+			<< "  -d seconds  The duration (default 10)\n"
+			<< "  -w window   The count of requests in flight per client (default 1)\n";
+	return EXIT_FAILURE;
+}
+}
+
+int main(int argc, char** argv)
+{
+	Options options;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string const option(argv[i]);
+		if (option == "-u")
+			options.path = argv[i + 1];
+		else if (option == "-p")
+			options.port = std::atoi(argv[i + 1]);
+		else if (option == "-c")
+			options.clients = (unsigned) std::atoi(argv[i + 1]);
+		else if (option == "-d")
+			options.seconds = (unsigned) std::atoi(argv[i + 1]);
+		else if (option == "-w")
+			options.window = (unsigned) std::atoi(argv[i + 1]);
+		else
+			return usage();
+	}
+	if ((argc - 1) % 2 || options.path.empty() == (options.port < 0) || !options.window)
+		return usage();
+
+	// One descriptor per client
+	rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+	{
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+	}
+
+	Generator generator(options);
+	return generator.run();
+}
@@ -0,0 +1,457 @@
+/**
+ * @file server.cpp
+ *
+ * A game server for many connections on the local machine, one game per connection.
+ * It speaks the protocol of protocol.hpp on a Unix socket and/or a TCP port on localhost.
+ *
+ * Each event loop owns its connections and needs no locks. One tick of a loop reads all
+ * readable connections and collects their requests, then executes the requests of each
+ * connection as one batch and answers them with one update and one write. A connection
+ * is read at most once per tick, so a client that never stops sending can't starve the
+ * others. With more than one loop the loops share the listening sockets and the kernel
+ * wakes one loop per incoming connection.
+ *
+ * Usage: MineSweeperMatrixServer [-u path] [-p port] [-t loops]
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <stdint.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "protocol.hpp"
+
+namespace
+{
+/// The count of events fetched per tick.
+const int EVENTS = 1024;
+/// The size of a read, the most bytes read from a connection per tick.
+const size_t READ = 64 * 1024;
+/// A connection stops reading while more unsent bytes are queued for it.
+const size_t BACKLOG = 1024 * 1024;
+/// A connection stops reading while more received bytes wait for its session, as many as
+/// the requests of a full session take at most.
+const size_t INPUT = msm::PROTOCOL_MAX_PENDING * msm::PROTOCOL_RESET;
+
+volatile sig_atomic_t stopped = 0;
+
+void onSignal(int)
+{
+	stopped = 1;
+}
+
+/// A socket in an epoll set.
+struct Handle
+{
+	explicit Handle(int fd, bool listener) :
+			fd(fd), listener(listener)
+	{
+	}
+	int const fd;
+	bool const listener;
+};
+
+struct Connection: public Handle
+{
+	explicit Connection(int fd) :
+			Handle(fd, false), received(0), sent(0), dirty(false), readable(false), closed(false), paused(false)
+	{
+	}
+	msm::ServerSession session;
+	std::vector<uint8_t> in;
+	/// The bytes of in taken by the session.
+	size_t received;
+	std::vector<uint8_t> out;
+	size_t sent;
+	/// Has requests to answer at the end of the tick.
+	bool dirty;
+	/// May have more data to read in the next tick.
+	bool readable;
+	bool closed;
+	/// Stopped reading because of the backlog.
+	bool paused;
+};
+
+struct Statistics
+{
+	Statistics() :
+			connections(0), requests(0), updates(0), ticks(0)
+	{
+	}
+	std::atomic<uint64_t> connections;
+	std::atomic<uint64_t> requests;
+	std::atomic<uint64_t> updates;
+	std::atomic<uint64_t> ticks;
+};
+
+class Loop
+{
+public:
+	Loop(std::vector<Handle*> const& listeners, Statistics& statistics);
+	~Loop();
+	void run();
+
+private:
+	int epoll;
+	Statistics& statistics;
+	std::vector<uint8_t> buffer;
+	std::unordered_set<Connection*> connections;
+	std::vector<Connection*> dirty;
+	/// The connections to read again in the next tick. Edge-triggered epoll won't report
+	/// them again before they are read empty.
+	std::vector<Connection*> readable;
+	std::vector<Connection*> closed;
+
+	void accept(Handle& listener);
+	void read(Connection& c);
+	void write(Connection& c);
+	void close(Connection& c);
+};
+
+Loop::Loop(std::vector<Handle*> const& listeners, Statistics& statistics) :
+		epoll(epoll_create1(EPOLL_CLOEXEC)), statistics(statistics), buffer(READ)
+{
+	for (size_t i = 0; i < listeners.size(); ++i)
+	{
+		epoll_event e;
+		e.events = EPOLLIN | EPOLLEXCLUSIVE;
+		e.data.ptr = listeners[i];
+		epoll_ctl(epoll, EPOLL_CTL_ADD, listeners[i]->fd, &e);
+	}
+}
+
+Loop::~Loop()
+{
+	for (std::unordered_set<Connection*>::iterator it = connections.begin(); it != connections.end(); ++it)
+	{
+		::close((*it)->fd);
+		delete *it;
+	}
+	::close(epoll);
+}
+
+void Loop::run()
+{
+	std::vector<epoll_event> events(EVENTS);
+	std::vector<Connection*> again;
+	while (!stopped)
+	{
+		int const n = epoll_wait(epoll, &events[0], EVENTS, readable.empty() ? 200 : 0);
+		if (n < 0 && errno != EINTR)
+			break;
+		++statistics.ticks;
+
+		// Continue with the connections that were left readable in the last tick
+		again.swap(readable);
+		for (size_t i = 0; i < again.size(); ++i)
+		{
+			Connection& c = *again[i];
+			c.readable = false;
+			if (!c.closed)
+				read(c);
+		}
+		again.clear();
+
+		for (int i = 0; i < n; ++i)
+		{
+			Handle* h = static_cast<Handle*>(events[i].data.ptr);
+			if (h->listener)
+			{
+				accept(*h);
+				continue;
+			}
+			Connection& c = *static_cast<Connection*>(h);
+			if (c.closed)
+				continue;
+			if (events[i].events & (EPOLLERR | EPOLLHUP))
+				close(c);
+			else
+			{
+				if (events[i].events & EPOLLOUT)
+					write(c);
+				// Once per tick, a connection left readable was read already
+				if ((events[i].events & EPOLLIN) && !c.readable)
+					read(c);
+			}
+		}
+
+		// Answer the requests of the tick, one update per connection
+		for (size_t i = 0; i < dirty.size(); ++i)
+		{
+			Connection& c = *dirty[i];
+			c.dirty = false;
+			if (c.closed)
+				continue;
+			statistics.requests += c.session.getPending();
+			if (c.session.flush(c.out))
+				++statistics.updates;
+			write(c);
+		}
+		dirty.clear();
+
+		if (!closed.empty())
+		{
+			size_t kept = 0;
+			for (size_t i = 0; i < readable.size(); ++i)
+				if (!readable[i]->closed)
+					readable[kept++] = readable[i];
+			readable.resize(kept);
+		}
+		for (size_t i = 0; i < closed.size(); ++i)
+			delete closed[i];
+		closed.clear();
+	}
+}
+
+void Loop::accept(Handle& listener)
+{
+	// Leave the rest of a burst to the other loops
+	for (unsigned i = 0; i < 256; ++i)
+	{
+		int const fd = accept4(listener.fd, 0, 0, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0)
+			return;
+		int one = 1;
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+		Connection* c = new Connection(fd);
+		epoll_event e;
+		e.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+		e.data.ptr = c;
+		epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &e);
+		connections.insert(c);
+		++statistics.connections;
+	}
+}
+
+void Loop::read(Connection& c)
+{
+	if (c.out.size() - c.sent > BACKLOG)
+	{
+		c.paused = true;
+		return;
+	}
+	c.paused = false;
+
+	/* One read per tick, and none while INPUT bytes wait for the session. A full read, a
+	 * full input or a full session leave data behind that edge-triggered epoll won't report
+	 * again, the connection is read again in the next tick. */
+	size_t const unread = c.in.size() - c.received;
+	bool more = unread >= INPUT;
+	if (!more && !c.session.isFull())
+	{
+		size_t const room = std::min(buffer.size(), INPUT - unread);
+		ssize_t n;
+		do
+			n = ::read(c.fd, &buffer[0], room);
+		while (n < 0 && errno == EINTR);
+		if (n == 0 || (n < 0 && errno != EAGAIN))
+		{
+			close(c);
+			return;
+		}
+		if (n > 0)
+		{
+			c.in.insert(c.in.end(), buffer.begin(), buffer.begin() + n);
+			more = (size_t) n == room;
+		}
+	}
+	if (c.received < c.in.size())
+	{
+		size_t consumed = 0;
+		if (!c.session.receive(&c.in[c.received], c.in.size() - c.received, consumed))
+		{
+			close(c);
+			return;
+		}
+		c.received += consumed;
+		// Move the rest to the front only if it is not larger than the part taken
+		if (c.in.size() - c.received <= c.received)
+		{
+			c.in.erase(c.in.begin(), c.in.begin() + c.received);
+			c.received = 0;
+		}
+	}
+
+	if ((more || c.session.isFull()) && !c.readable)
+	{
+		c.readable = true;
+		readable.push_back(&c);
+	}
+	if (c.session.getPending() && !c.dirty)
+	{
+		c.dirty = true;
+		dirty.push_back(&c);
+	}
+}
+
+void Loop::write(Connection& c)
+{
+	while (c.sent < c.out.size())
+	{
+		ssize_t const n = ::send(c.fd, &c.out[c.sent], c.out.size() - c.sent, MSG_NOSIGNAL);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0 && errno == EAGAIN)
+			return;
+		if (n < 0)
+		{
+			close(c);
+			return;
+		}
+		c.sent += n;
+	}
+	c.out.clear();
+	c.sent = 0;
+	if (c.paused)
+		read(c);
+}
+
+void Loop::close(Connection& c)
+{
+	if (c.closed)
+		return;
+	c.closed = true;
+	// Closing the socket removes it from the epoll set
+	::close(c.fd);
+	connections.erase(&c);
+	closed.push_back(&c);
+}
+
+int listenUnix(std::string const& path)
+{
+	sockaddr_un address;
+	std::memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	if (path.size() >= sizeof(address.sun_path))
+		return -1;
+	std::strcpy(address.sun_path, path.c_str());
+	unlink(path.c_str());
+
+	int const fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0 || bind(fd, (sockaddr*) &address, sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0)
+		return -1;
+	return fd;
+}
+
+int listenTcp(uint16_t port)
+{
+	sockaddr_in address;
+	std::memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_port = htons(port);
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	int const fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	int one = 1;
+	if (fd < 0 || setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one)) != 0
+			|| bind(fd, (sockaddr*) &address, sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0)
+		return -1;
+	return fd;
+}
+
+int usage()
+{
+	std::cerr << "Usage: MineSweeperMatrixServer [-u path] [-p port] [-t loops]\n"
+			<< "  -u path   Listen on a Unix socket\n"
+			<< "  -p port   Listen on a TCP port of localhost\n"
+			<< "  -t loops  The count of event loops (default 1)\n";
+	return EXIT_FAILURE;
+}
+}
+
+int main(int argc, char** argv)
+{
+	std::string path;
+	int port = -1;
+	unsigned loops = 1;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		std::string const option(argv[i]);
+		if (option == "-u")
+			path = argv[i + 1];
+		else if (option == "-p")
+			port = std::atoi(argv[i + 1]);
+		else if (option == "-t")
+			loops = (unsigned) std::atoi(argv[i + 1]);
+		else
+			return usage();
+	}
+	if ((argc - 1) % 2 || (path.empty() && port < 0) || !loops)
+		return usage();
+
+	// One descriptor per connection
+	rlimit limit;
+	if (getrlimit(RLIMIT_NOFILE, &limit) == 0)
+	{
+		limit.rlim_cur = limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &limit);
+	}
+	signal(SIGINT, onSignal);
+	signal(SIGTERM, onSignal);
+	signal(SIGPIPE, SIG_IGN);
+
+	std::vector<Handle*> listeners;
+	if (!path.empty())
+	{
+		int const fd = listenUnix(path);
+		if (fd < 0)
+		{
+			std::cerr << "Can't listen on " << path << ": " << std::strerror(errno) << "\n";
+			return EXIT_FAILURE;
+		}
+		listeners.push_back(new Handle(fd, true));
+	}
+	if (port >= 0)
+	{
+		int const fd = listenTcp((uint16_t) port);
+		if (fd < 0)
+		{
+			std::cerr << "Can't listen on port " << port << ": " << std::strerror(errno) << "\n";
+			return EXIT_FAILURE;
+		}
+		listeners.push_back(new Handle(fd, true));
+	}
+
+	Statistics statistics;
+	std::vector<std::thread> threads;
+	for (unsigned i = 0; i < loops; ++i)
+		threads.push_back(std::thread([&listeners, &statistics]()
+		{
+			Loop loop(listeners, statistics);
+			loop.run();
+		}));
+	for (size_t i = 0; i < threads.size(); ++i)
+		threads[i].join();
+
+	for (size_t i = 0; i < listeners.size(); ++i)
+	{
+		close(listeners[i]->fd);
+		delete listeners[i];
+	}
+	if (!path.empty())
+		unlink(path.c_str());
+
+	std::cout << "Connections: " << statistics.connections << "\n";
+	std::cout << "Requests: " << statistics.requests << "\n";
+	std::cout << "Updates: " << statistics.updates << " in " << statistics.ticks << " ticks\n";
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,409 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file actionLog.cpp
+ *
+ * Implementation of \ref actionLog.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "actionLog.hpp"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace msm
+{
+
+namespace
+{
+/// The offset of the checksum in a record.
+size_t const CHECKSUM = LOG_RECORD - 4;
+
+void put16(uint8_t* p, uint16_t v)
+{
+	p[0] = (uint8_t) v;
+	p[1] = (uint8_t) (v >> 8);
+}
+
+void put32(uint8_t* p, uint32_t v)
+{
+	put16(p, (uint16_t) v);
+	put16(p + 2, (uint16_t) (v >> 16));
+}
+
+void put64(uint8_t* p, uint64_t v)
+{
+	put32(p, (uint32_t) v);
+	put32(p + 4, (uint32_t) (v >> 32));
+}
+
+uint16_t get16(uint8_t const* p)
+{
+	return (uint16_t) (p[0] | p[1] << 8);
+}
+
+uint32_t get32(uint8_t const* p)
+{
+	return get16(p) | (uint32_t) get16(p + 2) << 16;
+}
+
+uint64_t get64(uint8_t const* p)
+{
+	return get32(p) | (uint64_t) get32(p + 4) << 32;
+}
+
+uint32_t checksum(uint8_t const* p)
+{
+	// FNV-1a
+	uint32_t h = 2166136261u;
+	for (size_t i = 0; i < CHECKSUM; ++i)
+		h = (h ^ p[i]) * 16777619u;
+	return h;
+}
+
+/// A decoded record.
+struct Record
+{
+	RECORDTYPE type;
+	uint8_t kind;
+	uint16_t x;
+	uint16_t y;
+	uint64_t game;
+	uint32_t seed;
+	uint32_t bombs;
+};
+
+void encode(Record const& r, uint8_t* p)
+{
+	p[0] = (uint8_t) r.type;
+	p[1] = r.kind;
+	put16(p + 2, r.x);
+	put16(p + 4, r.y);
+	put16(p + 6, 0);
+	put64(p + 8, r.game);
+	put32(p + 16, r.seed);
+	put32(p + 20, r.bombs);
+	put32(p + CHECKSUM, checksum(p));
+}
+
+/// False for a torn or damaged record.
+bool decode(uint8_t const* p, Record& r)
+{
+	if (get32(p + CHECKSUM) != checksum(p) || p[0] > RT_END)
+		return false;
+	r.type = (RECORDTYPE) p[0];
+	r.kind = p[1];
+	r.x = get16(p + 2);
+	r.y = get16(p + 4);
+	r.game = get64(p + 8);
+	r.seed = get32(p + 16);
+	r.bombs = get32(p + 20);
+	return true;
+}
+
+/** Call func(record) for each valid record of a file.
+ * \return The count of valid records. Reading stops at the first invalid one. */
+template<typename Func>
+uint64_t scan(int fd, Func func)
+{
+	std::vector<uint8_t> buffer(LOG_RECORD * 4096);
+	uint64_t records = 0;
+	size_t filled = 0;
+	for (;;)
+	{
+		ssize_t n = read(fd, &buffer[filled], buffer.size() - filled);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return records;
+		filled += n;
+
+		size_t offset = 0;
+		for (; offset + LOG_RECORD <= filled; offset += LOG_RECORD, ++records)
+		{
+			Record r;
+			if (!decode(&buffer[offset], r))
+				return records;
+			func(r);
+		}
+		std::copy(buffer.begin() + offset, buffer.begin() + filled, buffer.begin());
+		filled -= offset;
+	}
+}
+}
+
+/*
+ * The appending threads encode their records into the pending buffer under the mutex.
+ * The writer thread swaps it with its own buffer, writes and syncs it without the lock
+ * and publishes the last sequence number of the group as durable. Records appended
+ * while a sync is running form the next group.
+ *
+ * A failed write or sync stops the writer for good. The records after the last durable
+ * one are never written, so no later group claims them durable and a torn record can
+ * only be at the end of the file.
+ */
+struct ActionLog::Impl
+{
+	Impl() :
+			fd(-1), appended(0), durable(0), syncs(0), failed(false), stop(false)
+	{
+	}
+
+	int fd;
+
+	mutable std::mutex mutex;
+	/// Signals new records to the writer.
+	std::condition_variable work;
+	/// Signals durable records to the committing threads.
+	std::condition_variable done;
+	std::vector<uint8_t> pending;
+	uint64_t appended;
+	uint64_t durable;
+	uint64_t syncs;
+	bool failed;
+	bool stop;
+
+	std::thread writer;
+
+	uint64_t append(Record const& r);
+	void run();
+};
+
+uint64_t ActionLog::Impl::append(Record const& r)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	// After a failure nothing is written anymore
+	if (failed)
+		return ++appended;
+	size_t const size = pending.size();
+	pending.resize(size + LOG_RECORD);
+	encode(r, &pending[size]);
+	if (size == 0)
+		work.notify_one();
+	return ++appended;
+}
+
+void ActionLog::Impl::run()
+{
+	std::vector<uint8_t> group;
+	std::unique_lock<std::mutex> lock(mutex);
+	for (;;)
+	{
+		work.wait(lock, [this]()
+		{	return stop || !pending.empty();});
+		if (pending.empty())
+			return;
+
+		group.swap(pending);
+		uint64_t const last = appended;
+		lock.unlock();
+
+		bool ok = true;
+		for (size_t written = 0; ok && written < group.size();)
+		{
+			ssize_t n = write(fd, &group[written], group.size() - written);
+			if (n > 0)
+				written += n;
+			else
+				ok = n < 0 && errno == EINTR;
+		}
+		ok = ok && fdatasync(fd) == 0;
+		group.clear();
+
+		lock.lock();
+		++syncs;
+		if (ok)
+			durable = last;
+		else
+		{
+			// Sticky: A later group must not cover the lost one, and a failed sync must
+			// not be retried (the kernel may have dropped the dirty pages already)
+			failed = true;
+			pending.clear();
+		}
+		done.notify_all();
+		if (failed)
+			return;
+	}
+}
+
+ActionLog::ActionLog(std::string const& path) :
+		pImpl(new Impl)
+{
+	int fd = open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+	if (fd < 0)
+	{
+		delete pImpl;
+		throw std::runtime_error("Can't open the action log " + path);
+	}
+
+	// Cut off a torn record, so the new records follow the last valid one
+	off_t const end = (off_t) (scan(fd, [](Record const&)
+	{}) * LOG_RECORD);
+	if (ftruncate(fd, end) != 0 || lseek(fd, end, SEEK_SET) != end)
+	{
+		close(fd);
+		delete pImpl;
+		throw std::runtime_error("Can't open the action log " + path);
+	}
+
+	// The entry of a new file must be durable before its first records are
+	std::string::size_type const slash = path.rfind('/');
+	std::string const directory = slash == std::string::npos ? "." : slash ? path.substr(0, slash) : "/";
+	int const dir = open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	bool const synced = dir >= 0 && fsync(dir) == 0;
+	if (dir >= 0)
+		close(dir);
+	if (!synced)
+	{
+		close(fd);
+		delete pImpl;
+		throw std::runtime_error("Can't sync the directory of the action log " + path);
+	}
+
+	pImpl->fd = fd;
+	pImpl->writer = std::thread(&Impl::run, pImpl);
+}
+
+ActionLog::~ActionLog()
+{
+	{
+		std::lock_guard<std::mutex> lock(pImpl->mutex);
+		pImpl->stop = true;
+	}
+	pImpl->work.notify_one();
+	pImpl->writer.join();
+	close(pImpl->fd);
+	delete pImpl;
+}
+
+uint64_t ActionLog::logReset(uint64_t game, Dimensions const& dimensions, uint32_t seed)
+{
+	Record r = { RT_RESET, (uint8_t) dimensions.getTopology(), dimensions.getX(), dimensions.getY(), game, seed,
+			dimensions.getBombs() };
+	return pImpl->append(r);
+}
+
+uint64_t ActionLog::logAction(uint64_t game, Action const& action)
+{
+	Record r = { RT_ACTION, (uint8_t) action.type, action.x, action.y, game, 0, 0 };
+	return pImpl->append(r);
+}
+
+uint64_t ActionLog::logEnd(uint64_t game)
+{
+	Record r = { RT_END, 0, 0, 0, game, 0, 0 };
+	return pImpl->append(r);
+}
+
+bool ActionLog::commit(uint64_t sequence)
+{
+	std::unique_lock<std::mutex> lock(pImpl->mutex);
+	pImpl->done.wait(lock, [this, sequence]()
+	{	return pImpl->failed || pImpl->durable >= sequence;});
+	return pImpl->durable >= sequence;
+}
+
+uint64_t ActionLog::getAppended() const
+{
+	std::lock_guard<std::mutex> lock(pImpl->mutex);
+	return pImpl->appended;
+}
+
+uint64_t ActionLog::getDurable() const
+{
+	std::lock_guard<std::mutex> lock(pImpl->mutex);
+	return pImpl->durable;
+}
+
+uint64_t ActionLog::getSyncs() const
+{
+	std::lock_guard<std::mutex> lock(pImpl->mutex);
+	return pImpl->syncs;
+}
+
+uint64_t ActionLog::recover(std::string const& path, std::vector<RecoveredGame>& games)
+{
+	games.clear();
+	int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0)
+		return 0;
+
+	struct Game
+	{
+		Game() :
+				seed(0), started(false)
+		{
+		}
+		Dimensions dim;
+		uint32_t seed;
+		std::vector<Action> actions;
+		bool started;
+	};
+	std::map<uint64_t, Game> running;
+	std::vector<uint64_t> order;
+
+	uint64_t const records = scan(fd, [&](Record const& r)
+	{
+		if (r.type == RT_END)
+		{
+			running.erase(r.game);
+			return;
+		}
+		std::map<uint64_t, Game>::iterator it = running.find(r.game);
+		if (it == running.end())
+		{
+			// Actions of a game without a reset are not restorable
+			if (r.type != RT_RESET)
+				return;
+			it = running.insert(std::make_pair(r.game, Game())).first;
+			order.push_back(r.game);
+		}
+		Game& g = it->second;
+		if (r.type == RT_RESET)
+		{
+			g.dim = Dimensions(r.x, r.y, r.bombs, (TOPOLOGY) r.kind);
+			g.seed = r.seed;
+			g.actions.clear();
+		}
+		else
+			g.actions.push_back(Action((ACTIONTYPE) r.kind, r.x, r.y));
+	});
+	close(fd);
+
+	for (size_t i = 0; i < order.size(); ++i)
+	{
+		std::map<uint64_t, Game>::iterator it = running.find(order[i]);
+		// Ended, or ended and started again under the same id later
+		if (it == running.end() || it->second.started)
+			continue;
+		Game& g = it->second;
+		g.started = true;
+
+		RecoveredGame recovered;
+		recovered.game = order[i];
+		recovered.matrix = std::make_shared<Matrix>();
+		recovered.matrix->reset(g.dim, g.seed);
+		if (!g.actions.empty())
+			recovered.matrix->apply(&g.actions[0], g.actions.size());
+		recovered.actions = g.actions.size();
+		games.push_back(recovered);
+	}
+	return records;
+}
+
+} // namespace msm
+
+///\}
@@ -0,0 +1,142 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file actionLog.hpp
+ *
+ * A write-ahead log of the actions of many games, to restore running games after a crash.
+ *
+ * A game is fully defined by its \ref msm::Dimensions "dimensions", its seed and the
+ * \ref msm::Action "actions" of the player, so the log never stores a board. All games of
+ * a server append to one file. The records of the threads are collected in memory and a
+ * writer thread writes and syncs them to the disk in groups: While one sync is running,
+ * the next group fills up, so a single sync makes many records durable.
+ *
+ * Each record has a fixed size of \ref msm::LOG_RECORD bytes with a checksum:
+ * \code
+ * uint8   type (RT_*)
+ * uint8   topology (RT_RESET) or action (RT_ACTION)
+ * uint16  columns (RT_RESET) or x (RT_ACTION)
+ * uint16  rows (RT_RESET) or y (RT_ACTION)
+ * uint16  reserved, 0
+ * uint64  game
+ * uint32  seed (RT_RESET)
+ * uint32  bombs (RT_RESET)
+ * uint32  checksum of the bytes before (FNV-1a)
+ * \endcode
+ * All numbers are little-endian. A record that was only partly written by a crash fails
+ * the checksum. It ends the log and is cut off when the log is opened again.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef ACTIONLOG_HPP_
+#define ACTIONLOG_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "matrix.hpp"
+
+namespace msm
+{
+
+/// The size of a record of an \ref ActionLog in bytes.
+const size_t LOG_RECORD = 32;
+
+/// The type of a record of an \ref ActionLog.
+enum RECORDTYPE
+{
+	RT_RESET, //!< A game was reset with dimensions and seed. Forgets the actions before.
+	RT_ACTION, //!< An action of the player.
+	RT_END //!< The game is over and doesn't need to be restored.
+};
+
+/// A game restored by \ref ActionLog::recover().
+struct RecoveredGame
+{
+	/// The game.
+	uint64_t game;
+	/// The matrix after the actions. The game may be won or lost already.
+	std::shared_ptr<Matrix> matrix;
+	/// The count of logged actions since the reset.
+	uint32_t actions;
+};
+
+/**
+ * Appends the actions of many games to a file. Thread-safe.
+ *
+ * Log the \ref logReset() "reset" of a game before the first action, then each
+ * \ref logAction() "action" and finally the \ref logEnd() "end" of the game. Each call
+ * returns the sequence number of the record. \ref commit() waits until the record is on
+ * the disk, e.g. before the result of a move is sent to the player.
+ */
+class ActionLog
+{
+public:
+	struct Impl;
+
+	/** Open a log. The records are appended to an existing log.
+	 * A torn record at the end of an existing log is cut off. The directory is synced once,
+	 * so a new log doesn't vanish with its committed records on a power failure.
+	 * \param path The file.
+	 * \throws std::runtime_error If the file can't be opened or its directory can't be synced. */
+	explicit ActionLog(std::string const& path);
+	/// Destructor. Writes and syncs all records that are not on the disk yet.
+	~ActionLog();
+
+	/** Log a reset of a game.
+	 * \param game The game.
+	 * \param dimensions The dimensions passed to Matrix::reset().
+	 * \param seed The seed passed to Matrix::reset().
+	 * \return The sequence number of the record. */
+	uint64_t logReset(uint64_t game, Dimensions const& dimensions, uint32_t seed);
+	/** Log an action of a game.
+	 * \param game The game.
+	 * \param action The action. Restored by Matrix::apply().
+	 * \return The sequence number of the record. */
+	uint64_t logAction(uint64_t game, Action const& action);
+	/** Log that a game is over.
+	 * \param game The game.
+	 * \return The sequence number of the record. */
+	uint64_t logEnd(uint64_t game);
+
+	/** Wait until a record and all records before are on the disk.
+	 * \param sequence The sequence number of the record.
+	 * \return False if writing the log failed before the record was on the disk.
+	 * A failure is final: The log writes no more records and returns false for each
+	 * sequence number after \ref getDurable(). */
+	bool commit(uint64_t sequence);
+
+	/// Get the sequence number of the last appended record. 0 if none was appended.
+	uint64_t getAppended() const;
+	/// Get the sequence number of the last record that is on the disk.
+	uint64_t getDurable() const;
+	/// Get the count of syncs, each made a group of records durable.
+	uint64_t getSyncs() const;
+
+	/** Restore the games of a log that are not over.
+	 * Each game is rebuilt by Matrix::reset() with the logged dimensions and seed,
+	 * followed by Matrix::apply() of the logged actions.
+	 * \param path The file. A missing file has no games.
+	 * \param games Receives the games in the order of their first record.
+	 * \return The count of valid records. */
+	static uint64_t recover(std::string const& path, std::vector<RecoveredGame>& games);
+
+protected:
+	Impl* pImpl;
+
+private:
+	ActionLog(ActionLog const& cp);
+	ActionLog& operator=(ActionLog const& cp);
+};
+
+} // namespace msm
+
+#endif /* ACTIONLOG_HPP_ */
+
+///\}
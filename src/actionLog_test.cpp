@@ -0,0 +1,261 @@
+/**
+ * @file actionLog_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <signal.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "actionLog.hpp"
+
+namespace
+{
+/// Create a fresh directory for the log in the temporary directory.
+std::string makeDirectory()
+{
+	char const* tmp = std::getenv("TMPDIR");
+	std::string pattern = std::string(tmp && *tmp ? tmp : "/tmp") + "/actionLog_testXXXXXX";
+	if (!mkdtemp(&pattern[0]))
+		throw std::runtime_error("Can't create a temporary directory");
+	return pattern;
+}
+
+/// Gives each test a log in a temporary directory of its own and removes both afterwards.
+struct Fix_actionLog_test
+{
+	Fix_actionLog_test() :
+			directory(makeDirectory()), path(directory + "/actionLog_test.log")
+	{
+	}
+	~Fix_actionLog_test()
+	{
+		std::remove(path.c_str());
+		rmdir(directory.c_str());
+	}
+
+	std::string const directory;
+	std::string const path;
+};
+
+/// Limits the size of the files of the process and restores the limit also if a test fails.
+struct Fix_fileSizeLimit: public Fix_actionLog_test
+{
+	Fix_fileSizeLimit() :
+			handler(signal(SIGXFSZ, SIG_IGN)), restored(false)
+	{
+		getrlimit(RLIMIT_FSIZE, &original);
+	}
+	~Fix_fileSizeLimit()
+	{
+		lift();
+		signal(SIGXFSZ, handler);
+	}
+	bool limit(rlim_t bytes)
+	{
+		rlimit limited = original;
+		limited.rlim_cur = bytes;
+		return setrlimit(RLIMIT_FSIZE, &limited) == 0;
+	}
+	void lift()
+	{
+		if (!restored)
+			restored = setrlimit(RLIMIT_FSIZE, &original) == 0;
+	}
+
+	rlimit original;
+	void (*handler)(int);
+	bool restored;
+};
+
+/// Play some moves on a matrix and log them.
+void play(msm::ActionLog& log, uint64_t game, msm::Matrix& matrix, uint32_t seed, unsigned moves)
+{
+	msm::Dimensions const d(30, 20, 60);
+	matrix.reset(d, seed);
+	log.logReset(game, d, seed);
+	for (unsigned i = 0; i < moves && matrix.getStatus() != msm::GS_LOST; ++i)
+	{
+		msm::Action const a(i % 5 ? msm::AT_REVEAL : msm::AT_CYCLEMARK, (i * 7 + seed) % 30, (i * 3) % 20);
+		log.logAction(game, a);
+		matrix.apply(&a, 1);
+	}
+}
+
+bool same(msm::Matrix const& a, msm::Matrix const& b)
+{
+	if (a.getStatus() != b.getStatus() || a.getRemainingBombs() != b.getRemainingBombs())
+		return false;
+	for (msm::CellIterator i = a.begin(), j = b.begin(); i != a.end(); ++i, ++j)
+		if (i->getStatus() != j->getStatus())
+			return false;
+	return true;
+}
+}
+
+BOOST_FIXTURE_TEST_SUITE(actionLog_test_suite, Fix_actionLog_test)
+
+BOOST_AUTO_TEST_CASE(recover_test)
+{
+	std::vector<msm::RecoveredGame> games;
+	BOOST_CHECK(0 == msm::ActionLog::recover(path, games));
+	BOOST_CHECK(games.empty());
+
+	msm::Matrix first, second, third;
+	uint64_t appended = 0;
+	{
+		msm::ActionLog log(path);
+		play(log, 7, first, 1, 10);
+		play(log, 8, second, 2, 3);
+		uint64_t const end = log.logEnd(8);
+		BOOST_CHECK(log.commit(end));
+		BOOST_CHECK(end == log.getDurable());
+		BOOST_CHECK(end == log.getAppended());
+		BOOST_CHECK(log.getSyncs() >= 1);
+		appended += end;
+	}
+	{
+		// Appends to the existing log, a reset starts the game again
+		msm::ActionLog log(path);
+		BOOST_CHECK(0 == log.getAppended());
+		play(log, 9, third, 3, 12);
+		play(log, 7, first, 4, 6);
+		appended += log.getAppended();
+	}
+
+	BOOST_CHECK(appended == msm::ActionLog::recover(path, games));
+	BOOST_REQUIRE(2 == games.size());
+	BOOST_CHECK(7 == games[0].game);
+	BOOST_CHECK(9 == games[1].game);
+	BOOST_CHECK(same(first, *games[0].matrix));
+	BOOST_CHECK(same(third, *games[1].matrix));
+	BOOST_CHECK(4 == games[0].matrix->getSeed());
+}
+
+BOOST_AUTO_TEST_CASE(torn_test)
+{
+	msm::Matrix matrix;
+	{
+		msm::ActionLog log(path);
+		play(log, 1, matrix, 5, 4);
+	}
+
+	// A crash in the middle of a record
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::app);
+		out.write("\x01\x00\x03\x00\x04", 5);
+	}
+	std::vector<msm::RecoveredGame> games;
+	uint64_t const records = msm::ActionLog::recover(path, games);
+	BOOST_REQUIRE(1 == games.size());
+	BOOST_CHECK(same(matrix, *games[0].matrix));
+
+	// The torn record is cut off, the new records are readable
+	{
+		msm::ActionLog log(path);
+		log.logEnd(1);
+	}
+	BOOST_CHECK(records + 1 == msm::ActionLog::recover(path, games));
+	BOOST_CHECK(games.empty());
+}
+
+BOOST_AUTO_TEST_CASE(group_commit_test)
+{
+	unsigned const PLAYERS = 4;
+	unsigned const MOVES = 50;
+	std::vector<msm::Matrix> matrices(PLAYERS);
+	uint64_t appended = 0, syncs = 0;
+	std::atomic<unsigned> failed(0);
+	{
+		msm::ActionLog log(path);
+		std::vector<std::thread> players;
+		for (unsigned p = 0; p < PLAYERS; ++p)
+			players.push_back(std::thread([&, p]()
+			{
+				msm::Dimensions const d(16, 16, 40);
+				matrices[p].reset(d, p + 10);
+				failed += !log.commit(log.logReset(p, d, p + 10));
+				for (unsigned i = 0; i < MOVES; ++i)
+				{
+					// Each move is durable before the next one
+					msm::Action const a(msm::AT_CYCLEMARK, i % 16, p);
+					uint64_t const s = log.logAction(p, a);
+					matrices[p].apply(&a, 1);
+					failed += !log.commit(s) || log.getDurable() < s;
+				}
+			}));
+		for (size_t t = 0; t < players.size(); ++t)
+			players[t].join();
+		appended = log.getAppended();
+		syncs = log.getSyncs();
+	}
+	BOOST_CHECK(0 == failed);
+	BOOST_CHECK(PLAYERS * (MOVES + 1) == appended);
+	BOOST_CHECK(syncs <= appended);
+
+	std::vector<msm::RecoveredGame> games;
+	BOOST_CHECK(appended == msm::ActionLog::recover(path, games));
+	BOOST_REQUIRE(PLAYERS == games.size());
+	for (size_t g = 0; g < games.size(); ++g)
+	{
+		BOOST_REQUIRE(games[g].game < PLAYERS);
+		BOOST_CHECK(MOVES == games[g].actions);
+		BOOST_CHECK(same(matrices[games[g].game], *games[g].matrix));
+	}
+}
+
+BOOST_FIXTURE_TEST_CASE(write_failure_test, Fix_fileSizeLimit)
+{
+	// The file may grow by three and a half records: The fourth one is written partly
+	rlim_t const size = 3 * msm::LOG_RECORD + msm::LOG_RECORD / 2;
+	BOOST_REQUIRE(limit(size));
+
+	uint64_t durable = 0;
+	{
+		msm::ActionLog log(path);
+		msm::Dimensions const d(9, 9, 10);
+		BOOST_CHECK(log.commit(log.logReset(1, d, 1)));
+		uint64_t last = 0;
+		for (uint16_t x = 0; x < 6; ++x)
+			last = log.logAction(1, msm::Action(msm::AT_CYCLEMARK, x, 0));
+		BOOST_CHECK(!log.commit(last));
+		durable = log.getDurable();
+		BOOST_CHECK(durable < last);
+
+		// Sticky: Nothing after the failure becomes durable, even if the disk could take it
+		lift();
+		BOOST_REQUIRE(restored);
+		BOOST_CHECK(!log.commit(log.logAction(1, msm::Action(msm::AT_CYCLEMARK, 0, 1))));
+		BOOST_CHECK(durable == log.getDurable());
+		BOOST_CHECK(!log.commit(durable + 1));
+		if (durable)
+			BOOST_CHECK(log.commit(durable));
+	}
+
+	// Nothing was written after the torn record
+	std::ifstream in(path, std::ios::binary | std::ios::ate);
+	BOOST_CHECK(in.tellg() <= (std::streamoff) size);
+	in.close();
+
+	// The torn record ends the log, the durable records are readable
+	std::vector<msm::RecoveredGame> games;
+	uint64_t const records = msm::ActionLog::recover(path, games);
+	BOOST_CHECK(records >= durable);
+	BOOST_CHECK(records <= 3);
+	BOOST_REQUIRE(1 == games.size());
+	BOOST_CHECK(records - 1 == games[0].actions);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,365 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file board.hpp
+ *
+ * Boards with any count of dimensions, e.g. 3D Minesweeper with 26 neighbours.
+ *
+ * A \ref msm::Board "board" is a template over the count of dimensions. Like the
+ * \ref msm::SimulationBoard "simulation board" it has no field objects and no observers,
+ * only a status, a bomb and the adjacent bombs per field. The fields are stored with a
+ * border of one field in every dimension, so the neighbours of a field are found by
+ * adding a fixed offset without any bounds check. The 3^D - 1 directions of the
+ * neighbours are generated at compile time, the offsets only depend on the extents.
+ * The count of neighbours is a compile-time constant, so the loops over the neighbours
+ * are unrolled like hand-written code.
+ *
+ * \code
+ * msm::Board<3> board;
+ * msm::Board<3>::Point const extents = { { 20, 20, 20 } };
+ * board.reset(extents, 600, seed);
+ * board.reveal(board.index(msm::Board<3>::Point { { 10, 10, 10 } }));
+ * \endcode
+ *
+ * \note The boards only know the plane topology. Board<2> produces the same layout as
+ * Matrix::reset(Dimensions(x, y, bombs), seed).
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef BOARD_HPP_
+#define BOARD_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "generator.hpp"
+#include "matrix.hpp"
+
+namespace msm
+{
+
+namespace detail
+{
+/// 3 to the power of d.
+constexpr uint32_t pow3(unsigned d)
+{
+	return d ? 3 * pow3(d - 1) : 1;
+}
+
+/** The component j (-1, 0 or 1) of the direction of neighbour n in D dimensions.
+ * The directions are counted in base 3, the center (all 0) is skipped. */
+constexpr int direction(unsigned D, unsigned n, unsigned j)
+{
+	return (int) (((n < pow3(D) / 2 ? n : n + 1) / pow3(j)) % 3) - 1;
+}
+}
+
+/**
+ * A board with D dimensions.
+ * The fields are addressed by their index in row-major order: The first coordinate
+ * changes fastest (index = x + X * (y + Y * (z + ...))).
+ * The rules are the same as the rules of the \ref Matrix.
+ * \tparam D The count of dimensions.
+ */
+template<unsigned D>
+class Board
+{
+	static_assert(D >= 1 && D <= 5, "The adjacent bombs are counted in a byte");
+
+public:
+	/// The count of dimensions.
+	static const unsigned DIMENSIONS = D;
+	/// The count of neighbours of a field.
+	static const unsigned NEIGHBOURS = detail::pow3(D) - 1;
+	/// A position or the extents of a board, one coordinate per dimension.
+	typedef std::array<uint16_t, D> Point;
+
+	/// Create an empty board.
+	Board() :
+			size(0), bombCount(0), status(GS_READY), unhidden(0), marked(0)
+	{
+		ext.fill(0);
+		offsets.fill(0);
+	}
+
+	/** Start a new game.
+	 * \param extents The count of fields in each dimension.
+	 * \param count The count of bombs. Reduced to the count of fields if higher.
+	 * \param seed The seed for the bomb placement.
+	 * \throw std::invalid_argument If the board has more fields than an index can address.
+	 * The board is unchanged then. */
+	void reset(Point const& extents, uint32_t count, uint32_t seed)
+	{
+		uint64_t total = 1;
+		for (unsigned j = 0; j < D; ++j)
+			total = std::min<uint64_t>(total * extents[j], (uint64_t) UINT32_MAX + 1);
+		if (total > UINT32_MAX)
+			throw std::invalid_argument("The board has more fields than an index can address");
+
+		ext = extents;
+		size = (uint32_t) total;
+		size_t paddedSize = 1;
+		for (unsigned j = 0; j < D; ++j)
+		{
+			strides[j] = paddedSize;
+			paddedSize *= (size_t) ext[j] + 2;
+		}
+		bombCount = std::min(count, size);
+		status = GS_READY;
+		unhidden = 0;
+		marked = 0;
+
+		for (unsigned n = 0; n < NEIGHBOURS; ++n)
+		{
+			int64_t o = 0;
+			for (unsigned j = 0; j < D; ++j)
+				o += detail::direction(D, n, j) * (int64_t) strides[j];
+			offsets[n] = o;
+		}
+
+		// The border is revealed and has no bomb
+		fields.assign(paddedSize, FS_UNHIDDEN);
+		bombs.assign(paddedSize, 0);
+		adjacent.assign(paddedSize, 0);
+		if (!size)
+			return;
+
+		std::vector<uint8_t> layout(size);
+		place(&layout[0], seed, std::integral_constant<bool, D == 2>());
+		walk([&](uint32_t i, size_t p)
+		{
+			fields[p] = FS_HIDDEN;
+			bombs[p] = layout[i];
+		});
+		walk([&](uint32_t, size_t p)
+		{
+			uint8_t a = 0;
+			for (unsigned n = 0; n < NEIGHBOURS; ++n)
+				a += bombs[p + offsets[n]];
+			adjacent[p] = a;
+		});
+	}
+
+	/// Get the count of fields in each dimension.
+	Point const& getExtents() const
+	{
+		return ext;
+	}
+	/// Get the count of fields.
+	uint32_t getSize() const
+	{
+		return size;
+	}
+	/// Get the count of bombs.
+	uint32_t getBombs() const
+	{
+		return bombCount;
+	}
+	/// Get the \ref #GAMESTATUS "game status".
+	GAMESTATUS getStatus() const
+	{
+		return status;
+	}
+	/// Get the count of revealed fields.
+	uint32_t getUnhidden() const
+	{
+		return unhidden;
+	}
+	/// Get the count of marked fields.
+	uint32_t getMarked() const
+	{
+		return marked;
+	}
+
+	/** Get the index of a position.
+	 * \warning Accessing a position outside of the board is undefined behaviour. */
+	uint32_t index(Point const& point) const
+	{
+		uint32_t i = 0;
+		for (unsigned j = D; j-- > 0;)
+			i = i * ext[j] + point[j];
+		return i;
+	}
+	/// Get the position of an index.
+	Point point(uint32_t index) const
+	{
+		Point p;
+		for (unsigned j = 0; j < D; ++j)
+		{
+			p[j] = index % ext[j];
+			index /= ext[j];
+		}
+		return p;
+	}
+
+	/// Get the \ref #FIELDSTATUS "status" of a field.
+	FIELDSTATUS getFieldStatus(uint32_t index) const
+	{
+		return (FIELDSTATUS) fields[padded(index)];
+	}
+	/// Get the count of adjacent bombs of a revealed field. 0 for all other fields.
+	uint8_t getAdjacentBombs(uint32_t index) const
+	{
+		size_t const p = padded(index);
+		return fields[p] == FS_UNHIDDEN ? adjacent[p] : 0;
+	}
+
+	/** Reveal a field like Field::reveal().
+	 * \return The count of revealed fields. */
+	uint32_t reveal(uint32_t index)
+	{
+		size_t const start = padded(index);
+		uint8_t& f = fields[start];
+		if (f == FS_MARKED || f == FS_UNHIDDEN || f == FS_BOMB)
+			return 0;
+
+		if (bombs[start])
+		{
+			f = FS_BOMB;
+			status = GS_LOST;
+			return 0;
+		}
+
+		uint32_t const before = unhidden;
+		stack.clear();
+		stack.push_back(start);
+		while (!stack.empty())
+		{
+			size_t p = stack.back();
+			stack.pop_back();
+			// Fields without adjacent bombs have no bomb neighbours, the border is revealed.
+			if (fields[p] == FS_MARKED || fields[p] == FS_UNHIDDEN)
+				continue;
+
+			fields[p] = FS_UNHIDDEN;
+			++unhidden;
+			if (adjacent[p] == 0)
+			{
+				for (unsigned n = 0; n < NEIGHBOURS; ++n)
+					stack.push_back(p + offsets[n]);
+			}
+		}
+
+		update();
+		return unhidden - before;
+	}
+
+	/// Cycle the mark of a field like Field::cycleMark().
+	void cycleMark(uint32_t index)
+	{
+		uint8_t& f = fields[padded(index)];
+		switch (f)
+		{
+		case FS_HIDDEN:
+			f = FS_MARKED;
+			++marked;
+			break;
+		case FS_MARKED:
+			f = FS_QUERIED;
+			--marked;
+			break;
+		case FS_QUERIED:
+			f = FS_HIDDEN;
+			break;
+		default:
+			return;
+		}
+		update();
+	}
+
+private:
+	Point ext;
+	uint32_t size;
+	uint32_t bombCount;
+	GAMESTATUS status;
+	uint32_t unhidden;
+	uint32_t marked;
+
+	/// The strides of the padded storage.
+	std::array<size_t, D> strides;
+	/// The offsets of the neighbours in the padded storage.
+	std::array<int64_t, NEIGHBOURS> offsets;
+	/// One status per field of the padded storage.
+	std::vector<uint8_t> fields;
+	std::vector<uint8_t> bombs;
+	std::vector<uint8_t> adjacent;
+	std::vector<size_t> stack;
+
+	/// Get the padded index of an index.
+	size_t padded(uint32_t index) const
+	{
+		size_t p = 0;
+		for (unsigned j = 0; j < D; ++j)
+		{
+			p += (index % ext[j] + 1) * strides[j];
+			index /= ext[j];
+		}
+		return p;
+	}
+
+	/// Call func(index, padded index) for every field in row-major order.
+	template<typename Func>
+	void walk(Func func) const
+	{
+		std::array<uint16_t, D> c;
+		c.fill(0);
+		size_t p = padded(0);
+		for (uint32_t i = 0; i < size; ++i)
+		{
+			func(i, p);
+			++p;
+			++c[0];
+			// Carry: Skip the border of each dimension that wraps
+			for (unsigned j = 0; j + 1 < D && c[j] == ext[j]; ++j)
+			{
+				c[j] = 0;
+				++c[j + 1];
+				p += 2 * strides[j];
+			}
+		}
+	}
+
+	/// The layout of Matrix::reset() for 2 dimensions.
+	void place(uint8_t* layout, uint32_t seed, std::true_type)
+	{
+		placeBombs(Dimensions(ext[0], ext[1], bombCount), seed, layout);
+	}
+	/// Selection sampling for any other count of dimensions.
+	void place(uint8_t* layout, uint32_t seed, std::false_type)
+	{
+		Random random(seed, 0);
+		uint32_t count = bombCount;
+		for (uint32_t i = 0; i < size; ++i)
+		{
+			bool const bomb = count && random.below(size - i) < count;
+			layout[i] = bomb;
+			count -= bomb;
+		}
+	}
+
+	void update()
+	{
+		// Same rule as the Matrix
+		if (status != GS_LOST)
+		{
+			if (unhidden == size - bombCount && marked == bombCount)
+				status = GS_WON;
+			else
+				status = GS_RUNNING;
+		}
+	}
+};
+
+} // namespace msm
+
+#endif /* BOARD_HPP_ */
+
+///\}
@@ -0,0 +1,180 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file boardView.cpp
+ *
+ * Implementation of \ref boardView.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "boardView.hpp"
+
+#include <algorithm>
+#include <list>
+#include <vector>
+
+namespace msm
+{
+
+struct BoardView::Impl
+{
+	Impl(Matrix& matrix) :
+			matrix(matrix), width(0), height(0)
+	{
+	}
+
+	Matrix& matrix;
+
+	std::list<BoardViewObserver*> observers;
+
+	uint16_t width;
+	uint16_t height;
+
+	/// One packed byte per field, row-major.
+	std::vector<uint8_t> cells;
+	/// Indices of the cells changed since the last flush, each once.
+	std::vector<int32_t> changed;
+	/// One flag per cell, set while the cell is in \ref changed.
+	std::vector<uint8_t> dirty;
+
+	void rebuild();
+};
+
+BoardView::BoardView(Matrix& matrix) :
+		pImpl(new BoardView::Impl(matrix))
+{
+	pImpl->rebuild();
+	matrix.addObserver(this);
+}
+
+BoardView::~BoardView()
+{
+	pImpl->matrix.removeObserver(this);
+	delete pImpl;
+}
+
+void BoardView::addObserver(BoardViewObserver* o)
+{
+	if (std::find_if(pImpl->observers.begin(), pImpl->observers.end(), compare_address<BoardViewObserver>(o))
+			== pImpl->observers.end())
+		pImpl->observers.push_back(o);
+}
+
+void BoardView::removeObserver(BoardViewObserver* o)
+{
+	pImpl->observers.remove_if(compare_address<BoardViewObserver>(o));
+}
+
+Matrix& BoardView::getMatrix() const
+{
+	return pImpl->matrix;
+}
+
+uint16_t BoardView::getWidth() const
+{
+	return pImpl->width;
+}
+
+uint16_t BoardView::getHeight() const
+{
+	return pImpl->height;
+}
+
+uint8_t* BoardView::getBuffer() const
+{
+	return pImpl->cells.empty() ? 0 : &pImpl->cells[0];
+}
+
+uint32_t BoardView::getBufferSize() const
+{
+	return pImpl->cells.size();
+}
+
+uint8_t BoardView::reveal(uint16_t x, uint16_t y)
+{
+	uint8_t result = pImpl->matrix.reveal(x, y);
+	flush();
+	return result;
+}
+
+void BoardView::cycleMark(uint16_t x, uint16_t y)
+{
+	pImpl->matrix[x][y].cycleMark();
+	flush();
+}
+
+uint32_t BoardView::apply(Action const* actions, uint32_t count, uint8_t* results)
+{
+	uint32_t executed = pImpl->matrix.apply(actions, count, results);
+	flush();
+	return executed;
+}
+
+void BoardView::flush()
+{
+	if (pImpl->changed.empty())
+		return;
+
+	for (std::list<BoardViewObserver*>::const_iterator it = pImpl->observers.begin(); it != pImpl->observers.end();
+			++it)
+		(*it)->onCellsChanged(*this, &pImpl->changed[0], pImpl->changed.size());
+
+	for (std::vector<int32_t>::const_iterator it = pImpl->changed.begin(); it != pImpl->changed.end(); ++it)
+		pImpl->dirty[*it] = 0;
+	// Keeps the capacity: No allocation for the following actions.
+	pImpl->changed.clear();
+}
+
+void BoardView::onGameStatusChanged(Matrix const&, GAMESTATUS status)
+{
+	if (status != GS_READY)
+		return;
+
+	pImpl->rebuild();
+
+	for (std::list<BoardViewObserver*>::const_iterator it = pImpl->observers.begin(); it != pImpl->observers.end();
+			++it)
+		(*it)->onBoardReset(*this);
+}
+
+void BoardView::onRemainingBombsChanged(Matrix const&, int32_t)
+{
+}
+
+void BoardView::onFieldStatusChanged(Matrix const&, Field const& field, FIELDSTATUS status)
+{
+	int32_t idx = (int32_t) field.getPosition().Y * pImpl->width + field.getPosition().X;
+	pImpl->cells[idx] = packCell(status, field.getAdjacentBombs());
+	// E.g. marked and unmarked again before the flush
+	if (pImpl->dirty[idx])
+		return;
+	pImpl->dirty[idx] = 1;
+	pImpl->changed.push_back(idx);
+}
+
+void BoardView::onFieldDelete(Matrix const&, Field const&)
+{
+}
+
+void BoardView::Impl::rebuild()
+{
+	width = matrix.getDimensions().getX();
+	height = matrix.getDimensions().getY();
+
+	cells.resize((size_t) width * height);
+	changed.clear();
+	dirty.assign(cells.size(), 0);
+	// A flush reports each cell once at most, so the moves never allocate
+	changed.reserve(cells.size());
+
+	std::vector<uint8_t>::iterator dst = cells.begin();
+	for (CellIterator it = matrix.begin(); it != matrix.end(); ++it, ++dst)
+		*dst = packCell(it->getStatus(), it->getAdjacentBombs());
+}
+
+} //namespace msm
+
+///\}
@@ -0,0 +1,167 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file boardView.hpp
+ *
+ * A packed view of a \ref msm::Matrix "matrix" for foreign runtimes (e.g. Java via JNI).
+ *
+ * The state of all fields is kept in one contiguous byte buffer (one byte per field,
+ * row-major) that can be shared without copying. With JNI the buffer is wrapped by
+ * a direct ByteBuffer:
+ * \code
+ * jobject buffer = env->NewDirectByteBuffer(view->getBuffer(), view->getBufferSize());
+ * \endcode
+ * Changes are not reported per field but collected and delivered in one batch per
+ * user action (see \ref msm::BoardViewObserver). This reduces the upcalls into the VM
+ * during a cascade to exactly one:
+ * \code
+ * void onCellsChanged(msm::BoardView const& view, int32_t const* indices, uint32_t count)
+ * {
+ *     jintArray array = env->NewIntArray(count);
+ *     env->SetIntArrayRegion(array, 0, count, indices);
+ *     env->CallVoidMethod((jobject) view.getJavaRef(), (jmethodID) view.getJavaMethodID(), array);
+ * }
+ * \endcode
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef BOARDVIEW_HPP_
+#define BOARDVIEW_HPP_
+
+#include <stdint.h>
+
+#include "config.hpp"
+#include "jniRef.hpp"
+#include "matrix.hpp"
+
+namespace msm
+{
+
+/// Mask for the \ref #FIELDSTATUS "status" bits of a packed cell.
+const uint8_t CELL_STATUS_MASK = 0x07;
+/// Shift of the count of adjacent bombs in a packed cell.
+const uint8_t CELL_ADJACENT_SHIFT = 4;
+
+/**
+ * Pack the state of a field into one byte.
+ * The bits 0-2 hold the \ref #FIELDSTATUS "status", the bits 4-7 the count of adjacent bombs.
+ * The count is only exposed for revealed fields.
+ * \param status The status of the field.
+ * \param adjacentBombs The count of adjacent bombs.
+ * \return The packed cell.
+ */
+inline uint8_t packCell(FIELDSTATUS status, uint8_t adjacentBombs)
+{
+	if (status != FS_UNHIDDEN)
+		adjacentBombs = 0;
+	return (uint8_t) ((adjacentBombs << CELL_ADJACENT_SHIFT) | (status & CELL_STATUS_MASK));
+}
+
+class BoardView;
+
+/// Interface for BoardView observers
+struct BoardViewObserver
+{
+	virtual ~BoardViewObserver()
+	{
+	}
+	/**
+	 * Method that is called once per user action (see \ref BoardView::flush()) when fields have changed.
+	 * \param view The view. The buffer already contains the new state.
+	 * \param indices The row-major indices (y * width + x) of the changed cells, each cell once
+	 * in the order of its first change. A cell changed back to its old status is reported too.
+	 * \param count The count of indices.
+	 */
+	virtual void onCellsChanged(BoardView const& view, int32_t const* indices, uint32_t count) = 0;
+	/**
+	 * Method that is called after the matrix was reset.
+	 * \note The buffer may have been reallocated. Wrap it again!
+	 * \param view The view.
+	 */
+	virtual void onBoardReset(BoardView const& view) = 0;
+};
+
+/**
+ * A packed, batching view of a Matrix.
+ * The view registers itself as observer of the matrix. It must be destroyed before the matrix.
+ */
+#if JNIREF
+class BoardView: public MatrixObserver, public JNIRef
+#else
+class BoardView: public MatrixObserver
+#endif
+{
+public:
+	struct Impl;
+
+	/** Constructor.
+	 * \param matrix The matrix to observe. */
+	explicit BoardView(Matrix& matrix);
+	/// Destructor.
+	virtual ~BoardView();
+
+	/** Register a view observer.
+	 * \param observer An Observer. */
+	void addObserver(BoardViewObserver* observer);
+	/** Remove a view observer.
+	 * \param observer An Observer. */
+	void removeObserver(BoardViewObserver* observer);
+
+	/// Get the observed matrix.
+	Matrix& getMatrix() const;
+	/// Get the count of cells in horizontal direction.
+	uint16_t getWidth() const;
+	/// Get the count of cells in vertical direction.
+	uint16_t getHeight() const;
+	/** Get the packed cells (see \ref packCell()).
+	 * The buffer stays valid until the next reset of the matrix. */
+	uint8_t* getBuffer() const;
+	/// Get the size of the buffer in bytes.
+	uint32_t getBufferSize() const;
+
+	/** Reveal a field and \ref flush() the changes.
+	 * \param x The X-coordinate inside the matrix.
+	 * \param y The Y-coordinate inside the matrix.
+	 * \return The result of \ref Matrix::reveal().
+	 * \throws IndexOutOfBoundsException If the position is outside of the matrix. */
+	uint8_t reveal(uint16_t x, uint16_t y);
+	/** Cycle the mark of a field and \ref flush() the changes.
+	 * \param x The X-coordinate inside the matrix.
+	 * \param y The Y-coordinate inside the matrix.
+	 * \throws IndexOutOfBoundsException If the position is outside of the matrix. */
+	void cycleMark(uint16_t x, uint16_t y);
+	/** Execute a batch of actions with \ref Matrix::apply() and \ref flush() the changes once.
+	 * \param actions The actions.
+	 * \param count The count of actions.
+	 * \param results Optional, receives one result per action.
+	 * \return The count of executed actions. */
+	uint32_t apply(Action const* actions, uint32_t count, uint8_t* results = 0);
+	/** Deliver all collected changes to the observers.
+	 * Call this after manipulating the matrix directly. */
+	void flush();
+
+	/// \internal
+	void onGameStatusChanged(Matrix const& matrix, GAMESTATUS status);
+	/// \internal
+	void onRemainingBombsChanged(Matrix const& matrix, int32_t bombs);
+	/// \internal
+	void onFieldStatusChanged(Matrix const& matrix, Field const& field, FIELDSTATUS status);
+	/// \internal
+	void onFieldDelete(Matrix const& matrix, Field const& field);
+
+protected:
+	Impl* pImpl;
+
+private:
+	BoardView(BoardView const& cp);
+	BoardView& operator=(BoardView const& cp);
+};
+
+} //namespace msm
+
+#endif /* BOARDVIEW_HPP_ */
+
+///\}
@@ -0,0 +1,112 @@
+/**
+ * @file boardView_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include "boardView.hpp"
+
+/// Simulates the JNI side: Counts the upcalls and keeps the transported indices.
+struct Fix_board_view_test: public msm::BoardViewObserver
+{
+	Fix_board_view_test() :
+			matrix(msm::Dimensions(4, 4, 0)), view(matrix), upcalls(0), resets(0)
+	{
+		view.addObserver(this);
+	}
+
+	void onCellsChanged(msm::BoardView const&, int32_t const* indices, uint32_t count)
+	{
+		++upcalls;
+		last.assign(indices, indices + count);
+	}
+
+	void onBoardReset(msm::BoardView const&)
+	{
+		++resets;
+	}
+
+	msm::Matrix matrix;
+	msm::BoardView view;
+
+	int upcalls;
+	int resets;
+	std::vector<int32_t> last;
+};
+
+BOOST_FIXTURE_TEST_SUITE(board_view_test_suite, Fix_board_view_test)
+
+BOOST_AUTO_TEST_CASE(cascade_test)
+{
+	BOOST_REQUIRE(16 == view.getBufferSize());
+	for (uint32_t i = 0; i < view.getBufferSize(); ++i)
+		BOOST_CHECK(msm::FS_HIDDEN == view.getBuffer()[i]);
+
+	view.reveal(1, 2);
+
+	BOOST_CHECK(1 == upcalls);
+	BOOST_REQUIRE(16 == last.size());
+	BOOST_CHECK(2 * 4 + 1 == last[0]);
+	for (uint32_t i = 0; i < view.getBufferSize(); ++i)
+		BOOST_CHECK(msm::FS_UNHIDDEN == view.getBuffer()[i]);
+}
+
+BOOST_AUTO_TEST_CASE(mark_test)
+{
+	view.cycleMark(3, 1);
+
+	BOOST_CHECK(1 == upcalls);
+	BOOST_REQUIRE(1 == last.size());
+	BOOST_CHECK(1 * 4 + 3 == last[0]);
+	BOOST_CHECK(msm::FS_MARKED == (view.getBuffer()[last[0]] & msm::CELL_STATUS_MASK));
+
+	// Nothing changed, no upcall.
+	view.flush();
+	BOOST_CHECK(1 == upcalls);
+}
+
+BOOST_AUTO_TEST_CASE(adjacent_test)
+{
+	matrix.reset(msm::Dimensions(2, 1, 1));
+	BOOST_CHECK(1 == resets);
+	BOOST_REQUIRE(2 == view.getBufferSize());
+	BOOST_CHECK(0 == view.getBuffer()[0] && 0 == view.getBuffer()[1]);
+
+	view.reveal(0, 0);
+	view.reveal(1, 0);
+	BOOST_CHECK(2 == upcalls);
+
+	uint8_t bomb = msm::packCell(msm::FS_BOMB, 0);
+	uint8_t one = msm::packCell(msm::FS_UNHIDDEN, 1);
+	uint8_t const* cells = view.getBuffer();
+	BOOST_CHECK((cells[0] == bomb && cells[1] == one) || (cells[0] == one && cells[1] == bomb));
+}
+
+BOOST_AUTO_TEST_CASE(direct_access_test)
+{
+	matrix[0][0].cycleMark();
+	matrix[1][0].cycleMark();
+	BOOST_CHECK(0 == upcalls);
+
+	view.flush();
+	BOOST_CHECK(1 == upcalls);
+	BOOST_CHECK(2 == last.size());
+
+	// A cell changed repeatedly between two flushes is reported once
+	for (int i = 0; i < 7; ++i)
+		matrix[2][3].cycleMark();
+	matrix[0][0].cycleMark();
+	view.flush();
+	BOOST_CHECK(2 == upcalls);
+	BOOST_REQUIRE(2 == last.size());
+	BOOST_CHECK(3 * 4 + 2 == last[0]);
+	BOOST_CHECK(0 == last[1]);
+	BOOST_CHECK(msm::FS_MARKED == (view.getBuffer()[last[0]] & msm::CELL_STATUS_MASK));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
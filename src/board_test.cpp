@@ -0,0 +1,170 @@
+/**
+ * @file board_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+#include "board.hpp"
+#include "simulation.hpp"
+
+namespace
+{
+/// Reveal every field and check the adjacent bombs against a count over all positions.
+template<unsigned D>
+void checkAdjacent(msm::Board<D>& board)
+{
+	uint32_t const size = board.getSize();
+	for (uint32_t i = 0; i < size; ++i)
+		board.reveal(i);
+
+	uint32_t bombs = 0;
+	for (uint32_t i = 0; i < size; ++i)
+	{
+		bombs += board.getFieldStatus(i) == msm::FS_BOMB;
+		if (board.getFieldStatus(i) != msm::FS_UNHIDDEN)
+			continue;
+
+		typename msm::Board<D>::Point const a = board.point(i);
+		BOOST_CHECK(board.index(a) == i);
+		uint8_t count = 0;
+		for (uint32_t k = 0; k < size; ++k)
+		{
+			typename msm::Board<D>::Point const b = board.point(k);
+			bool neighbour = k != i;
+			for (unsigned j = 0; j < D; ++j)
+				neighbour &= std::abs(a[j] - b[j]) <= 1;
+			count += neighbour && board.getFieldStatus(k) == msm::FS_BOMB;
+		}
+		BOOST_CHECK(count == board.getAdjacentBombs(i));
+	}
+	BOOST_CHECK(bombs == board.getBombs());
+	BOOST_CHECK(msm::GS_LOST == board.getStatus() || 0 == bombs);
+}
+}
+
+BOOST_AUTO_TEST_SUITE(board_test_suite)
+
+BOOST_AUTO_TEST_CASE(directions_test)
+{
+	BOOST_CHECK(2 == msm::Board<1>::NEIGHBOURS);
+	BOOST_CHECK(8 == msm::Board<2>::NEIGHBOURS);
+	BOOST_CHECK(26 == msm::Board<3>::NEIGHBOURS);
+	BOOST_CHECK(80 == msm::Board<4>::NEIGHBOURS);
+
+	// Every direction once, the center never
+	std::vector<int> seen(27, 0);
+	for (unsigned n = 0; n < 26; ++n)
+	{
+		int code = 0;
+		for (unsigned j = 0; j < 3; ++j)
+			code = code * 3 + msm::detail::direction(3, n, j) + 1;
+		++seen[code];
+	}
+	BOOST_CHECK(0 == seen[13]);
+	BOOST_CHECK(26 == std::count(seen.begin(), seen.end(), 1));
+}
+
+BOOST_AUTO_TEST_CASE(matrix_test)
+{
+	// The same game as the simulation board (and so the matrix) in 2D
+	msm::Dimensions d(30, 20, 80);
+	msm::Board<2> board;
+	msm::SimulationBoard simulation;
+	msm::Board<2>::Point const extents = { { 30, 20 } };
+	board.reset(extents, 80, 5);
+	simulation.reset(d, 5);
+	BOOST_CHECK(600 == board.getSize());
+	BOOST_CHECK(msm::GS_READY == board.getStatus());
+
+	for (uint32_t i = 0; i < 600; i += 7)
+	{
+		if (i % 3 == 0)
+		{
+			board.cycleMark(i);
+			simulation.cycleMark(i);
+		}
+		else if (simulation.getStatus() != msm::GS_LOST)
+			BOOST_CHECK(board.reveal(i) == simulation.reveal(i));
+	}
+	BOOST_CHECK(board.getStatus() == simulation.getStatus());
+	BOOST_CHECK(board.getUnhidden() == simulation.getUnhidden());
+	BOOST_CHECK(board.getMarked() == simulation.getMarked());
+	for (uint32_t i = 0; i < 600; ++i)
+	{
+		BOOST_CHECK(board.getFieldStatus(i) == simulation.getFieldStatus(i));
+		BOOST_CHECK(board.getAdjacentBombs(i) == simulation.getAdjacentBombs(i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(adjacent_test)
+{
+	msm::Board<1> line;
+	msm::Board<1>::Point const length = { { 50 } };
+	line.reset(length, 10, 1);
+	checkAdjacent(line);
+
+	msm::Board<3> cube;
+	msm::Board<3>::Point const extents = { { 7, 5, 6 } };
+	cube.reset(extents, 40, 2);
+	msm::Board<3>::Point const last = { { 6, 4, 5 } };
+	BOOST_CHECK(209 == cube.index(last));
+	BOOST_CHECK(cube.point(209) == last);
+	checkAdjacent(cube);
+
+	msm::Board<4> tesseract;
+	msm::Board<4>::Point const four = { { 4, 3, 5, 3 } };
+	tesseract.reset(four, 30, 3);
+	checkAdjacent(tesseract);
+
+	// 65535^5 fields overflow the index, the board stays as it was
+	msm::Board<5> huge;
+	msm::Board<5>::Point const extents5 = { { 65535, 65535, 65535, 65535, 65535 } };
+	BOOST_CHECK_THROW(huge.reset(extents5, 1, 1), std::invalid_argument);
+	msm::Board<3>::Point const wide = { { 65535, 65535, 2 } };
+	BOOST_CHECK_THROW(cube.reset(wide, 1, 1), std::invalid_argument);
+	BOOST_CHECK(210 == cube.getSize());
+}
+
+BOOST_AUTO_TEST_CASE(game_test)
+{
+	// Without bombs the first click reveals the whole cube
+	msm::Board<3> cube;
+	msm::Board<3>::Point const extents = { { 10, 10, 10 } };
+	cube.reset(extents, 0, 1);
+	BOOST_CHECK(1000 == cube.reveal(555));
+	BOOST_CHECK(msm::GS_WON == cube.getStatus());
+
+	// Marks stop the cascade and win the game
+	cube.reset(extents, 1, 1);
+	uint32_t bomb = 0;
+	for (; cube.getStatus() != msm::GS_LOST; ++bomb)
+		cube.reveal(bomb);
+	--bomb;
+
+	cube.reset(extents, 1, 1);
+	uint32_t const start = bomb < 500 ? 999 : 0;
+	uint32_t const other = bomb < 500 ? 990 : 9;
+	cube.cycleMark(other);
+	BOOST_CHECK(1 == cube.getMarked());
+	BOOST_CHECK(cube.reveal(start) > 900);
+	BOOST_CHECK(msm::FS_MARKED == cube.getFieldStatus(other));
+	cube.cycleMark(other);
+	cube.cycleMark(other);
+	BOOST_CHECK(0 == cube.getMarked());
+	for (uint32_t i = 0; i < 1000; ++i)
+		if (i != bomb)
+			cube.reveal(i);
+	BOOST_CHECK(999 == cube.getUnhidden());
+	BOOST_CHECK(msm::GS_RUNNING == cube.getStatus());
+	cube.cycleMark(bomb);
+	BOOST_CHECK(msm::GS_WON == cube.getStatus());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
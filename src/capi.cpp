@@ -0,0 +1,180 @@
+/**
+ * \addtogroup capi
+ * \{
+ *
+ * \file capi.cpp
+ *
+ * Implementation of \ref capi.h
+ *
+ * No exception must leave this file.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "capi.h"
+
+#include <cstring>
+#include <new>
+
+#include "capiBoard.hpp"
+
+msm_board* msm_board_create(uint16_t width, uint16_t height, uint32_t bombs)
+{
+	try
+	{
+		return new msm_board(width, height, bombs);
+	} catch (...)
+	{
+		return 0;
+	}
+}
+
+void msm_board_destroy(msm_board* board)
+{
+	delete board;
+}
+
+int msm_reset(msm_board* board, uint16_t width, uint16_t height, uint32_t bombs)
+{
+	if (!board)
+		return MSM_ERROR_ARGUMENT;
+
+	try
+	{
+		board->matrix.reset(msm::Dimensions(width, height, bombs));
+		board->prepare();
+	} catch (std::bad_alloc const&)
+	{
+		return MSM_ERROR_MEMORY;
+	} catch (...)
+	{
+		return MSM_ERROR_INTERNAL;
+	}
+	return MSM_OK;
+}
+
+int msm_reset_seeded(msm_board* board, uint16_t width, uint16_t height, uint32_t bombs, uint32_t seed)
+{
+	if (!board)
+		return MSM_ERROR_ARGUMENT;
+
+	try
+	{
+		board->matrix.reset(msm::Dimensions(width, height, bombs), seed);
+		board->prepare();
+	} catch (std::bad_alloc const&)
+	{
+		return MSM_ERROR_MEMORY;
+	} catch (...)
+	{
+		return MSM_ERROR_INTERNAL;
+	}
+	return MSM_OK;
+}
+
+int msm_get_seed(msm_board const* board, uint32_t* seed)
+{
+	if (!board || !seed)
+		return MSM_ERROR_ARGUMENT;
+	*seed = board->matrix.getSeed();
+	return MSM_OK;
+}
+
+int msm_get_dimensions(msm_board const* board, uint16_t* width, uint16_t* height, uint32_t* bombs)
+{
+	if (!board)
+		return MSM_ERROR_ARGUMENT;
+
+	msm::Dimensions const& d = board->matrix.getDimensions();
+	if (width)
+		*width = d.getX();
+	if (height)
+		*height = d.getY();
+	if (bombs)
+		*bombs = d.getBombs();
+	return MSM_OK;
+}
+
+int msm_get_status(msm_board const* board)
+{
+	if (!board)
+		return MSM_ERROR_ARGUMENT;
+	return board->matrix.getStatus();
+}
+
+int msm_get_remaining_bombs(msm_board const* board, int32_t* remaining)
+{
+	if (!board || !remaining)
+		return MSM_ERROR_ARGUMENT;
+	*remaining = board->matrix.getRemainingBombs();
+	return MSM_OK;
+}
+
+int msm_reveal(msm_board* board, uint16_t x, uint16_t y, uint8_t* result)
+{
+	if (!board)
+		return MSM_ERROR_ARGUMENT;
+	if (!board->contains(x, y))
+		return MSM_ERROR_BOUNDS;
+
+	try
+	{
+		board->view.reveal(x, y);
+	} catch (std::bad_alloc const&)
+	{
+		return MSM_ERROR_MEMORY;
+	} catch (...)
+	{
+		return MSM_ERROR_INTERNAL;
+	}
+	/* Matrix::reveal() returns FS_BOMB for a bomb, which is also a count of adjacent
+	 * bombs. The flushed cell tells them apart. */
+	if (result)
+		*result = board->view.getBuffer()[(size_t) y * board->view.getWidth() + x];
+	return MSM_OK;
+}
+
+int msm_cycle_mark(msm_board* board, uint16_t x, uint16_t y)
+{
+	if (!board)
+		return MSM_ERROR_ARGUMENT;
+	if (!board->contains(x, y))
+		return MSM_ERROR_BOUNDS;
+
+	try
+	{
+		board->view.cycleMark(x, y);
+	} catch (std::bad_alloc const&)
+	{
+		return MSM_ERROR_MEMORY;
+	} catch (...)
+	{
+		return MSM_ERROR_INTERNAL;
+	}
+	return MSM_OK;
+}
+
+int msm_read_region(msm_board const* board, uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+		uint8_t* buffer, size_t stride)
+{
+	if (!board || (!buffer && width && height) || stride < width)
+		return MSM_ERROR_ARGUMENT;
+
+	uint32_t boardWidth = board->view.getWidth();
+	if ((uint32_t) x + width > boardWidth || (uint32_t) y + height > board->view.getHeight())
+		return MSM_ERROR_BOUNDS;
+
+	uint8_t const* src = board->view.getBuffer();
+	for (uint16_t row = 0; row < height; ++row)
+		std::memcpy(buffer + row * stride, src + ((size_t) (y + row) * boardWidth + x), width);
+
+	return MSM_OK;
+}
+
+uint8_t const* msm_board_cells(msm_board const* board)
+{
+	return board ? board->view.getBuffer() : 0;
+}
+
+///\}
@@ -0,0 +1,189 @@
+/**
+ * \addtogroup capi
+ * \{
+ *
+ * \file capi.h
+ *
+ * Stable C interface of the library for embedding from other runtimes
+ * (e.g. Python ctypes/cffi, Go cgo).
+ *
+ * - A board is accessed through an opaque handle.
+ * - No function throws. Errors are reported by negative \ref msm_result "result codes".
+ * - Apart from creating and resetting a board, no function allocates memory. The one exception
+ *   is a reveal whose cascade needs a deeper stack than any reveal before: The reused stack grows.
+ *   All data is written into buffers provided by the caller.
+ *
+ * Cells are reported packed into one byte: The bits 0-2 hold the field status
+ * (MSM_FS_*), the bits 4-7 hold the count of adjacent bombs of revealed fields.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef CAPI_H_
+#define CAPI_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* The library is built with MSM_BUILDING and exports the functions, users of the DLL
+ * import them. Users of the static library define MSM_STATIC. */
+#if defined(_WIN32) && defined(MSM_STATIC)
+#define MSM_API
+#elif defined(_WIN32) && defined(MSM_BUILDING)
+#define MSM_API __declspec(dllexport)
+#elif defined(_WIN32)
+#define MSM_API __declspec(dllimport)
+#elif defined(__GNUC__)
+#define MSM_API __attribute__((visibility("default")))
+#else
+#define MSM_API
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Opaque board handle.
+typedef struct msm_board msm_board;
+
+/// Result codes.
+enum msm_result
+{
+	MSM_OK = 0, //!< Success.
+	MSM_ERROR_ARGUMENT = -1, //!< Invalid handle or NULL pointer.
+	MSM_ERROR_BOUNDS = -2, //!< Coordinates outside of the board.
+	MSM_ERROR_MEMORY = -3, //!< Out of memory.
+	MSM_ERROR_INTERNAL = -4 //!< Unexpected error.
+};
+
+/// Field status constants (see msm::FIELDSTATUS).
+enum msm_field_status
+{
+	MSM_FS_HIDDEN = 0, MSM_FS_UNHIDDEN = 1, MSM_FS_MARKED = 2, MSM_FS_QUERIED = 3, MSM_FS_BOMB = 4
+};
+
+/// Game status constants (see msm::GAMESTATUS).
+enum msm_game_status
+{
+	MSM_GS_READY = 0, MSM_GS_RUNNING = 1, MSM_GS_WON = 2, MSM_GS_LOST = 3
+};
+
+/// Mask for the status bits of a packed cell.
+#define MSM_CELL_STATUS_MASK 0x07
+/// Shift of the count of adjacent bombs in a packed cell.
+#define MSM_CELL_ADJACENT_SHIFT 4
+
+/**
+ * Create a board.
+ * \param width The horizontal count of fields.
+ * \param height The vertical count of fields.
+ * \param bombs The count of bombs (clamped to the count of fields).
+ * \return A handle or NULL if out of memory.
+ */
+MSM_API msm_board* msm_board_create(uint16_t width, uint16_t height, uint32_t bombs);
+
+/**
+ * Destroy a board.
+ * \param board A handle or NULL.
+ */
+MSM_API void msm_board_destroy(msm_board* board);
+
+/**
+ * Start a new game with new dimensions.
+ * \param board A handle.
+ * \param width The horizontal count of fields.
+ * \param height The vertical count of fields.
+ * \param bombs The count of bombs (clamped to the count of fields).
+ * \return A result code.
+ */
+MSM_API int msm_reset(msm_board* board, uint16_t width, uint16_t height, uint32_t bombs);
+
+/**
+ * Start a new game with a reproducible layout.
+ * The same dimensions and seed always produce the same layout.
+ * \param board A handle.
+ * \param width The horizontal count of fields.
+ * \param height The vertical count of fields.
+ * \param bombs The count of bombs (clamped to the count of fields).
+ * \param seed The seed for the bomb placement.
+ * \return A result code.
+ */
+MSM_API int msm_reset_seeded(msm_board* board, uint16_t width, uint16_t height, uint32_t bombs, uint32_t seed);
+
+/**
+ * Get the seed of the current layout.
+ * \param board A handle.
+ * \param seed Receives the seed.
+ * \return A result code.
+ */
+MSM_API int msm_get_seed(msm_board const* board, uint32_t* seed);
+
+/**
+ * Get the dimensions of the board. Any of the output pointers may be NULL.
+ * \return A result code.
+ */
+MSM_API int msm_get_dimensions(msm_board const* board, uint16_t* width, uint16_t* height, uint32_t* bombs);
+
+/**
+ * Get the game status.
+ * \return A msm_game_status or a negative result code.
+ */
+MSM_API int msm_get_status(msm_board const* board);
+
+/**
+ * Get the count of remaining bombs (bombs - marked fields). Can be negative.
+ * \param board A handle.
+ * \param remaining Receives the count.
+ * \return A result code.
+ */
+MSM_API int msm_get_remaining_bombs(msm_board const* board, int32_t* remaining);
+
+/**
+ * Reveal a field. Revealing a field without adjacent bombs opens the surrounding area.
+ * \param board A handle.
+ * \param x The column of the field.
+ * \param y The row of the field.
+ * \param result Optional, receives the packed cell of the field after the reveal:
+ * MSM_FS_BOMB if a bomb was hit, MSM_FS_UNHIDDEN with the count of adjacent bombs,
+ * or the unchanged status of a marked field.
+ * \return A result code.
+ */
+MSM_API int msm_reveal(msm_board* board, uint16_t x, uint16_t y, uint8_t* result);
+
+/**
+ * Cycle the mark of a field: Hidden, Marked, Queried.
+ * \return A result code.
+ */
+MSM_API int msm_cycle_mark(msm_board* board, uint16_t x, uint16_t y);
+
+/**
+ * Copy the packed cells of a rectangular region into a caller buffer.
+ * \param board A handle.
+ * \param x The left column of the region.
+ * \param y The top row of the region.
+ * \param width The width of the region.
+ * \param height The height of the region.
+ * \param buffer Destination. Row r of the region is written to buffer + r * stride.
+ * \param stride The distance between two rows in the buffer in bytes (>= width).
+ * \return A result code.
+ */
+MSM_API int msm_read_region(msm_board const* board, uint16_t x, uint16_t y, uint16_t width, uint16_t height,
+		uint8_t* buffer, size_t stride);
+
+/**
+ * Get a pointer to the packed cells of the whole board (row-major, width bytes per row).
+ * The pointer is valid until the next reset or destruction of the board.
+ * \param board A handle.
+ * \return The cells or NULL.
+ */
+MSM_API uint8_t const* msm_board_cells(msm_board const* board);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CAPI_H_ */
+
+///\}
@@ -0,0 +1,47 @@
+/**
+ * \addtogroup capi
+ * \{
+ *
+ * \file capiBoard.hpp
+ *
+ * \internal The object behind the handle of \ref capi.h, for the implementation and the tests.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef CAPIBOARD_HPP_
+#define CAPIBOARD_HPP_
+
+#include "capi.h"
+
+#include "boardView.hpp"
+#include "matrix.hpp"
+
+/// The board of a handle: A matrix and the packed view of it.
+struct msm_board
+{
+	msm_board(uint16_t width, uint16_t height, uint32_t bombs) :
+			matrix(msm::Dimensions(width, height, bombs)), view(matrix)
+	{
+		prepare();
+	}
+
+	msm::Matrix matrix;
+	/// Keeps the packed cells up to date.
+	msm::BoardView view;
+
+	bool contains(uint16_t x, uint16_t y) const
+	{
+		return x < view.getWidth() && y < view.getHeight();
+	}
+	/// Label the openings now, otherwise the first reveal after a reset would allocate.
+	void prepare()
+	{
+		matrix.getOpenings();
+	}
+};
+
+#endif /* CAPIBOARD_HPP_ */
+
+///\}
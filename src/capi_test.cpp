@@ -0,0 +1,163 @@
+/**
+ * @file capi_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "capi.h"
+#include "capiBoard.hpp"
+#include "memory.hpp"
+
+namespace
+{
+/// Counts the allocations of the memory for a board.
+struct CountingResource: public msm::MemoryResource
+{
+	CountingResource() :
+			allocations(0)
+	{
+	}
+
+	size_t allocations;
+
+	void* doAllocate(size_t bytes, size_t alignment)
+	{
+		++allocations;
+		return msm::newDeleteResource()->allocate(bytes, alignment);
+	}
+	void doDeallocate(void* p, size_t bytes, size_t alignment)
+	{
+		msm::newDeleteResource()->deallocate(p, bytes, alignment);
+	}
+};
+}
+
+BOOST_AUTO_TEST_SUITE(capi_test_suite)
+
+BOOST_AUTO_TEST_CASE(lifecycle_test)
+{
+	msm_board* board = msm_board_create(5, 3, 2);
+	BOOST_REQUIRE(board != 0);
+
+	uint16_t w = 0, h = 0;
+	uint32_t b = 0;
+	BOOST_CHECK(MSM_OK == msm_get_dimensions(board, &w, &h, &b));
+	BOOST_CHECK(5 == w && 3 == h && 2 == b);
+	BOOST_CHECK(MSM_GS_READY == msm_get_status(board));
+
+	BOOST_CHECK(MSM_OK == msm_reset(board, 2, 2, 0));
+	BOOST_CHECK(MSM_OK == msm_get_dimensions(board, &w, 0, 0));
+	BOOST_CHECK(2 == w);
+
+	msm_board_destroy(board);
+	msm_board_destroy(0);
+}
+
+BOOST_AUTO_TEST_CASE(seed_test)
+{
+	msm_board* a = msm_board_create(0, 0, 0);
+	msm_board* b = msm_board_create(0, 0, 0);
+
+	BOOST_CHECK(MSM_OK == msm_reset_seeded(a, 16, 16, 40, 1234));
+	BOOST_CHECK(MSM_OK == msm_reset_seeded(b, 16, 16, 40, 1234));
+	uint32_t seed = 0;
+	BOOST_CHECK(MSM_OK == msm_get_seed(a, &seed));
+	BOOST_CHECK(1234 == seed);
+
+	// Reveal everything: Same layout, same board
+	for (uint16_t y = 0; y < 16; ++y)
+		for (uint16_t x = 0; x < 16; ++x)
+		{
+			msm_reveal(a, x, y, 0);
+			msm_reveal(b, x, y, 0);
+		}
+	uint8_t ca[256], cb[256];
+	BOOST_REQUIRE(MSM_OK == msm_read_region(a, 0, 0, 16, 16, ca, 16));
+	BOOST_REQUIRE(MSM_OK == msm_read_region(b, 0, 0, 16, 16, cb, 16));
+	BOOST_CHECK_EQUAL_COLLECTIONS(ca, ca + 256, cb, cb + 256);
+
+	msm_board_destroy(a);
+	msm_board_destroy(b);
+}
+
+BOOST_AUTO_TEST_CASE(error_test)
+{
+	msm_board* board = msm_board_create(2, 2, 0);
+	uint8_t buffer[4];
+
+	BOOST_CHECK(MSM_ERROR_ARGUMENT == msm_reveal(0, 0, 0, 0));
+	BOOST_CHECK(MSM_ERROR_ARGUMENT == msm_get_status(0));
+	BOOST_CHECK(MSM_ERROR_ARGUMENT == msm_get_remaining_bombs(board, 0));
+	BOOST_CHECK(MSM_ERROR_BOUNDS == msm_reveal(board, 2, 0, 0));
+	BOOST_CHECK(MSM_ERROR_BOUNDS == msm_cycle_mark(board, 0, 2));
+	BOOST_CHECK(MSM_ERROR_BOUNDS == msm_read_region(board, 1, 0, 2, 1, buffer, 2));
+	BOOST_CHECK(MSM_ERROR_ARGUMENT == msm_read_region(board, 0, 0, 2, 1, buffer, 1));
+	BOOST_CHECK(0 == msm_board_cells(0));
+
+	msm_board_destroy(board);
+}
+
+BOOST_AUTO_TEST_CASE(play_test)
+{
+	msm_board* board = msm_board_create(3, 2, 0);
+
+	BOOST_CHECK(MSM_OK == msm_cycle_mark(board, 2, 1));
+	int32_t remaining = 0;
+	BOOST_CHECK(MSM_OK == msm_get_remaining_bombs(board, &remaining));
+	BOOST_CHECK(-1 == remaining);
+
+	uint8_t result = 0xFF;
+	BOOST_CHECK(MSM_OK == msm_reveal(board, 0, 0, &result));
+	BOOST_CHECK(MSM_FS_UNHIDDEN == result);
+	BOOST_CHECK(MSM_GS_RUNNING == msm_get_status(board));
+	BOOST_CHECK(MSM_OK == msm_reveal(board, 2, 1, &result));
+	BOOST_CHECK(MSM_FS_MARKED == result);
+
+	uint8_t region[2 * 4] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+	BOOST_REQUIRE(MSM_OK == msm_read_region(board, 1, 0, 2, 2, region, 4));
+	BOOST_CHECK(MSM_FS_UNHIDDEN == region[0] && MSM_FS_UNHIDDEN == region[1]);
+	BOOST_CHECK(MSM_FS_UNHIDDEN == region[4] && MSM_FS_MARKED == region[5]);
+	// Padding between the rows is untouched.
+	BOOST_CHECK(0xFF == region[2] && 0xFF == region[3]);
+
+	uint8_t const* cells = msm_board_cells(board);
+	BOOST_REQUIRE(cells != 0);
+	BOOST_CHECK(MSM_FS_MARKED == (cells[1 * 3 + 2] & MSM_CELL_STATUS_MASK));
+
+	// A bomb is reported by its status
+	BOOST_REQUIRE(MSM_OK == msm_reset(board, 2, 3, 6));
+	BOOST_CHECK(MSM_OK == msm_reveal(board, 1, 1, &result));
+	BOOST_CHECK(MSM_FS_BOMB == result);
+	BOOST_CHECK(MSM_GS_LOST == msm_get_status(board));
+
+	msm_board_destroy(board);
+}
+
+BOOST_AUTO_TEST_CASE(allocation_test)
+{
+	CountingResource resource;
+	msm_board* board = msm_board_create(0, 0, 0);
+	board->matrix.setMemoryResource(&resource);
+	for (uint32_t bombs = 0; bombs <= 9000; bombs += 3000)
+	{
+		// The reset takes the memory of the board
+		size_t const reset = resource.allocations;
+		BOOST_REQUIRE(MSM_OK == msm_reset_seeded(board, 300, 300, bombs, 7));
+		BOOST_CHECK(resource.allocations > reset);
+		size_t const before = resource.allocations;
+
+		// The marks block the openings, so the reveals cascade field by field
+		for (uint16_t i = 0; i < 300; i += 7)
+			BOOST_CHECK(MSM_OK == msm_cycle_mark(board, i, 299 - i));
+		for (uint16_t y = 0; y < 300; y += 13)
+			for (uint16_t x = 0; x < 300; x += 11)
+				BOOST_CHECK(MSM_OK == msm_reveal(board, x, y, 0));
+		BOOST_CHECK(before == resource.allocations);
+	}
+	msm_board_destroy(board);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -16,9 +16,14 @@
 #define JNIREF 1
 #endif
 
-#ifndef BOOST_SIGNALS
-/// Enable/Disable additional signals (boost::signals2 needed).
-#define BOOST_SIGNALS 1
+#ifndef SIGNALS
+#ifdef BOOST_SIGNALS
+// The former name of the switch, from when the signals needed boost::signals2.
+#define SIGNALS BOOST_SIGNALS
+#else
+/// Enable/Disable additional signals (see signal.hpp).
+#define SIGNALS 1
+#endif
 #endif
 
 #endif /* CONFIG_HPP_ */
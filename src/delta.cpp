@@ -0,0 +1,205 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file delta.cpp
+ *
+ * Implementation of \ref delta.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "delta.hpp"
+
+#include <algorithm>
+
+namespace msm
+{
+
+namespace
+{
+void writeVarint(std::vector<uint8_t>& out, uint32_t value)
+{
+	while (value >= 0x80)
+	{
+		out.push_back((uint8_t) (value | 0x80));
+		value >>= 7;
+	}
+	out.push_back((uint8_t) value);
+}
+
+bool readVarint(uint8_t const*& data, uint8_t const* end, uint32_t& value)
+{
+	value = 0;
+	for (uint8_t shift = 0; shift < 35 && data != end; shift += 7)
+	{
+		uint8_t b = *data++;
+		value |= (uint32_t) (b & 0x7F) << shift;
+		if (!(b & 0x80))
+			return true;
+	}
+	return false;
+}
+
+uint8_t toSymbol(uint8_t cell)
+{
+	uint8_t const status = cell & CELL_STATUS_MASK;
+	return status == FS_UNHIDDEN ? cell >> CELL_ADJACENT_SHIFT : DELTA_STATUS_SYMBOL + status;
+}
+
+/// Returns false for symbols that don't stand for a cell.
+bool toCell(uint8_t symbol, uint8_t& cell)
+{
+	if (symbol < DELTA_STATUS_SYMBOL)
+	{
+		cell = packCell(FS_UNHIDDEN, symbol);
+		return true;
+	}
+	uint8_t const status = symbol - DELTA_STATUS_SYMBOL;
+	if (status == FS_UNHIDDEN || status > FS_BOMB)
+		return false;
+	cell = packCell((FIELDSTATUS) status, 0);
+	return true;
+}
+}
+
+DeltaEncoder::DeltaEncoder()
+{
+}
+
+void DeltaEncoder::add(uint32_t index, uint8_t cell)
+{
+	keys.push_back((uint64_t) index << 32 | cells.size());
+	cells.push_back(cell);
+}
+
+size_t DeltaEncoder::flush(std::vector<uint8_t>& out)
+{
+	if (cells.empty())
+		return 0;
+
+	// Sorted by index, the last change of a field is the last of its group
+	std::sort(keys.begin(), keys.end());
+
+	runs.clear();
+	symbols.clear();
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		uint32_t const index = keys[i] >> 32;
+		if (i + 1 < keys.size() && keys[i + 1] >> 32 == index)
+			continue;
+
+		if (!runs.empty() && runs[runs.size() - 2] + runs.back() == index)
+			++runs.back();
+		else
+		{
+			runs.push_back(index);
+			runs.push_back(1);
+		}
+		symbols.push_back(toSymbol(cells[(uint32_t) keys[i]]));
+	}
+
+	size_t const before = out.size();
+	writeVarint(out, symbols.size());
+	writeVarint(out, runs.size() / 2);
+	uint32_t end = 0;
+	for (size_t r = 0; r < runs.size(); r += 2)
+	{
+		writeVarint(out, runs[r] - end);
+		writeVarint(out, runs[r + 1] - 1);
+		end = runs[r] + runs[r + 1];
+	}
+	for (size_t s = 0; s < symbols.size(); s += 2)
+		out.push_back((uint8_t) (symbols[s] | (s + 1 < symbols.size() ? symbols[s + 1] << 4 : 0)));
+
+	clear();
+	return out.size() - before;
+}
+
+void DeltaEncoder::clear()
+{
+	// Keeps the capacity: No allocation for the following actions.
+	cells.clear();
+	keys.clear();
+}
+
+void DeltaEncoder::onGameStatusChanged(Matrix const&, GAMESTATUS status)
+{
+	if (status == GS_READY)
+		clear();
+}
+
+void DeltaEncoder::onRemainingBombsChanged(Matrix const&, int32_t)
+{
+}
+
+void DeltaEncoder::onFieldStatusChanged(Matrix const& matrix, Field const& field, FIELDSTATUS status)
+{
+	Position const& p = field.getPosition();
+	add((uint32_t) p.Y * matrix.getDimensions().getX() + p.X, packCell(status, field.getAdjacentBombs()));
+}
+
+void DeltaEncoder::onFieldDelete(Matrix const&, Field const&)
+{
+}
+
+MirrorBoard::MirrorBoard() :
+		width(0), height(0)
+{
+}
+
+void MirrorBoard::reset(uint16_t w, uint16_t h)
+{
+	width = w;
+	height = h;
+	cells.assign((size_t) w * h, packCell(FS_HIDDEN, 0));
+}
+
+bool MirrorBoard::apply(uint8_t const* data, size_t size, std::vector<uint32_t>* changed)
+{
+	uint8_t const* const end = data + size;
+	uint32_t count, runCount;
+	if (!readVarint(data, end, count) || !readVarint(data, end, runCount) || runCount > count)
+		return false;
+
+	// Check everything before the first cell is changed
+	runs.clear();
+	uint64_t position = 0, total = 0;
+	for (uint32_t r = 0; r < runCount; ++r)
+	{
+		uint32_t gap, length;
+		if (!readVarint(data, end, gap) || !readVarint(data, end, length))
+			return false;
+		position += gap;
+		total += (uint64_t) length + 1;
+		if (position + length + 1 > cells.size() || total > count)
+			return false;
+		runs.push_back((uint32_t) position);
+		runs.push_back(length + 1);
+		position += length + 1;
+	}
+	if (total != count || (size_t) (end - data) != (count + 1) / 2)
+		return false;
+
+	uint8_t cell;
+	for (uint32_t s = 0; s < count; ++s)
+		if (!toCell((data[s / 2] >> (s & 1) * 4) & 0x0F, cell))
+			return false;
+
+	uint32_t s = 0;
+	for (size_t r = 0; r < runs.size(); r += 2)
+	{
+		for (uint32_t i = runs[r]; i < runs[r] + runs[r + 1]; ++i, ++s)
+		{
+			toCell((data[s / 2] >> (s & 1) * 4) & 0x0F, cells[i]);
+			if (changed)
+				changed->push_back(i);
+		}
+	}
+	return true;
+}
+
+} // namespace msm
+
+///\}
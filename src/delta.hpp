@@ -0,0 +1,148 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file delta.hpp
+ *
+ * Compact binary deltas of field changes to keep a remote copy of a \ref msm::Matrix "matrix" in sync.
+ *
+ * Instead of one message per changed field, a server collects the changes of a user action
+ * with a \ref msm::DeltaEncoder "DeltaEncoder" and sends them as one delta. The client applies
+ * it to a \ref msm::MirrorBoard "MirrorBoard". The format:
+ * \code
+ * varint        count of cells
+ * varint        count of runs
+ * runs:         varint gap (to the end of the previous run), varint length - 1
+ * symbols:      one nibble per cell in run order, low nibble first
+ * \endcode
+ * Varints are unsigned LEB128. A run is a range of consecutive row-major indices.
+ * A symbol is the count of adjacent bombs (0-8) for a revealed field and
+ * \ref msm::DELTA_STATUS_SYMBOL "DELTA_STATUS_SYMBOL" + status for all others.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef DELTA_HPP_
+#define DELTA_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "boardView.hpp"
+#include "matrix.hpp"
+
+namespace msm
+{
+
+/// The symbol of a hidden field in a delta. Other statuses follow in \ref #FIELDSTATUS "order".
+const uint8_t DELTA_STATUS_SYMBOL = 9;
+
+/**
+ * Collects field changes and encodes them into deltas.
+ *
+ * Register the encoder as \ref MatrixObserver of exactly one matrix or \ref add() the changes
+ * directly. \ref flush() encodes the changes collected since the last flush. If a field changed
+ * more than once, only its last status is sent.
+ *
+ * \note A \ref GS_READY "reset" of the matrix drops the pending changes. The client has to
+ * \ref MirrorBoard::reset() "reset" its mirror, too.
+ */
+class DeltaEncoder: public MatrixObserver
+{
+public:
+	/// Constructor.
+	DeltaEncoder();
+
+	/** Add a change.
+	 * \param index The row-major index of the field (y * width + x).
+	 * \param cell The \ref packCell() "packed cell". */
+	void add(uint32_t index, uint8_t cell);
+	/// Get the count of changes collected since the last flush.
+	size_t getPending() const
+	{
+		return cells.size();
+	}
+
+	/** Encode the collected changes and forget them.
+	 * \param out The delta is appended to it.
+	 * \return The count of bytes appended. 0 if nothing changed. */
+	size_t flush(std::vector<uint8_t>& out);
+	/// Forget the collected changes.
+	void clear();
+
+	/// \internal
+	void onGameStatusChanged(Matrix const& matrix, GAMESTATUS status);
+	/// \internal
+	void onRemainingBombsChanged(Matrix const& matrix, int32_t bombs);
+	/// \internal
+	void onFieldStatusChanged(Matrix const& matrix, Field const& field, FIELDSTATUS status);
+	/// \internal
+	void onFieldDelete(Matrix const& matrix, Field const& field);
+
+private:
+	/// The packed cells in the order of the changes.
+	std::vector<uint8_t> cells;
+	/// index << 32 | number of the change, sorted while flushing.
+	std::vector<uint64_t> keys;
+	std::vector<uint32_t> runs;
+	std::vector<uint8_t> symbols;
+};
+
+/**
+ * The client side: A board of \ref packCell() "packed cells" that is kept in sync by deltas.
+ * The cells have the same layout as the buffer of a \ref BoardView.
+ */
+class MirrorBoard
+{
+public:
+	/// Create an empty board.
+	MirrorBoard();
+
+	/** Resize the board. All fields are hidden afterwards.
+	 * \param width The count of columns.
+	 * \param height The count of rows. */
+	void reset(uint16_t width, uint16_t height);
+
+	/// Get the count of cells in horizontal direction.
+	uint16_t getWidth() const
+	{
+		return width;
+	}
+	/// Get the count of cells in vertical direction.
+	uint16_t getHeight() const
+	{
+		return height;
+	}
+	/// Get the packed cell at a row-major index.
+	uint8_t getCell(uint32_t index) const
+	{
+		return cells[index];
+	}
+	/// Get the packed cells.
+	std::vector<uint8_t> const& getCells() const
+	{
+		return cells;
+	}
+
+	/** Apply a delta.
+	 * \param data The delta.
+	 * \param size The size of the delta in bytes.
+	 * \param changed Receives the row-major indices of the changed cells, if not 0.
+	 * \return False if the delta is malformed or doesn't fit the board. Nothing is changed then. */
+	bool apply(uint8_t const* data, size_t size, std::vector<uint32_t>* changed = 0);
+
+private:
+	uint16_t width;
+	uint16_t height;
+	std::vector<uint8_t> cells;
+	/// Start and length of each run of the delta being applied.
+	std::vector<uint32_t> runs;
+};
+
+} // namespace msm
+
+#endif /* DELTA_HPP_ */
+
+///\}
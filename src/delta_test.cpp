@@ -0,0 +1,130 @@
+/**
+ * @file delta_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "delta.hpp"
+
+namespace
+{
+void checkSame(msm::Matrix const& matrix, msm::MirrorBoard const& mirror)
+{
+	uint32_t i = 0;
+	for (msm::CellIterator it = matrix.begin(); it != matrix.end(); ++it, ++i)
+		BOOST_CHECK(msm::packCell(it->getStatus(), it->getAdjacentBombs()) == mirror.getCell(i));
+}
+}
+
+BOOST_AUTO_TEST_SUITE(delta_test_suite)
+
+BOOST_AUTO_TEST_CASE(loopback_test)
+{
+	// Server: the matrix with an encoder, client: the mirror. The wire is a byte buffer.
+	msm::Matrix matrix;
+	msm::DeltaEncoder encoder;
+	matrix.addObserver(&encoder);
+	matrix.reset(msm::Dimensions(60, 40, 200), 4711);
+
+	msm::MirrorBoard mirror;
+	mirror.reset(60, 40);
+	std::vector<uint8_t> wire;
+	std::vector<uint32_t> changed;
+
+	for (uint16_t y = 0; y < 40 && matrix.getStatus() != msm::GS_LOST; y += 3)
+		for (uint16_t x = (y * 7) % 5; x < 60; x += 5)
+		{
+			if (x % 4 == 0)
+				matrix.at(x, y).cycleMark();
+			else
+				matrix.reveal(x, y);
+
+			size_t const pending = encoder.getPending();
+			wire.clear();
+			changed.clear();
+			BOOST_CHECK((encoder.flush(wire) != 0) == (pending != 0));
+			BOOST_CHECK(0 == encoder.getPending());
+			if (!wire.empty())
+				BOOST_REQUIRE(mirror.apply(&wire[0], wire.size(), &changed));
+			BOOST_CHECK(changed.size() <= pending);
+			checkSame(matrix, mirror);
+		}
+
+	matrix.removeObserver(&encoder);
+}
+
+BOOST_AUTO_TEST_CASE(last_change_test)
+{
+	msm::DeltaEncoder encoder;
+	encoder.add(5, msm::packCell(msm::FS_MARKED, 0));
+	encoder.add(3, msm::packCell(msm::FS_UNHIDDEN, 2));
+	encoder.add(5, msm::packCell(msm::FS_QUERIED, 0));
+	encoder.add(4, msm::packCell(msm::FS_UNHIDDEN, 8));
+	encoder.add(9, msm::packCell(msm::FS_BOMB, 0));
+
+	std::vector<uint8_t> wire;
+	// Count, runs, two runs of two bytes each, two bytes of symbols
+	BOOST_CHECK(8 == encoder.flush(wire));
+
+	msm::MirrorBoard mirror;
+	mirror.reset(5, 2);
+	std::vector<uint32_t> changed;
+	BOOST_REQUIRE(mirror.apply(&wire[0], wire.size(), &changed));
+	BOOST_CHECK(4 == changed.size());
+	BOOST_CHECK(msm::packCell(msm::FS_UNHIDDEN, 2) == mirror.getCell(3));
+	BOOST_CHECK(msm::packCell(msm::FS_UNHIDDEN, 8) == mirror.getCell(4));
+	BOOST_CHECK(msm::packCell(msm::FS_QUERIED, 0) == mirror.getCell(5));
+	BOOST_CHECK(msm::packCell(msm::FS_BOMB, 0) == mirror.getCell(9));
+	BOOST_CHECK(msm::packCell(msm::FS_HIDDEN, 0) == mirror.getCell(0));
+}
+
+BOOST_AUTO_TEST_CASE(malformed_test)
+{
+	msm::DeltaEncoder encoder;
+	for (uint32_t i = 10; i < 20; ++i)
+		encoder.add(i, msm::packCell(msm::FS_UNHIDDEN, 1));
+	std::vector<uint8_t> wire;
+	encoder.flush(wire);
+
+	msm::MirrorBoard mirror;
+	mirror.reset(4, 5);
+	std::vector<uint8_t> const before = mirror.getCells();
+
+	// Truncated
+	for (size_t size = 0; size < wire.size(); ++size)
+		BOOST_CHECK(!mirror.apply(&wire[0], size));
+	// Too long
+	std::vector<uint8_t> longer(wire);
+	longer.push_back(0);
+	BOOST_CHECK(!mirror.apply(&longer[0], longer.size()));
+	// Invalid symbol
+	std::vector<uint8_t> symbol(wire);
+	symbol.back() = 0xFA;
+	BOOST_CHECK(!mirror.apply(&symbol[0], symbol.size()));
+	BOOST_CHECK(before == mirror.getCells());
+
+	// Doesn't fit the board
+	mirror.reset(4, 4);
+	BOOST_CHECK(!mirror.apply(&wire[0], wire.size()));
+	mirror.reset(4, 5);
+	BOOST_CHECK(mirror.apply(&wire[0], wire.size()));
+}
+
+BOOST_AUTO_TEST_CASE(reset_test)
+{
+	msm::Matrix matrix(msm::Dimensions(10, 10, 10));
+	msm::DeltaEncoder encoder;
+	matrix.addObserver(&encoder);
+
+	matrix.at(1, 1).cycleMark();
+	BOOST_CHECK(1 == encoder.getPending());
+	matrix.reset();
+	BOOST_CHECK(0 == encoder.getPending());
+
+	matrix.removeObserver(&encoder);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,251 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file eventChannel.cpp
+ *
+ * Implementation of \ref eventChannel.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "eventChannel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace msm
+{
+
+namespace
+{
+/// Size of a cache line. Used to keep producer and consumer indices apart.
+const size_t CACHE_LINE = 64;
+
+struct Slot
+{
+	EVENTTYPE type;
+	uint16_t x;
+	uint16_t y;
+	/* The value is the only part of a slot that can be written
+	 * by the producer after the slot was published (coalescing). */
+	std::atomic<int32_t> value;
+};
+
+uint32_t roundUpPow2(uint32_t v)
+{
+	uint32_t p = 1;
+	while (p < v && p < 0x80000000u)
+		p <<= 1;
+	return p;
+}
+}
+
+/*
+ * The ring is indexed by ever increasing sequence numbers. The slot of an event
+ * is seq & mask.
+ * - tail is written by the producer only and marks the next free sequence number.
+ * - head is written by the consumer only after it has copied all events before it.
+ * - claim is written by the consumer right before it starts copying a batch and marks
+ *   the end of that batch. An event with seq >= claim is guaranteed to be read by the
+ *   consumer in the future, so the producer may still update its value.
+ *
+ * The coalescing protocol relies on the total order of sequentially consistent
+ * operations: The producer stores the new value and then checks the claim,
+ * the consumer stores the claim and then loads the values. Either the consumer
+ * sees the new value or the producer sees the claim and pushes a new event.
+ */
+struct EventChannel::Impl
+{
+	Impl(uint32_t capacity, OVERFLOWPOLICY policy, bool coalesce) :
+			capacity(roundUpPow2(std::max<uint32_t>(capacity, 2))), mask(this->capacity - 1), policy(policy), coalesce(
+					coalesce), slots(new Slot[this->capacity]), head(0), claim(0), tail(0), dropped(0), coalesced(0), barrier(
+					0), dimX(0), dimY(0)
+	{
+	}
+	~Impl()
+	{
+		delete[] slots;
+	}
+
+	uint32_t const capacity;
+	uint64_t const mask;
+	OVERFLOWPOLICY const policy;
+	bool const coalesce;
+
+	Slot* slots;
+
+	char pad0[CACHE_LINE];
+
+	// Consumer
+	std::atomic<uint64_t> head;
+	std::atomic<uint64_t> claim;
+
+	char pad1[CACHE_LINE];
+
+	// Producer
+	std::atomic<uint64_t> tail;
+	std::atomic<uint64_t> dropped;
+	std::atomic<uint64_t> coalesced;
+
+	/// Field events before this sequence number must not be coalesced.
+	uint64_t barrier;
+	uint16_t dimX;
+	uint16_t dimY;
+	/// Sequence number + 1 of the last event of each field (0 for none).
+	std::vector<uint64_t> pending;
+
+	bool push(EVENTTYPE type, uint16_t x, uint16_t y, int32_t value, uint64_t& seq);
+	void pushField(Matrix const& matrix, Position const& pos, FIELDSTATUS status);
+	void syncDimensions(Matrix const& matrix);
+};
+
+EventChannel::EventChannel(uint32_t capacity, OVERFLOWPOLICY policy, bool coalesce) :
+		pImpl(new EventChannel::Impl(capacity, policy, coalesce))
+{
+}
+
+EventChannel::~EventChannel()
+{
+	delete pImpl;
+}
+
+size_t EventChannel::drain(Event* buffer, size_t max)
+{
+	uint64_t h = pImpl->head.load(std::memory_order_relaxed);
+	uint64_t t = pImpl->tail.load(std::memory_order_acquire);
+	uint64_t n = std::min<uint64_t>(t - h, max);
+	if (n == 0)
+		return 0;
+
+	pImpl->claim.store(h + n);
+
+	for (uint64_t i = 0; i < n; ++i)
+	{
+		Slot const& slot = pImpl->slots[(h + i) & pImpl->mask];
+		buffer[i].type = slot.type;
+		buffer[i].x = slot.x;
+		buffer[i].y = slot.y;
+		buffer[i].value = slot.value.load();
+	}
+
+	pImpl->head.store(h + n, std::memory_order_release);
+	return n;
+}
+
+uint32_t EventChannel::getCapacity() const
+{
+	return pImpl->capacity;
+}
+
+uint32_t EventChannel::getPending() const
+{
+	return pImpl->tail.load(std::memory_order_acquire) - pImpl->head.load(std::memory_order_acquire);
+}
+
+uint64_t EventChannel::getDropped() const
+{
+	return pImpl->dropped.load(std::memory_order_relaxed);
+}
+
+uint64_t EventChannel::getCoalesced() const
+{
+	return pImpl->coalesced.load(std::memory_order_relaxed);
+}
+
+void EventChannel::onGameStatusChanged(Matrix const&, GAMESTATUS status)
+{
+	uint64_t seq;
+	pImpl->push(ET_GAMESTATUS, 0, 0, status, seq);
+	pImpl->barrier = pImpl->tail.load(std::memory_order_relaxed);
+}
+
+void EventChannel::onRemainingBombsChanged(Matrix const&, int32_t bombs)
+{
+	uint64_t seq;
+	pImpl->push(ET_REMAININGBOMBS, 0, 0, bombs, seq);
+}
+
+void EventChannel::onFieldStatusChanged(Matrix const& matrix, Field const& field, FIELDSTATUS status)
+{
+	pImpl->pushField(matrix, field.getPosition(), status);
+}
+
+void EventChannel::onFieldDelete(Matrix const&, Field const&)
+{
+}
+
+bool EventChannel::Impl::push(EVENTTYPE type, uint16_t x, uint16_t y, int32_t value, uint64_t& seq)
+{
+	uint64_t t = tail.load(std::memory_order_relaxed);
+
+	if (t - head.load(std::memory_order_acquire) >= capacity)
+	{
+		if (policy == OP_DROP)
+		{
+			dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		while (t - head.load(std::memory_order_acquire) >= capacity)
+			std::this_thread::yield();
+	}
+
+	Slot& slot = slots[t & mask];
+	slot.type = type;
+	slot.x = x;
+	slot.y = y;
+	slot.value.store(value, std::memory_order_relaxed);
+
+	tail.store(t + 1, std::memory_order_release);
+	seq = t;
+	return true;
+}
+
+void EventChannel::Impl::pushField(Matrix const& matrix, Position const& pos, FIELDSTATUS status)
+{
+	uint64_t seq;
+
+	if (!coalesce)
+	{
+		push(ET_FIELDSTATUS, pos.X, pos.Y, status, seq);
+		return;
+	}
+
+	syncDimensions(matrix);
+	uint64_t& last = pending[(size_t) pos.Y * dimX + pos.X];
+
+	if (last > barrier)
+	{
+		seq = last - 1;
+		if (seq >= claim.load())
+		{
+			slots[seq & mask].value.store(status);
+			if (seq >= claim.load())
+			{
+				coalesced.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+		}
+	}
+
+	if (push(ET_FIELDSTATUS, pos.X, pos.Y, status, seq))
+		last = seq + 1;
+}
+
+void EventChannel::Impl::syncDimensions(Matrix const& matrix)
+{
+	Dimensions const& d = matrix.getDimensions();
+	if (d.getX() != dimX || d.getY() != dimY)
+	{
+		dimX = d.getX();
+		dimY = d.getY();
+		pending.assign((size_t) dimX * dimY, 0);
+	}
+}
+
+} //namespace msm
+
+///\}
@@ -0,0 +1,122 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file eventChannel.hpp
+ *
+ * Asynchronous delivery of \ref msm::Matrix "matrix" events to a consumer thread.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef EVENTCHANNEL_HPP_
+#define EVENTCHANNEL_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "matrix.hpp"
+
+namespace msm
+{
+
+/// The type of an \ref Event.
+enum EVENTTYPE
+{
+	ET_FIELDSTATUS, //!< A field changed its \ref #FIELDSTATUS "status".
+	ET_GAMESTATUS, //!< The \ref #GAMESTATUS "game status" changed.
+	ET_REMAININGBOMBS //!< The count of remaining bombs changed.
+};
+
+/// What an \ref EventChannel does when the consumer is too slow and the ring is full.
+enum OVERFLOWPOLICY
+{
+	OP_BLOCK, //!< Backpressure: the producing thread waits until the consumer made room.
+	OP_DROP //!< The new event is dropped and counted (see EventChannel::getDropped()).
+};
+
+/**
+ * An event as it is transported through an \ref EventChannel.
+ * Fields are identified by their position because the Field objects itself
+ * may already be deleted by \ref Matrix::reset() when the consumer reads the event.
+ */
+struct Event
+{
+	/// The type of the event.
+	EVENTTYPE type;
+	/// The horizontal position of the field (\ref ET_FIELDSTATUS only).
+	uint16_t x;
+	/// The vertical position of the field (\ref ET_FIELDSTATUS only).
+	uint16_t y;
+	/** The new value: A \ref #FIELDSTATUS "field status", a \ref #GAMESTATUS "game status"
+	 * or the count of remaining bombs, depending on the type. */
+	int32_t value;
+};
+
+/**
+ * A lock-free single-producer single-consumer channel for matrix events.
+ *
+ * Register the channel as \ref MatrixObserver of exactly one matrix. The thread that
+ * manipulates the matrix writes all field, game status and bomb count events into a
+ * ring buffer and returns immediately. A single consumer thread fetches the events in
+ * batches with \ref drain().
+ *
+ * Coalescing: When enabled, a change of a field that has an event pending in the ring
+ * that was not yet fetched by the consumer, overwrites the status of that event instead
+ * of producing a new one. Field events are never coalesced across a game status event,
+ * so the consumer always sees the field changes on the correct side of e.g. a reset.
+ *
+ * \note onFieldDelete() is not forwarded. A \ref ET_GAMESTATUS event with the value
+ * \ref GS_READY signals the consumer that all fields were recreated.
+ */
+class EventChannel: public MatrixObserver
+{
+public:
+	struct Impl;
+
+	/** Constructor.
+	 * \param capacity The count of events the ring can hold. Rounded up to a power of two.
+	 * \param policy What to do if the ring is full.
+	 * \param coalesce Enable coalescing of repeated changes to the same field. */
+	explicit EventChannel(uint32_t capacity, OVERFLOWPOLICY policy = OP_BLOCK, bool coalesce = true);
+	/// Destructor.
+	virtual ~EventChannel();
+
+	/** Fetch pending events. Must only be called by the consumer thread.
+	 * \param buffer Destination for the events.
+	 * \param max The maximal count of events to fetch (size of buffer).
+	 * \return The count of events written into buffer. */
+	size_t drain(Event* buffer, size_t max);
+
+	/// Get the capacity of the ring.
+	uint32_t getCapacity() const;
+	/// Get the count of events that are currently pending.
+	uint32_t getPending() const;
+	/// Get the count of events that were dropped because of a full ring (\ref OP_DROP only).
+	uint64_t getDropped() const;
+	/// Get the count of field events that were merged into a pending event.
+	uint64_t getCoalesced() const;
+
+	/// \internal Producer side.
+	void onGameStatusChanged(Matrix const& matrix, GAMESTATUS status);
+	/// \internal Producer side.
+	void onRemainingBombsChanged(Matrix const& matrix, int32_t bombs);
+	/// \internal Producer side.
+	void onFieldStatusChanged(Matrix const& matrix, Field const& field, FIELDSTATUS status);
+	/// \internal Not forwarded.
+	void onFieldDelete(Matrix const& matrix, Field const& field);
+
+protected:
+	Impl* pImpl;
+
+private:
+	EventChannel(EventChannel const& cp);
+	EventChannel& operator=(EventChannel const& cp);
+};
+
+} //namespace msm
+
+#endif /* EVENTCHANNEL_HPP_ */
+
+///\}
@@ -0,0 +1,129 @@
+/**
+ * @file eventChannel_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "eventChannel.hpp"
+
+namespace
+{
+bool is(msm::Event const& e, msm::EVENTTYPE type, int32_t value)
+{
+	return e.type == type && e.value == value;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(event_channel_test_suite)
+
+BOOST_AUTO_TEST_CASE(order_test)
+{
+	msm::EventChannel channel(16);
+	msm::Matrix matrix;
+	matrix.addObserver(&channel);
+
+	matrix.reset(msm::Dimensions(1, 1, 0));
+	matrix[0][0].reveal();
+
+	msm::Event events[16];
+	BOOST_REQUIRE(3 == channel.drain(events, 16));
+	BOOST_CHECK(is(events[0], msm::ET_GAMESTATUS, msm::GS_READY));
+	BOOST_CHECK(is(events[1], msm::ET_FIELDSTATUS, msm::FS_UNHIDDEN));
+	BOOST_CHECK(events[1].x == 0 && events[1].y == 0);
+	BOOST_CHECK(is(events[2], msm::ET_GAMESTATUS, msm::GS_WON));
+	BOOST_CHECK(0 == channel.drain(events, 16));
+}
+
+BOOST_AUTO_TEST_CASE(coalesce_test)
+{
+	msm::EventChannel channel(16);
+	msm::Matrix matrix;
+	matrix.addObserver(&channel);
+	matrix.reset(msm::Dimensions(2, 1, 0));
+
+	// Marked, Queried, Hidden, Marked
+	for (int i = 0; i < 4; ++i)
+		matrix[1][0].cycleMark();
+
+	msm::Event events[16];
+	BOOST_REQUIRE(7 == channel.drain(events, 16));
+	BOOST_CHECK(is(events[0], msm::ET_GAMESTATUS, msm::GS_READY));
+	BOOST_CHECK(is(events[1], msm::ET_FIELDSTATUS, msm::FS_MARKED));
+	BOOST_CHECK(is(events[2], msm::ET_REMAININGBOMBS, -1));
+	BOOST_CHECK(is(events[3], msm::ET_GAMESTATUS, msm::GS_RUNNING));
+	// Not merged with the first change because of the game status change in between.
+	BOOST_CHECK(is(events[4], msm::ET_FIELDSTATUS, msm::FS_MARKED));
+	BOOST_CHECK(events[4].x == 1 && events[4].y == 0);
+	BOOST_CHECK(is(events[5], msm::ET_REMAININGBOMBS, 0));
+	BOOST_CHECK(is(events[6], msm::ET_REMAININGBOMBS, -1));
+	BOOST_CHECK(2 == channel.getCoalesced());
+
+	// Already fetched events are never modified.
+	matrix[1][0].cycleMark();
+	BOOST_REQUIRE(2 == channel.drain(events, 16));
+	BOOST_CHECK(is(events[0], msm::ET_FIELDSTATUS, msm::FS_QUERIED));
+	BOOST_CHECK(is(events[1], msm::ET_REMAININGBOMBS, 0));
+}
+
+BOOST_AUTO_TEST_CASE(drop_test)
+{
+	msm::EventChannel channel(2, msm::OP_DROP, false);
+	BOOST_REQUIRE(2 == channel.getCapacity());
+
+	msm::Matrix matrix;
+	matrix.addObserver(&channel);
+	matrix.reset(msm::Dimensions(1, 1, 0));
+	matrix[0][0].reveal();
+
+	BOOST_CHECK(2 == channel.getPending());
+	BOOST_CHECK(1 == channel.getDropped());
+
+	msm::Event events[2];
+	BOOST_REQUIRE(2 == channel.drain(events, 2));
+	BOOST_CHECK(is(events[0], msm::ET_GAMESTATUS, msm::GS_READY));
+	BOOST_CHECK(is(events[1], msm::ET_FIELDSTATUS, msm::FS_UNHIDDEN));
+}
+
+BOOST_AUTO_TEST_CASE(consumer_thread_test)
+{
+	const uint16_t size = 40;
+	msm::EventChannel channel(8, msm::OP_BLOCK);
+	std::vector<int32_t> mirror(size * size, msm::FS_HIDDEN);
+
+	std::thread consumer([&]()
+	{
+		msm::Event events[4];
+		bool done = false;
+		while (!done)
+		{
+			size_t n = channel.drain(events, 4);
+			for (size_t i = 0; i < n; ++i)
+			{
+				if (events[i].type == msm::ET_FIELDSTATUS)
+					mirror[events[i].y * size + events[i].x] = events[i].value;
+				else if (events[i].type == msm::ET_GAMESTATUS && events[i].value == msm::GS_WON)
+					done = true;
+			}
+			if (n == 0)
+				std::this_thread::yield();
+		}
+	});
+
+	msm::Matrix matrix;
+	matrix.addObserver(&channel);
+	matrix.reset(msm::Dimensions(size, size, 0));
+	matrix[size / 2][size / 2].reveal();
+	consumer.join();
+
+	BOOST_CHECK(0 == channel.getDropped());
+	BOOST_CHECK(std::count(mirror.begin(), mirror.end(), (int32_t) msm::FS_UNHIDDEN) == size * size);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -14,17 +14,19 @@
 
 #include <algorithm>
 
+#include "grid.hpp"
+#include "memory.hpp"
 #include "tools.hpp"
 
 namespace msm
 {
 
 #define SIGNAL_FIELDSTATUSCHANGED(field, status) do{ \
-		for (std::list<FieldObserver*>::const_iterator it = pImpl->observers.begin(); it != pImpl->observers.end(); ++it) { \
+		for (Field::Impl::Observers::const_iterator it = pImpl->observers.begin(); it != pImpl->observers.end(); ++it) { \
 			(*it)->onFieldStatusChanged(field, status); } \
 		} while(0)
 #define SIGNAL_FIELDDELETE(field) do{ \
-		for (std::list<FieldObserver*>::const_iterator it = pImpl->observers.begin(); it != pImpl->observers.end(); ++it) { \
+		for (Field::Impl::Observers::const_iterator it = pImpl->observers.begin(); it != pImpl->observers.end(); ++it) { \
 			(*it)->onFieldDelete(field); } \
 		} while(0)
 
@@ -36,9 +38,27 @@ char const* FS_NAMES[] =
 
 struct Field::Impl
 {
-	Impl(Position p) :
-			pos(p), status(FS_HIDDEN), adjacentBombs(0), neighbours(0)
+	typedef std::list<FieldObserver*, ResourceAllocator<FieldObserver*> > Observers;
+
+	Impl(Position p, MemoryResource* resource) :
+			pos(p), status(FS_HIDDEN), adjacentBombs(0), grid(0), resource(resource), observers(
+					ResourceAllocator<FieldObserver*>(resource))
+	{
+	}
+
+	/// Create an instance from a resource.
+	static Impl* create(Position const& p, MemoryResource* resource)
+	{
+		if (!resource)
+			resource = newDeleteResource();
+		return new (resource->allocate(sizeof(Impl), alignof(Impl))) Impl(p, resource);
+	}
+	/// Destroy an instance and give its memory back.
+	static void destroy(Impl* impl)
 	{
+		MemoryResource* resource = impl->resource;
+		impl->~Impl();
+		resource->deallocate(impl, sizeof(Impl), alignof(Impl));
 	}
 	virtual ~Impl()
 	{
@@ -49,10 +69,12 @@ struct Field::Impl
 
 	uint8_t adjacentBombs;
 
-	//TODO: Use a fixed size map or a simple array!
-	std::vector<Field*> neighbours;
+	/// Provides the neighbours
+	Grid const* grid;
+
+	MemoryResource* resource;
 
-	std::list<FieldObserver*> observers;
+	Observers observers;
 };
 
 char const* toString(FIELDSTATUS fs)
@@ -64,19 +86,24 @@ char const* toString(FIELDSTATUS fs)
 }
 
 Field::Field(Position const& position) :
-		pImpl(new Field::Impl(position))
+		pImpl(Field::Impl::create(position, 0))
 {
 }
 
 Field::Field(uint16_t x, uint16_t y) :
-		pImpl(new Field::Impl(Position(x, y)))
+		pImpl(Field::Impl::create(Position(x, y), 0))
+{
+}
+
+Field::Field(Position const& position, MemoryResource* resource) :
+		pImpl(Field::Impl::create(position, resource))
 {
 }
 
 Field::~Field()
 {
 	SIGNAL_FIELDDELETE(*this);
-	delete pImpl;
+	Field::Impl::destroy(pImpl);
 }
 
 void Field::addObserver(FieldObserver* o)
@@ -88,7 +115,7 @@ void Field::addObserver(FieldObserver* o)
 
 void Field::removeObserver(FieldObserver* o)
 {
-	std::remove_if(pImpl->observers.begin(), pImpl->observers.end(), compare_address<FieldObserver>(o));
+	pImpl->observers.remove_if(compare_address<FieldObserver>(o));
 }
 
 Position const& Field::getPosition() const
@@ -101,14 +128,9 @@ FIELDSTATUS Field::getStatus() const
 	return pImpl->status;
 }
 
-void Field::addNeighbour(Field* field)
+void Field::setGrid(Grid const* grid)
 {
-	pImpl->neighbours.push_back(field);
-}
-
-void Field::clearNeighbours()
-{
-	pImpl->neighbours.clear();
+	pImpl->grid = grid;
 }
 
 void Field::incAdjacentBombs()
@@ -117,6 +139,11 @@ void Field::incAdjacentBombs()
 	pImpl->adjacentBombs++;
 }
 
+void Field::setAdjacentBombs(uint8_t count)
+{
+	pImpl->adjacentBombs = count;
+}
+
 uint8_t Field::getAdjacentBombs() const
 {
 	return pImpl->adjacentBombs;
@@ -124,25 +151,26 @@ uint8_t Field::getAdjacentBombs() const
 
 uint8_t Field::reveal()
 {
-	if (pImpl->status != FS_MARKED && pImpl->status != FS_UNHIDDEN)
-	{
-		pImpl->status = FS_UNHIDDEN;
-
-		SIGNAL_FIELDSTATUSCHANGED(*this, FS_UNHIDDEN);
-
-		if (pImpl->adjacentBombs == 0)
-		{
-			std::vector<Field*>::iterator it;
-			for (it = pImpl->neighbours.begin(); it != pImpl->neighbours.end(); it++)
-			{
-				(*it)->reveal();
-			}
-		}
-	}
+	/* Depth first like a recursion over the neighbours, but without
+	 * the risk of a stack overflow on large empty areas. */
+	if (open() && pImpl->grid)
+		pImpl->grid->cascade(*this);
 
 	return pImpl->adjacentBombs;
 }
 
+bool Field::open()
+{
+	if (pImpl->status == FS_MARKED || pImpl->status == FS_UNHIDDEN)
+		return false;
+
+	pImpl->status = FS_UNHIDDEN;
+
+	SIGNAL_FIELDSTATUSCHANGED(*this, FS_UNHIDDEN);
+
+	return pImpl->adjacentBombs == 0;
+}
+
 void Field::cycleMark()
 {
 	FIELDSTATUS old = pImpl->status;
@@ -180,25 +208,43 @@ Bomb::Bomb(uint16_t x, uint16_t y) :
 {
 }
 
+Bomb::Bomb(Position const& position, MemoryResource* resource) :
+		Field(position, resource)
+{
+}
+
 Bomb::~Bomb()
 {
 }
 
 void Bomb::informNeighbours()
 {
-	std::vector<Field*>::iterator it;
-	for (it = pImpl->neighbours.begin(); it != pImpl->neighbours.end(); it++)
-		(*it)->incAdjacentBombs();
+	if (!pImpl->grid)
+		return;
+
+	std::vector<Field*> neighbours;
+	pImpl->grid->pushNeighbours(neighbours, *this);
+	for (std::vector<Field*>::iterator it = neighbours.begin(); it != neighbours.end(); it++)
+	{
+		if (*it != Grid::border())
+			(*it)->incAdjacentBombs();
+	}
 }
 
 uint8_t Bomb::reveal()
+{
+	open();
+	return FS_BOMB;
+}
+
+bool Bomb::open()
 {
 	if (pImpl->status != FS_MARKED && pImpl->status != FS_BOMB && pImpl->status != FS_UNHIDDEN)
 	{
 		pImpl->status = FS_BOMB;
 		SIGNAL_FIELDSTATUSCHANGED(*this, FS_BOMB);
 	}
-	return FS_BOMB;
+	return false;
 }
 
 } //namespace msm
@@ -55,6 +55,8 @@ struct Position
 };
 
 class Field;
+class Grid;
+class MemoryResource;
 
 /// Interface for Field observers
 struct FieldObserver
@@ -93,6 +95,10 @@ public:
 	 * \param x The horizontal position.
 	 * \param y The vertical position. */
 	Field(uint16_t x, uint16_t y);
+	/** Constructor.
+	 * \param position The position of the field in the matrix.
+	 * \param resource The source of the internal allocations. Must outlive the field. */
+	Field(Position const& position, MemoryResource* resource);
 	/// Destructor.
 	virtual ~Field();
 
@@ -107,12 +113,13 @@ public:
 	Position const& getPosition() const;
 	/// Get the current \ref FIELDSTATUS "status" of the field.
 	FIELDSTATUS getStatus() const;
-	/// \internal Add a adjacent field into the vector for neighbours.
-	void addNeighbour(Field* field);
-	/// \internal Clear neighbours.
-	void clearNeighbours();
+	/** \internal Set the grid that provides the neighbours.
+	 * A field without a grid has no neighbours. */
+	void setGrid(Grid const* grid);
 	/// \internal Increment the count of adjacent bombs.
 	void incAdjacentBombs();
+	/// \internal Set the count of adjacent bombs.
+	void setAdjacentBombs(uint8_t count);
 	///Get the count of adjacent bombs.
 	uint8_t getAdjacentBombs() const;
 	/** Cycle through the the three states:
@@ -128,6 +135,11 @@ public:
 	 * and not marked 1 and are also revealed.
 	 * \return The count of adjacent bombs. */
 	virtual uint8_t reveal();
+	/** \internal Reveal only this field, without the cascade.
+	 * The status is changed and the signal is emitted, if the field is neither
+	 * marked nor already revealed.
+	 * \return True if the neighbours have to be revealed too. */
+	virtual bool open();
 
 protected:
 	Impl* pImpl;
@@ -144,6 +156,10 @@ public:
 	 * \param x The horizontal position.
 	 * \param y The vertical position. */
 	Bomb(uint16_t x, uint16_t y);
+	/** Constructor.
+	 * \param position The position of the bomb in the matrix.
+	 * \param resource The source of the internal allocations. Must outlive the bomb. */
+	Bomb(Position const& position, MemoryResource* resource);
 	/// Destructor.
 	virtual ~Bomb();
 	/// Inform neighbours about the bomb status.
@@ -151,6 +167,9 @@ public:
 	/** Reveal the bomb.
 	 * \return \ref FS_BOMB "bomb status". */
 	uint8_t reveal();
+	/** \internal Reveal the bomb.
+	 * \return Always false. */
+	bool open();
 };
 
 } //namespace msm
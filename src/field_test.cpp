@@ -8,6 +8,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "field.hpp"
+#include "grid.hpp"
 
 struct Fix_field_test: public msm::FieldObserver
 {
@@ -26,21 +27,10 @@ struct Fix_field_test: public msm::FieldObserver
 		y[0] = new msm::Field(0, 1);
 		y[1] = new msm::Bomb(1, 1);
 
-		x[0]->addNeighbour(x[1]);
-		x[0]->addNeighbour(y[0]);
-		x[0]->addNeighbour(y[1]);
-
-		x[1]->addNeighbour(x[0]);
-		x[1]->addNeighbour(y[0]);
-		x[1]->addNeighbour(y[1]);
-
-		y[0]->addNeighbour(x[0]);
-		y[0]->addNeighbour(x[1]);
-		y[0]->addNeighbour(y[1]);
-
-		y[1]->addNeighbour(x[0]);
-		y[1]->addNeighbour(x[1]);
-		y[1]->addNeighbour(y[0]);
+		msm::Field* cells[] = { x[0], x[1], y[0], y[1] };
+		grid.build(cells, 2, 2, msm::TP_PLANE);
+		for (int i = 0; i < 4; ++i)
+			cells[i]->setGrid(&grid);
 
 		y[1]->informNeighbours();
 
@@ -65,6 +55,7 @@ struct Fix_field_test: public msm::FieldObserver
 	{
 	}
 
+	msm::Grid grid;
 	msm::Field* x[2];
 	msm::Field* y[2];
 
@@ -0,0 +1,402 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file fixedBoard.hpp
+ *
+ * Boards with a size fixed at compile time for the standard difficulties.
+ *
+ * A \ref msm::FixedBoard "fixed board" keeps its whole state inline: One bit per field
+ * in a few words for the bombs, the revealed, the marked and the queried fields. It never
+ * allocates, so it can live on the stack or in a pool of games. The fields are stored
+ * with a border of one field, the offsets of the eight neighbours are compile-time
+ * constants and the loops over them are unrolled. The adjacent bombs are counted on
+ * reset into half a byte per field by adding each bomb to its neighbours.
+ *
+ * \code
+ * msm::ExpertBoard board;
+ * board.reset(seed);
+ * board.reveal(15, 8);
+ * \endcode
+ *
+ * The boards produce the same layout and the same game as
+ * Matrix::reset(Dimensions(W, H, BOMBS), seed). They inform \ref msm::FixedBoardObserver
+ * "observers" about the same events as a \ref msm::MatrixObserver "matrix observer".
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef FIXEDBOARD_HPP_
+#define FIXEDBOARD_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <array>
+
+#include "generator.hpp"
+#include "matrix.hpp"
+
+namespace msm
+{
+
+/// The count of observers a \ref FixedBoard can hold.
+const unsigned FIXED_OBSERVERS = 4;
+
+/**
+ * Interface for observers of a \ref FixedBoard.
+ * The same events as \ref MatrixObserver, but the fields are identified by their position.
+ */
+struct FixedBoardObserver
+{
+	virtual ~FixedBoardObserver()
+	{
+	}
+	/// Called after the \ref #GAMESTATUS "status" of the game has changed.
+	virtual void onGameStatusChanged(GAMESTATUS status) = 0;
+	/// Called after a field was marked or unmarked. The count can be negative.
+	virtual void onRemainingBombsChanged(int32_t bombs) = 0;
+	/// Called after a field has changed its \ref #FIELDSTATUS "status".
+	virtual void onFieldStatusChanged(uint16_t x, uint16_t y, FIELDSTATUS status) = 0;
+};
+
+/**
+ * A board of W x H fields with BOMBS bombs.
+ * \note The positions are not checked, accessing a position outside of the board is
+ * undefined behaviour.
+ * \tparam W The count of columns.
+ * \tparam H The count of rows.
+ * \tparam BOMBS The count of bombs.
+ */
+template<uint16_t W, uint16_t H, uint32_t BOMBS>
+class FixedBoard
+{
+	static_assert(H <= BAND_ROWS, "The layout of Matrix::reset() is only reproduced for a single band");
+	static_assert((uint32_t) W * H < 65536 && BOMBS <= (uint32_t) W * H, "Invalid size");
+
+public:
+	/// The count of fields.
+	static const uint32_t SIZE = (uint32_t) W * H;
+
+	/// Create a board in the \ref GS_READY "ready" state without bombs. Call \ref reset().
+	FixedBoard() :
+			observerCount(0)
+	{
+		clear();
+	}
+
+	/** Register an observer.
+	 * \param observer An Observer.
+	 * \return False if already \ref FIXED_OBSERVERS observers are registered. */
+	bool addObserver(FixedBoardObserver* observer)
+	{
+		for (unsigned i = 0; i < observerCount; ++i)
+			if (observers[i] == observer)
+				return true;
+		if (observerCount == FIXED_OBSERVERS)
+			return false;
+		observers[observerCount++] = observer;
+		return true;
+	}
+	/** Remove an observer.
+	 * \param observer An Observer. */
+	void removeObserver(FixedBoardObserver* observer)
+	{
+		for (unsigned i = 0; i < observerCount; ++i)
+			if (observers[i] == observer)
+			{
+				observers[i] = observers[--observerCount];
+				return;
+			}
+	}
+
+	/** Start a new game with the layout of Matrix::reset(Dimensions(W, H, BOMBS), seed).
+	 * \param seed The seed for the bomb placement. */
+	void reset(uint32_t seed)
+	{
+		clear();
+
+		// The first band of placeBombs() gets all bombs
+		placeInBand(seed, 0, SIZE, BOMBS, [this](uint32_t i)
+		{
+			uint32_t const p = pad(i);
+			setBit(bombBits, p);
+			for (unsigned n = 0; n < 8; ++n)
+			{
+				uint32_t const q = p + OFFSETS[n];
+				adjacentNibbles[q >> 1] += 1 << ((q & 1) << 2);
+			}
+		});
+
+		for (unsigned i = 0; i < observerCount; ++i)
+			observers[i]->onGameStatusChanged(status);
+	}
+	/// Start a new game with a random layout.
+	void reset()
+	{
+		reset(randomSeed());
+	}
+
+	/// Get the \ref Dimensions.
+	static Dimensions getDimensions()
+	{
+		return Dimensions(W, H, BOMBS);
+	}
+	/// Get the \ref #GAMESTATUS "game status".
+	GAMESTATUS getStatus() const
+	{
+		return status;
+	}
+	/// Get the remaining bomb count.
+	int32_t getRemainingBombs() const
+	{
+		return (int32_t) BOMBS - (int32_t) marked;
+	}
+	/// Get the count of revealed fields.
+	uint32_t getUnhidden() const
+	{
+		return unhidden;
+	}
+
+	/// Get the \ref #FIELDSTATUS "status" of a field.
+	FIELDSTATUS getFieldStatus(uint16_t x, uint16_t y) const
+	{
+		return fieldStatus(pad(x, y));
+	}
+	/// Get the count of adjacent bombs of a revealed field. 0 for all other fields.
+	uint8_t getAdjacentBombs(uint16_t x, uint16_t y) const
+	{
+		uint32_t const p = pad(x, y);
+		return testBit(revealedBits, p) && !testBit(bombBits, p) ? adjacent(p) : 0;
+	}
+
+	/** Reveal a field with the same result as Matrix::reveal().
+	 * \return The count of adjacent bombs or \ref FS_BOMB "bomb status". */
+	uint8_t reveal(uint16_t x, uint16_t y)
+	{
+		uint32_t const p = pad(x, y);
+		GAMESTATUS const old = status;
+		if (testBit(bombBits, p))
+		{
+			if (!testBit(markedBits, p) && !testBit(revealedBits, p))
+			{
+				setBit(revealedBits, p);
+				clearBit(queriedBits, p);
+				status = GS_LOST;
+				notify(p, FS_BOMB);
+				notify(old);
+			}
+			return FS_BOMB;
+		}
+
+		uint8_t const bombsAround = adjacent(p);
+		if (testBit(markedBits, p) || testBit(revealedBits, p))
+			return bombsAround;
+
+		// Depth first, each field is revealed when it is pushed, so it is pushed once
+		uint16_t stack[SIZE];
+		uint32_t top = 0;
+		open(p);
+		stack[top++] = (uint16_t) p;
+		while (top)
+		{
+			uint32_t const q = stack[--top];
+			if (adjacent(q))
+				continue;
+			for (unsigned n = 0; n < 8; ++n)
+			{
+				uint32_t const r = q + OFFSETS[n];
+				if (!testBit(revealedBits, r) && !testBit(markedBits, r))
+				{
+					open(r);
+					stack[top++] = (uint16_t) r;
+				}
+			}
+		}
+
+		update();
+		notify(old);
+		return bombsAround;
+	}
+
+	/// Cycle the mark of a field like Field::cycleMark().
+	void cycleMark(uint16_t x, uint16_t y)
+	{
+		uint32_t const p = pad(x, y);
+		if (testBit(revealedBits, p))
+			return;
+
+		GAMESTATUS const old = status;
+		FIELDSTATUS next;
+		if (testBit(markedBits, p))
+		{
+			clearBit(markedBits, p);
+			setBit(queriedBits, p);
+			--marked;
+			next = FS_QUERIED;
+		}
+		else if (testBit(queriedBits, p))
+		{
+			clearBit(queriedBits, p);
+			next = FS_HIDDEN;
+		}
+		else
+		{
+			setBit(markedBits, p);
+			++marked;
+			next = FS_MARKED;
+		}
+
+		update();
+		notify(p, next);
+		if (next != FS_HIDDEN)
+		{
+			for (unsigned i = 0; i < observerCount; ++i)
+				observers[i]->onRemainingBombsChanged(getRemainingBombs());
+		}
+		notify(old);
+	}
+
+private:
+	/// The width of the padded storage.
+	static const uint32_t STRIDE = W + 2;
+	/// The count of words of a bit set of the padded storage.
+	static const uint32_t WORDS = (STRIDE * (H + 2) + 63) / 64;
+	static constexpr int32_t OFFSETS[8] = { -(int32_t) STRIDE - 1, -(int32_t) STRIDE, -(int32_t) STRIDE + 1, -1, 1,
+			(int32_t) STRIDE - 1, (int32_t) STRIDE, (int32_t) STRIDE + 1 };
+
+	typedef std::array<uint64_t, WORDS> Bits;
+
+	Bits bombBits;
+	/// The adjacent bombs of each field of the padded storage, two fields per byte.
+	std::array<uint8_t, (STRIDE * (H + 2) + 1) / 2> adjacentNibbles;
+	/// The revealed fields (bombs too) and the border.
+	Bits revealedBits;
+	Bits markedBits;
+	Bits queriedBits;
+
+	GAMESTATUS status;
+	uint32_t unhidden;
+	uint32_t marked;
+
+	std::array<FixedBoardObserver*, FIXED_OBSERVERS> observers;
+	unsigned observerCount;
+
+	static bool testBit(Bits const& bits, uint32_t p)
+	{
+		return (bits[p >> 6] >> (p & 63)) & 1;
+	}
+	static void setBit(Bits& bits, uint32_t p)
+	{
+		bits[p >> 6] |= 1ull << (p & 63);
+	}
+	static void clearBit(Bits& bits, uint32_t p)
+	{
+		bits[p >> 6] &= ~(1ull << (p & 63));
+	}
+	static uint32_t pad(uint16_t x, uint16_t y)
+	{
+		return (uint32_t) (y + 1) * STRIDE + x + 1;
+	}
+	static uint32_t pad(uint32_t index)
+	{
+		return pad(index % W, index / W);
+	}
+
+	/// The border as revealed fields.
+	static Bits const& border()
+	{
+		static Bits const bits = []()
+		{
+			Bits b;
+			b.fill(0);
+			for (uint32_t x = 0; x < STRIDE; ++x)
+			{
+				setBit(b, x);
+				setBit(b, (H + 1) * STRIDE + x);
+			}
+			for (uint32_t y = 1; y <= H; ++y)
+			{
+				setBit(b, y * STRIDE);
+				setBit(b, y * STRIDE + W + 1);
+			}
+			return b;
+		}();
+		return bits;
+	}
+
+	void clear()
+	{
+		bombBits.fill(0);
+		adjacentNibbles.fill(0);
+		revealedBits = border();
+		markedBits.fill(0);
+		queriedBits.fill(0);
+		status = GS_READY;
+		unhidden = 0;
+		marked = 0;
+	}
+
+	uint8_t adjacent(uint32_t p) const
+	{
+		return (adjacentNibbles[p >> 1] >> ((p & 1) << 2)) & 0xF;
+	}
+
+	FIELDSTATUS fieldStatus(uint32_t p) const
+	{
+		if (testBit(revealedBits, p))
+			return testBit(bombBits, p) ? FS_BOMB : FS_UNHIDDEN;
+		if (testBit(markedBits, p))
+			return FS_MARKED;
+		return testBit(queriedBits, p) ? FS_QUERIED : FS_HIDDEN;
+	}
+
+	void open(uint32_t p)
+	{
+		setBit(revealedBits, p);
+		clearBit(queriedBits, p);
+		++unhidden;
+		notify(p, FS_UNHIDDEN);
+	}
+
+	void update()
+	{
+		// Same rule as the Matrix
+		if (status != GS_LOST)
+		{
+			if (unhidden == SIZE - BOMBS && marked == BOMBS)
+				status = GS_WON;
+			else
+				status = GS_RUNNING;
+		}
+	}
+
+	void notify(uint32_t p, FIELDSTATUS s)
+	{
+		for (unsigned i = 0; i < observerCount; ++i)
+			observers[i]->onFieldStatusChanged(p % STRIDE - 1, p / STRIDE - 1, s);
+	}
+	void notify(GAMESTATUS old)
+	{
+		if (status == old)
+			return;
+		for (unsigned i = 0; i < observerCount; ++i)
+			observers[i]->onGameStatusChanged(status);
+	}
+};
+
+template<uint16_t W, uint16_t H, uint32_t BOMBS>
+constexpr int32_t FixedBoard<W, H, BOMBS>::OFFSETS[8];
+
+/// The beginner preset: 9 x 9 fields with 10 bombs.
+typedef FixedBoard<9, 9, 10> BeginnerBoard;
+/// The intermediate preset: 16 x 16 fields with 40 bombs.
+typedef FixedBoard<16, 16, 40> IntermediateBoard;
+/// The expert preset: 30 x 16 fields with 99 bombs.
+typedef FixedBoard<30, 16, 99> ExpertBoard;
+
+} // namespace msm
+
+#endif /* FIXEDBOARD_HPP_ */
+
+///\}
@@ -0,0 +1,150 @@
+/**
+ * @file fixedBoard_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <type_traits>
+#include <vector>
+
+#include "fixedBoard.hpp"
+
+namespace
+{
+/// Counts the events.
+struct Counter: public msm::FixedBoardObserver
+{
+	Counter() :
+			games(0), bombs(0), fields(0), lastStatus(msm::GS_READY), lastBombs(0)
+	{
+	}
+	void onGameStatusChanged(msm::GAMESTATUS status)
+	{
+		++games;
+		lastStatus = status;
+	}
+	void onRemainingBombsChanged(int32_t remaining)
+	{
+		++bombs;
+		lastBombs = remaining;
+	}
+	void onFieldStatusChanged(uint16_t, uint16_t, msm::FIELDSTATUS)
+	{
+		++fields;
+	}
+	int games;
+	int bombs;
+	int fields;
+	msm::GAMESTATUS lastStatus;
+	int32_t lastBombs;
+};
+
+/// Play the same moves on a fixed board and a matrix.
+template<typename Board>
+void compare(uint32_t seed)
+{
+	msm::Dimensions const d = Board::getDimensions();
+	msm::Matrix matrix;
+	matrix.reset(d, seed);
+	Board board;
+	board.reset(seed);
+
+	for (uint16_t y = 0; y < d.getY(); ++y)
+		for (uint16_t x = (y * 5) % 7; x < d.getX(); x += 7)
+		{
+			if ((x + y) % 4 == 0)
+			{
+				matrix.at(x, y).cycleMark();
+				board.cycleMark(x, y);
+			}
+			else if (!dynamic_cast<msm::Bomb const*>(&matrix.at(x, y)))
+				BOOST_CHECK(matrix.reveal(x, y) == board.reveal(x, y));
+		}
+
+	BOOST_CHECK(matrix.getStatus() == board.getStatus());
+	BOOST_CHECK(matrix.getRemainingBombs() == board.getRemainingBombs());
+	for (uint16_t y = 0; y < d.getY(); ++y)
+		for (uint16_t x = 0; x < d.getX(); ++x)
+		{
+			msm::Field const& f = matrix.at(x, y);
+			BOOST_CHECK(f.getStatus() == board.getFieldStatus(x, y));
+			if (f.getStatus() == msm::FS_UNHIDDEN)
+				BOOST_CHECK(f.getAdjacentBombs() == board.getAdjacentBombs(x, y));
+		}
+
+	// The same bombs
+	board.reset(seed);
+	for (uint16_t y = 0; y < d.getY(); ++y)
+		for (uint16_t x = 0; x < d.getX(); ++x)
+		{
+			board.reveal(x, y);
+			BOOST_CHECK((board.getFieldStatus(x, y) == msm::FS_BOMB) == (dynamic_cast<msm::Bomb const*>(&matrix.at(x, y)) != 0));
+		}
+}
+}
+
+BOOST_AUTO_TEST_SUITE(fixedBoard_test_suite)
+
+BOOST_AUTO_TEST_CASE(matrix_test)
+{
+	for (uint32_t seed = 1; seed < 4; ++seed)
+	{
+		compare<msm::BeginnerBoard>(seed);
+		compare<msm::IntermediateBoard>(seed);
+		compare<msm::ExpertBoard>(seed);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(inline_test)
+{
+	// The whole state is a plain value in a few cache lines, nothing on the heap
+	BOOST_CHECK(std::is_trivially_copyable<msm::ExpertBoard>::value);
+	BOOST_CHECK(sizeof(msm::ExpertBoard) <= 1024);
+
+	msm::BeginnerBoard a;
+	a.reset(7);
+	msm::BeginnerBoard b = a;
+	a.cycleMark(0, 0);
+	BOOST_CHECK(msm::FS_MARKED == a.getFieldStatus(0, 0));
+	BOOST_CHECK(msm::FS_HIDDEN == b.getFieldStatus(0, 0));
+}
+
+BOOST_AUTO_TEST_CASE(observer_test)
+{
+	msm::BeginnerBoard board;
+	Counter counter;
+	BOOST_CHECK(board.addObserver(&counter));
+	BOOST_CHECK(board.addObserver(&counter));
+	board.reset(3);
+	BOOST_CHECK(1 == counter.games);
+	BOOST_CHECK(msm::GS_READY == counter.lastStatus);
+
+	board.cycleMark(4, 4);
+	BOOST_CHECK(1 == counter.fields);
+	BOOST_CHECK(1 == counter.bombs);
+	BOOST_CHECK(9 == counter.lastBombs);
+	BOOST_CHECK(2 == counter.games);
+	BOOST_CHECK(msm::GS_RUNNING == counter.lastStatus);
+
+	// One event per revealed field, revealed fields can't be marked
+	board.cycleMark(4, 4);
+	board.cycleMark(4, 4);
+	int const before = counter.fields;
+	for (uint16_t y = 0; y < 9; ++y)
+		for (uint16_t x = 0; x < 9; ++x)
+			if (board.getFieldStatus(x, y) == msm::FS_HIDDEN && board.reveal(x, y) == msm::FS_BOMB)
+				board.cycleMark(x, y);
+	BOOST_CHECK(81 == counter.fields - before);
+	BOOST_CHECK(71 == board.getUnhidden());
+	BOOST_CHECK(msm::GS_LOST == counter.lastStatus);
+
+	board.removeObserver(&counter);
+	board.reset(3);
+	BOOST_CHECK(msm::GS_READY == board.getStatus());
+	BOOST_CHECK(msm::GS_LOST == counter.lastStatus);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,297 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file generator.cpp
+ *
+ * Implementation of \ref generator.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "generator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace msm
+{
+
+namespace
+{
+uint64_t splitmix64(uint64_t& x)
+{
+	uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+double logChoose(double n, double k)
+{
+	return std::lgamma(n + 1) - std::lgamma(k + 1) - std::lgamma(n - k + 1);
+}
+
+/// Count of fields per leaf of the tree of placeWeightedBombs().
+uint32_t const WEIGHT_BLOCK = 64;
+}
+
+Random::Random(uint64_t seed, uint64_t stream)
+{
+	uint64_t x = seed ^ (stream * 0xD1B54A32D192ED03ull);
+	for (int i = 0; i < 4; ++i)
+		s[i] = splitmix64(x);
+}
+
+uint32_t hypergeometric(uint32_t N, uint32_t K, uint32_t n, Random& random)
+{
+	if (n >= N)
+		return K;
+	if (K == 0 || n == 0)
+		return 0;
+	if (K == N)
+		return n;
+
+	uint32_t const lo = (n + K > N) ? n + K - N : 0;
+	uint32_t const hi = std::min(n, K);
+
+	// Inversion, starting at the mode and walking outwards.
+	uint32_t mode = (uint32_t) (((double) n + 1) * ((double) K + 1) / ((double) N + 2));
+	mode = std::max(lo, std::min(hi, mode));
+
+	double const pMode = std::exp(
+			logChoose(K, mode) + logChoose((double) N - K, (double) n - mode) - logChoose(N, n));
+
+	double u = random.uniform() - pMode;
+	if (u < 0)
+		return mode;
+
+	uint32_t l = mode, r = mode;
+	double pl = pMode, pr = pMode;
+	double const dN = N, dK = K, dn = n;
+
+	while (l > lo || r < hi)
+	{
+		if (r < hi)
+		{
+			double k = r;
+			pr *= (dK - k) * (dn - k) / ((k + 1) * (dN - dK - dn + k + 1));
+			++r;
+			u -= pr;
+			if (u < 0)
+				return r;
+		}
+		if (l > lo)
+		{
+			double k = l;
+			pl *= k * (dN - dK - dn + k) / ((dK - k + 1) * (dn - k + 1));
+			--l;
+			u -= pl;
+			if (u < 0)
+				return l;
+		}
+	}
+
+	// Rounding errors only.
+	return mode;
+}
+
+void placeBombs(Dimensions const& dimensions, uint32_t seed, uint8_t* bombs, ThreadPool* pool)
+{
+	uint32_t const cols = dimensions.getX();
+	uint32_t const rows = dimensions.getY();
+	uint32_t const bands = (rows + BAND_ROWS - 1) / BAND_ROWS;
+
+	// The count of bombs of each band (stream 0)
+	std::vector<uint32_t> counts(bands);
+	Random master(seed, 0);
+	uint32_t remainingFields = cols * rows;
+	uint32_t remainingBombs = dimensions.getBombs();
+	for (uint32_t b = 0; b < bands; ++b)
+	{
+		uint32_t size = cols * std::min<uint32_t>(BAND_ROWS, rows - b * BAND_ROWS);
+		counts[b] = hypergeometric(remainingFields, remainingBombs, size, master);
+		remainingFields -= size;
+		remainingBombs -= counts[b];
+	}
+
+	// The bombs of each band (stream b + 1)
+	ThreadPool::Task task = [&](size_t b, unsigned)
+	{
+		uint32_t first = b * BAND_ROWS;
+		uint32_t size = cols * std::min<uint32_t>(BAND_ROWS, rows - first);
+		uint8_t* fields = bombs + (size_t) first * cols;
+		std::memset(fields, 0, size);
+		placeInBand(seed, b, size, counts[b], [fields](uint32_t i)
+		{
+			fields[i] = 1;
+		});
+	};
+
+	if (pool)
+		pool->run(bands, task);
+	else
+	{
+		for (uint32_t b = 0; b < bands; ++b)
+			task(b, 0);
+	}
+}
+
+WeightMap::WeightMap(uint16_t cols, uint16_t rows, float weight) :
+		cols(cols), rows(rows), weights((size_t) cols * rows, weight)
+{
+}
+
+void WeightMap::fill(uint16_t x, uint16_t y, uint16_t width, uint16_t height, float weight)
+{
+	uint32_t const right = std::min<uint32_t>((uint32_t) x + width, cols);
+	uint32_t const bottom = std::min<uint32_t>((uint32_t) y + height, rows);
+	for (uint32_t r = y; r < bottom; ++r)
+		for (uint32_t c = x; c < right; ++c)
+			weights[(size_t) r * cols + c] = weight;
+}
+
+void WeightMap::addCluster(uint16_t x, uint16_t y, float radius, float weight)
+{
+	if (!(radius > 0))
+		return;
+	int32_t const reach = (int32_t) std::ceil(3 * radius);
+	int32_t const top = std::max<int32_t>(0, y - reach);
+	int32_t const bottom = std::min<int32_t>(rows - 1, y + reach);
+	int32_t const left = std::max<int32_t>(0, x - reach);
+	int32_t const right = std::min<int32_t>(cols - 1, x + reach);
+	float const scale = -1 / (2 * radius * radius);
+	for (int32_t r = top; r <= bottom; ++r)
+		for (int32_t c = left; c <= right; ++c)
+		{
+			float const d2 = (float) ((c - x) * (c - x) + (r - y) * (r - y));
+			weights[(size_t) r * cols + c] += weight * std::exp(d2 * scale);
+		}
+}
+
+uint32_t placeWeightedBombs(Dimensions const& dimensions, uint32_t seed, float const* weights, uint8_t* bombs)
+{
+	uint32_t const size = (uint32_t) dimensions.getX() * dimensions.getY();
+	std::memset(bombs, 0, size);
+
+	uint32_t positive = 0;
+	for (uint32_t i = 0; i < size; ++i)
+		positive += weights[i] > 0;
+
+	uint32_t const count = std::min(dimensions.getBombs(), positive);
+	if (count == 0)
+		return 0;
+	if (count == positive)
+	{
+		for (uint32_t i = 0; i < size; ++i)
+			bombs[i] = weights[i] > 0;
+		return count;
+	}
+
+	Random random(seed, 0);
+	if ((uint64_t) count * WEIGHT_BLOCK > size)
+	{
+		/* Dense boards: The fields with the largest keys log(u) / weight are a successive
+		 * sample as well (Efraimidis-Spirakis). One sequential pass beats the random
+		 * accesses of the tree. The keys are unique with the index, so is the selection. */
+		std::vector<std::pair<double, uint32_t> > keys;
+		keys.reserve(positive);
+		for (uint32_t i = 0; i < size; ++i)
+			if (weights[i] > 0)
+				keys.push_back(std::make_pair(std::log(random.uniform()) / weights[i], i));
+		std::nth_element(keys.begin(), keys.begin() + count, keys.end(),
+				std::greater<std::pair<double, uint32_t> >());
+		for (uint32_t k = 0; k < count; ++k)
+			bombs[keys[k].second] = 1;
+		return count;
+	}
+
+	/* Sparse boards: A Fenwick tree (1-based) over the weights of blocks of fields that are left.
+	 * It is small enough to stay in the cache, only the block of a hit is scanned. */
+	uint32_t const blocks = (size + WEIGHT_BLOCK - 1) / WEIGHT_BLOCK;
+	std::vector<double> tree(blocks + 1);
+	auto weight = [&](uint32_t i)
+	{
+		return weights[i] > 0 && !bombs[i] ? (double) weights[i] : 0.0;
+	};
+	auto build = [&]()
+	{
+		std::fill(tree.begin(), tree.end(), 0.0);
+		for (uint32_t b = 1; b <= blocks; ++b)
+		{
+			uint32_t const last = std::min(b * WEIGHT_BLOCK, size);
+			for (uint32_t i = (b - 1) * WEIGHT_BLOCK; i < last; ++i)
+				tree[b] += weight(i);
+			uint32_t const parent = b + (b & -b);
+			if (parent <= blocks)
+				tree[parent] += tree[b];
+		}
+		double sum = 0;
+		for (uint32_t b = blocks; b > 0; b -= b & -b)
+			sum += tree[b];
+		return sum;
+	};
+	double total = build();
+
+	uint32_t top = 1;
+	while (top * 2 <= blocks)
+		top *= 2;
+
+	for (uint32_t placed = 0; placed < count;)
+	{
+		// The first block whose prefix sum exceeds the target, then the field in the block
+		double target = random.uniform() * total;
+		uint32_t block = 0;
+		for (uint32_t step = top; step; step >>= 1)
+		{
+			if (block + step <= blocks && tree[block + step] <= target)
+			{
+				block += step;
+				target -= tree[block];
+			}
+		}
+
+		uint32_t pos = block * WEIGHT_BLOCK;
+		uint32_t const last = std::min(pos + WEIGHT_BLOCK, size);
+		double w = 0;
+		for (; pos < last; ++pos)
+		{
+			w = weight(pos);
+			if (target < w)
+				break;
+			target -= w;
+		}
+
+		// Rounding: Past the end of the block or the board. Rebuild without the rounding errors.
+		if (pos >= last)
+		{
+			total = build();
+			continue;
+		}
+
+		bombs[pos] = 1;
+		++placed;
+		for (uint32_t b = block + 1; b <= blocks; b += b & -b)
+			tree[b] -= w;
+		total -= w;
+	}
+	return count;
+}
+
+uint32_t randomSeed()
+{
+	static std::atomic<uint64_t> counter(0);
+	uint64_t x = std::chrono::high_resolution_clock::now().time_since_epoch().count() + counter.fetch_add(1);
+	return (uint32_t) splitmix64(x);
+}
+
+} // namespace msm
+
+///\}
@@ -0,0 +1,228 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file generator.hpp
+ *
+ * Deterministic generation of bomb layouts.
+ *
+ * The board is split into bands of \ref msm::BAND_ROWS rows. First the count of bombs
+ * of each band is drawn from the hypergeometric distribution, then each band places
+ * its bombs with its own random stream. Therefore the layout only depends on the seed
+ * and the dimensions, not on the count of threads used to produce it, and it is
+ * uniformly distributed over all layouts with the configured count of bombs.
+ *
+ * Non-uniform layouts, e.g. for event modes, are drawn from a \ref msm::WeightMap
+ * "weight map" by \ref msm::placeWeightedBombs().
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef GENERATOR_HPP_
+#define GENERATOR_HPP_
+
+#include <stdint.h>
+#include <vector>
+
+#include "matrix.hpp"
+#include "threadPool.hpp"
+
+namespace msm
+{
+
+/// Count of rows of a band: The unit of parallel work and of the random streams.
+const uint16_t BAND_ROWS = 64;
+
+/**
+ * Small and fast pseudo random number generator (xoshiro256**).
+ * Produces the same sequence on every platform. Different streams of the
+ * same seed are independent.
+ */
+class Random
+{
+public:
+	/** Constructor.
+	 * \param seed The seed.
+	 * \param stream The index of the stream. */
+	Random(uint64_t seed, uint64_t stream);
+
+	/// Get the next 64 random bits.
+	uint64_t next()
+	{
+		uint64_t const result = rotl(s[1] * 5, 7) * 9;
+		uint64_t const t = s[1] << 17;
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = rotl(s[3], 45);
+		return result;
+	}
+
+	/** Get an unbiased random number.
+	 * \param n The upper bound (exclusive). Must be greater 0.
+	 * \return A number in [0, n). */
+	uint32_t below(uint32_t n)
+	{
+		uint64_t m = (next() >> 32) * n;
+		uint32_t l = (uint32_t) m;
+		if (l < n)
+		{
+			uint32_t t = -n % n;
+			while (l < t)
+			{
+				m = (next() >> 32) * n;
+				l = (uint32_t) m;
+			}
+		}
+		return m >> 32;
+	}
+
+	/// Get a random number in [0, 1).
+	double uniform()
+	{
+		return (next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+private:
+	static uint64_t rotl(uint64_t x, int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+
+	uint64_t s[4];
+};
+
+/**
+ * Draw from the hypergeometric distribution: The count of bombs among
+ * n fields taken from N fields that contain K bombs.
+ * \param N The count of fields.
+ * \param K The count of bombs among them.
+ * \param n The count of fields taken.
+ * \param random The random number generator.
+ * \return The count of bombs among the n fields.
+ */
+uint32_t hypergeometric(uint32_t N, uint32_t K, uint32_t n, Random& random);
+
+/**
+ * Selection sampling: Pick exactly count of the size fields of a band, each field with
+ * the probability count / remaining fields. The one implementation of the layout of a
+ * band, shared by \ref placeBombs() and the \ref FixedBoard "fixed boards".
+ * \param seed The seed of the layout.
+ * \param band The index of the band. Its fields are drawn from the random stream band + 1.
+ * \param size The count of fields of the band.
+ * \param count The count of bombs of the band.
+ * \param place Called with the index of each picked field inside the band, in ascending order.
+ */
+template<typename Place>
+void placeInBand(uint32_t seed, uint32_t band, uint32_t size, uint32_t count, Place place)
+{
+	Random random(seed, band + 1);
+	for (uint32_t i = 0; i < size && count; ++i)
+	{
+		// Once the bombs fill the rest, no more numbers are drawn
+		uint32_t const remaining = size - i;
+		if (count == remaining || random.below(remaining) < count)
+		{
+			place(i);
+			--count;
+		}
+	}
+}
+
+/**
+ * Place the bombs for the given dimensions.
+ * \param dimensions The dimensions of the board.
+ * \param seed The seed. The same seed and dimensions always produce the same layout.
+ * \param bombs Output: X * Y bytes in row-major order. Set to 1 for bombs, to 0 else.
+ * \param pool Optional pool to process the bands in parallel.
+ */
+void placeBombs(Dimensions const& dimensions, uint32_t seed, uint8_t* bombs, ThreadPool* pool = 0);
+
+/**
+ * The relative probability of each field to hold a bomb, for non-uniform layouts.
+ * A field with weight 0 never gets a bomb (a forbidden zone). The weights are kept in
+ * row-major order like the fields of a \ref Matrix.
+ */
+class WeightMap
+{
+public:
+	/** Constructor.
+	 * \param cols The count of columns.
+	 * \param rows The count of rows.
+	 * \param weight The initial weight of every field. */
+	WeightMap(uint16_t cols, uint16_t rows, float weight = 1);
+
+	/// Get the count of columns.
+	uint16_t getCols() const
+	{
+		return cols;
+	}
+	/// Get the count of rows.
+	uint16_t getRows() const
+	{
+		return rows;
+	}
+	/// Get the weights in row-major order.
+	float const* getWeights() const
+	{
+		return weights.empty() ? 0 : &weights[0];
+	}
+	/** Get the weight of a field.
+	 * \warning Accessing a position outside of the map is undefined behaviour. */
+	float get(uint16_t x, uint16_t y) const
+	{
+		return weights[(size_t) y * cols + x];
+	}
+	/** Set the weight of a field.
+	 * \warning Accessing a position outside of the map is undefined behaviour. */
+	void set(uint16_t x, uint16_t y, float weight)
+	{
+		weights[(size_t) y * cols + x] = weight;
+	}
+	/** Set the weight of a rectangular region, clipped to the map.
+	 * \param x The left column.
+	 * \param y The top row.
+	 * \param width The count of columns.
+	 * \param height The count of rows.
+	 * \param weight The weight. 0 for a forbidden zone. */
+	void fill(uint16_t x, uint16_t y, uint16_t width, uint16_t height, float weight);
+	/** Add a cluster: A gaussian bump of weight around a field, clipped to the map.
+	 * \param x The X-coordinate of the center.
+	 * \param y The Y-coordinate of the center.
+	 * \param radius The standard deviation in fields. The bump ends at 3 * radius.
+	 * \param weight The weight added at the center. */
+	void addCluster(uint16_t x, uint16_t y, float radius, float weight);
+
+private:
+	uint16_t cols;
+	uint16_t rows;
+	std::vector<float> weights;
+};
+
+/**
+ * Place bombs according to weights.
+ * The bombs are drawn one after the other without replacement, each with a probability
+ * proportional to its weight among the fields left (successive sampling). A Fenwick tree
+ * over the weights of blocks of 64 fields finds and removes a field in O(log fields + 64),
+ * so the layout costs O(fields + bombs * log fields). Dense layouts use the equivalent
+ * exponential keys of Efraimidis and Spirakis in O(fields) instead.
+ * \param dimensions The dimensions of the board.
+ * \param seed The seed. The same seed, dimensions and weights always produce the same layout.
+ * \param weights X * Y weights in row-major order. Negative weights count as 0.
+ * \param bombs Output: X * Y bytes in row-major order. Set to 1 for bombs, to 0 else.
+ * \return The count of bombs placed: The bombs of the dimensions, but at most the count
+ * of fields with a positive weight.
+ */
+uint32_t placeWeightedBombs(Dimensions const& dimensions, uint32_t seed, float const* weights, uint8_t* bombs);
+
+/// Get a seed for a new random game.
+uint32_t randomSeed();
+
+} // namespace msm
+
+#endif /* GENERATOR_HPP_ */
+
+///\}
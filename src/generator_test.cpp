@@ -0,0 +1,203 @@
+/**
+ * @file generator_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "generator.hpp"
+
+BOOST_AUTO_TEST_SUITE(generator_test_suite)
+
+BOOST_AUTO_TEST_CASE(random_test)
+{
+	msm::Random a(42, 0), b(42, 0), c(42, 1);
+	BOOST_CHECK(a.next() == b.next());
+	BOOST_CHECK(a.next() != c.next());
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		BOOST_CHECK(a.below(7) < 7);
+		double u = a.uniform();
+		BOOST_CHECK(u >= 0.0 && u < 1.0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(hypergeometric_test)
+{
+	msm::Random r(1, 0);
+
+	BOOST_CHECK(0 == msm::hypergeometric(100, 0, 50, r));
+	BOOST_CHECK(50 == msm::hypergeometric(100, 100, 50, r));
+	BOOST_CHECK(30 == msm::hypergeometric(100, 30, 100, r));
+	// Only 10 fields without bombs: at least 40 of 50 fields are bombs.
+	for (int i = 0; i < 100; ++i)
+	{
+		uint32_t k = msm::hypergeometric(100, 90, 50, r);
+		BOOST_CHECK(k >= 40 && k <= 50);
+	}
+
+	// Mean is n * K / N
+	double sum = 0;
+	for (int i = 0; i < 10000; ++i)
+		sum += msm::hypergeometric(10000, 2000, 640, r);
+	BOOST_CHECK_CLOSE(sum / 10000, 128.0, 1.0);
+}
+
+BOOST_AUTO_TEST_CASE(place_bombs_test)
+{
+	msm::Dimensions d(100, 150, 2500);
+	std::vector<uint8_t> a(100 * 150), b(100 * 150), c(100 * 150);
+
+	msm::placeBombs(d, 7, &a[0]);
+	BOOST_CHECK(2500 == std::accumulate(a.begin(), a.end(), 0));
+
+	// Reproducible and independent of the count of threads
+	msm::ThreadPool pool(4);
+	msm::placeBombs(d, 7, &b[0], &pool);
+	BOOST_CHECK(a == b);
+
+	msm::placeBombs(d, 8, &c[0], &pool);
+	BOOST_CHECK(a != c);
+	BOOST_CHECK(2500 == std::accumulate(c.begin(), c.end(), 0));
+}
+
+BOOST_AUTO_TEST_CASE(uniform_test)
+{
+	// Every field must be a bomb with the same probability, also across band borders.
+	msm::Dimensions d(3, msm::BAND_ROWS + 2, 20);
+	uint32_t const fields = 3 * (msm::BAND_ROWS + 2);
+	uint32_t const rounds = 20000;
+
+	std::vector<uint32_t> hits(fields, 0);
+	std::vector<uint8_t> bombs(fields);
+	for (uint32_t s = 0; s < rounds; ++s)
+	{
+		msm::placeBombs(d, s, &bombs[0]);
+		for (uint32_t i = 0; i < fields; ++i)
+			hits[i] += bombs[i];
+	}
+
+	double expected = (double) rounds * 20 / fields;
+	for (uint32_t i = 0; i < fields; ++i)
+		BOOST_CHECK_CLOSE((double) hits[i], expected, 15.0);
+}
+
+BOOST_AUTO_TEST_CASE(weighted_test)
+{
+	msm::Dimensions d(100, 150, 2500);
+	std::vector<uint8_t> a(100 * 150), b(100 * 150);
+
+	// A forbidden zone and a cluster
+	msm::WeightMap weights(100, 150);
+	weights.fill(0, 0, 50, 200, 0);
+	weights.addCluster(75, 75, 5, 20);
+	BOOST_CHECK(0 == weights.get(49, 149));
+	BOOST_CHECK_CLOSE(weights.get(75, 75), 21.0f, 0.01);
+
+	BOOST_CHECK(2500 == msm::placeWeightedBombs(d, 7, weights.getWeights(), &a[0]));
+	BOOST_CHECK(2500 == std::accumulate(a.begin(), a.end(), 0));
+	uint32_t forbidden = 0, cluster = 0;
+	for (uint16_t y = 0; y < 150; ++y)
+		for (uint16_t x = 0; x < 100; ++x)
+		{
+			forbidden += x < 50 && a[y * 100 + x];
+			cluster += x >= 70 && x <= 80 && y >= 70 && y <= 80 && a[y * 100 + x];
+		}
+	BOOST_CHECK(0 == forbidden);
+	// The 121 fields around the center have a much higher density than the 1/3 of the rest
+	BOOST_CHECK(cluster > 100);
+
+	// Reproducible
+	msm::placeWeightedBombs(d, 7, weights.getWeights(), &b[0]);
+	BOOST_CHECK(a == b);
+	msm::placeWeightedBombs(d, 8, weights.getWeights(), &b[0]);
+	BOOST_CHECK(a != b);
+
+	// Not enough fields left
+	weights = msm::WeightMap(100, 150, 0);
+	weights.fill(0, 149, 100, 1, 0.5f);
+	BOOST_CHECK(100 == msm::placeWeightedBombs(d, 7, weights.getWeights(), &a[0]));
+	BOOST_CHECK(100 == std::accumulate(a.begin() + 14900, a.end(), 0));
+
+	// On a matrix
+	msm::Matrix matrix;
+	BOOST_CHECK_THROW(matrix.reset(msm::Dimensions(100, 100, 10), 7, weights), std::invalid_argument);
+	matrix.reset(d, 7, weights);
+	BOOST_CHECK(100 == matrix.getDimensions().getBombs());
+	BOOST_CHECK(dynamic_cast<msm::Bomb const*>(&matrix.at(0, 149)));
+	BOOST_CHECK(!dynamic_cast<msm::Bomb const*>(&matrix.at(0, 148)));
+	BOOST_CHECK(2 == matrix.at(0, 148).getAdjacentBombs());
+	BOOST_CHECK(3 == matrix.at(5, 148).getAdjacentBombs());
+}
+
+BOOST_AUTO_TEST_CASE(weighted_distribution_test)
+{
+	// A single bomb hits each field proportional to its weight
+	msm::Dimensions d(4, 1, 1);
+	float const weights[] = { 1, 2, 0, 3 };
+	uint32_t const rounds = 30000;
+	uint32_t hits[4] = { 0, 0, 0, 0 };
+	uint8_t bombs[4];
+	for (uint32_t s = 0; s < rounds; ++s)
+	{
+		msm::placeWeightedBombs(d, s, weights, bombs);
+		for (int i = 0; i < 4; ++i)
+			hits[i] += bombs[i];
+	}
+	BOOST_CHECK(0 == hits[2]);
+	BOOST_CHECK_CLOSE((double) hits[0], rounds / 6.0, 5.0);
+	BOOST_CHECK_CLOSE((double) hits[1], rounds / 3.0, 5.0);
+	BOOST_CHECK_CLOSE((double) hits[3], rounds / 2.0, 5.0);
+
+	// The same with few bombs on a large board (the tree instead of the keys)
+	msm::Dimensions large(200, 10, 2);
+	msm::WeightMap map(200, 10);
+	for (uint16_t x = 0; x < 200; x += 4)
+		map.fill(x, 0, 1, 10, x < 20 ? 0 : 3);
+	std::vector<uint8_t> layout(2000);
+	uint32_t heavy = 0, zero = 0;
+	for (uint32_t s = 0; s < rounds / 10; ++s)
+	{
+		BOOST_REQUIRE(2 == msm::placeWeightedBombs(large, s, map.getWeights(), &layout[0]));
+		for (uint32_t i = 0; i < 2000; ++i)
+		{
+			heavy += layout[i] && i % 4 == 0;
+			zero += layout[i] && i % 200 < 20 && i % 4 == 0;
+		}
+	}
+	// 450 fields of weight 3 versus 1500 fields of weight 1
+	BOOST_CHECK(0 == zero);
+	BOOST_CHECK_CLOSE((double) heavy, 2.0 * rounds / 10 * 1350 / 2850, 5.0);
+}
+
+BOOST_AUTO_TEST_CASE(thread_pool_test)
+{
+	msm::ThreadPool pool(3);
+	BOOST_CHECK(3 == pool.getThreadCount());
+
+	std::vector<int> done(1000, 0);
+	std::atomic<int> invalid(0);
+	pool.run(done.size(), [&](size_t i, unsigned thread)
+	{
+		if (thread >= 3)
+			++invalid;
+		done[i] += 1;
+	});
+	BOOST_CHECK(0 == invalid);
+	BOOST_CHECK(1000 == std::accumulate(done.begin(), done.end(), 0));
+
+	// The pool can be reused
+	pool.run(done.size(), [&](size_t i, unsigned)
+	{	done[i] += 1;});
+	BOOST_CHECK(2000 == std::accumulate(done.begin(), done.end(), 0));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
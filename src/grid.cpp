@@ -0,0 +1,154 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file grid.cpp
+ *
+ * Implementation of \ref grid.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "grid.hpp"
+
+#include "field.hpp"
+
+namespace msm
+{
+
+namespace
+{
+char const* TP_NAMES[] =
+{ "PLANE", "TORUS", "HEX" };
+
+/// Offsets of the eight neighbours of a rectangular field.
+const int8_t SQUARE_DX[8] =
+{ -1, 0, 1, 1, 1, 0, -1, -1 };
+const int8_t SQUARE_DY[8] =
+{ -1, -1, -1, 0, 1, 1, 1, 0 };
+
+/// Offsets of the six neighbours of a hexagonal field in even and odd rows.
+const int8_t HEX_DX[2][6] =
+{
+{ -1, 0, 1, 0, -1, -1 },
+{ 0, 1, 1, 1, 0, -1 } };
+const int8_t HEX_DY[6] =
+{ -1, -1, 0, 1, 1, 0 };
+
+/// A field that is revealed on construction.
+struct Border: public Field
+{
+	Border() :
+			Field(0xFFFF, 0xFFFF)
+	{
+		open();
+	}
+};
+}
+
+char const* toString(TOPOLOGY tp)
+{
+	if (tp <= TP_HEX)
+		return TP_NAMES[tp];
+	else
+		return "Index out of range!";
+}
+
+Grid::Grid() :
+		cols(0), rows(0), stride(2), topology(TP_PLANE), count(0)
+{
+}
+
+void Grid::shape(uint16_t _cols, uint16_t _rows, TOPOLOGY _topology)
+{
+	cols = _cols;
+	rows = _rows;
+	stride = (size_t) cols + 2;
+	topology = _topology;
+
+	int32_t const s = stride;
+	if (topology == TP_HEX)
+	{
+		count = 6;
+		for (int parity = 0; parity < 2; ++parity)
+			for (uint8_t n = 0; n < count; ++n)
+				offs[parity][n] = HEX_DY[n] * s + HEX_DX[parity][n];
+	}
+	else
+	{
+		count = 8;
+		for (int parity = 0; parity < 2; ++parity)
+			for (uint8_t n = 0; n < count; ++n)
+				offs[parity][n] = SQUARE_DY[n] * s + SQUARE_DX[n];
+	}
+}
+
+void Grid::build(Field* const* cells, uint16_t cols, uint16_t rows, TOPOLOGY topology)
+{
+	shape(cols, rows, topology);
+
+	fields.resize(getSize());
+	if (cols && rows)
+		pad<Field*>(cells, &fields[0], border());
+	stack.clear();
+}
+
+void Grid::clear()
+{
+	std::vector<Field*>().swap(fields);
+	std::vector<Field*>().swap(stack);
+	cols = 0;
+	rows = 0;
+	stride = 2;
+}
+
+void Grid::link(std::vector<uint32_t>& links) const
+{
+	uint32_t const size = (uint32_t) cols * rows;
+	std::vector<uint32_t> identity(size);
+	for (uint32_t i = 0; i < size; ++i)
+		identity[i] = i;
+
+	links.resize(getSize());
+	if (size)
+		pad<uint32_t>(&identity[0], &links[0], size);
+}
+
+void Grid::pushNeighbours(std::vector<Field*>& stack, Field const& field) const
+{
+	Position const& p = field.getPosition();
+	Field* const* c = cell(p.X, p.Y);
+	int32_t const* o = offsets(p.Y);
+	for (uint8_t n = count; n-- > 0;)
+		stack.push_back(c[o[n]]);
+}
+
+std::vector<Field*> const& Grid::cascade(Field const& field, uint32_t limit) const
+{
+	Position const& start = field.getPosition();
+	stack.clear();
+	stack.push_back(*cell(start.X, start.Y));
+	for (uint32_t visited = 0; !stack.empty() && visited < limit; ++visited)
+	{
+		Position const& p = stack.back()->getPosition();
+		stack.pop_back();
+		// The border is never opened, so it doesn't need to be skipped.
+		Field* const* c = cell(p.X, p.Y);
+		int32_t const* o = offsets(p.Y);
+		for (uint8_t n = count; n-- > 0;)
+			if (c[o[n]]->open())
+				stack.push_back(c[o[n]]);
+	}
+	return stack;
+}
+
+Field* Grid::border()
+{
+	static Border sentinel;
+	return &sentinel;
+}
+
+} // namespace msm
+
+///\}
@@ -0,0 +1,181 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file grid.hpp
+ *
+ * The neighbourhood of the \ref msm::Field "fields" of a \ref msm::Matrix "matrix".
+ *
+ * The neighbours are not stored in the fields. They are computed from the position
+ * of a field in a padded copy of the row-major storage: The grid has a border of one
+ * field on each side, so the neighbours of every field are found at constant offsets
+ * without any bounds check.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef GRID_HPP_
+#define GRID_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <limits>
+#include <vector>
+
+namespace msm
+{
+
+class Field;
+
+/// The shape of a board.
+enum TOPOLOGY
+{
+	TP_PLANE, //!< Rectangular board, eight neighbours per field.
+	TP_TORUS, //!< Like TP_PLANE, but the borders wrap around to the opposite side.
+	TP_HEX    //!< Hexagonal fields, six neighbours per field. Odd rows are shifted half a field to the right.
+};
+
+/**
+ * Get the name of a given \ref #TOPOLOGY "topology" constant.
+ * \param topology A topology.
+ * \return A string literal.
+ */
+char const* toString(TOPOLOGY topology);
+
+/// The maximum count of neighbours of a field in any topology.
+const uint8_t MAX_NEIGHBOURS = 8;
+
+/**
+ * \internal The padded storage of the fields with the neighbour offsets of a topology.
+ * - TP_PLANE and TP_HEX: The border holds the \ref border() "border sentinel".
+ * - TP_TORUS: The border holds the fields of the opposite side. With less than three
+ *   fields in a direction the neighbours of a field repeat, see Dimensions::getTopology().
+ *
+ * The neighbours are always listed clockwise, starting at the upper left one.
+ */
+class Grid
+{
+public:
+	/// Create an empty grid.
+	Grid();
+
+	/** Set the shape of the grid without any fields.
+	 * Use this to work with \ref pad() "padded arrays" of other data than fields.
+	 * \param cols The count of columns.
+	 * \param rows The count of rows.
+	 * \param topology The topology. */
+	void shape(uint16_t cols, uint16_t rows, TOPOLOGY topology);
+	/** Build the grid.
+	 * \param cells The fields in row-major order.
+	 * \param cols The count of columns.
+	 * \param rows The count of rows.
+	 * \param topology The topology. */
+	void build(Field* const* cells, uint16_t cols, uint16_t rows, TOPOLOGY topology);
+	/// Release the fields.
+	void clear();
+
+	/// Get the topology.
+	TOPOLOGY getTopology() const
+	{
+		return topology;
+	}
+	/// Get the count of columns.
+	uint16_t getCols() const
+	{
+		return cols;
+	}
+	/// Get the count of rows.
+	uint16_t getRows() const
+	{
+		return rows;
+	}
+	/// Get the count of neighbours of each field.
+	uint8_t getNeighbourCount() const
+	{
+		return count;
+	}
+	/// Get the size of a padded array (see \ref pad()).
+	size_t getSize() const
+	{
+		return stride * (rows + 2);
+	}
+
+	/// Get the padded index of a position.
+	size_t index(uint16_t x, uint16_t y) const
+	{
+		return (size_t) (y + 1) * stride + x + 1;
+	}
+	/// Get the padded storage at a position. Add the \ref offsets() to get the neighbours.
+	Field* const* cell(uint16_t x, uint16_t y) const
+	{
+		return &fields[index(x, y)];
+	}
+	/// Get the offsets of the neighbours of the fields in row y.
+	int32_t const* offsets(uint16_t y) const
+	{
+		return offs[y & 1];
+	}
+
+	/** Make a padded copy of a row-major array. The border is filled like the grid.
+	 * \param src The row-major array (cols * rows).
+	 * \param dst The padded array (\ref getSize()).
+	 * \param border The value for the border if the topology doesn't wrap around. */
+	template<typename T>
+	void pad(T const* src, T* dst, T border) const
+	{
+		int32_t const w = cols, h = rows;
+		for (int32_t y = -1; y <= h; ++y)
+		{
+			for (int32_t x = -1; x <= w; ++x)
+			{
+				T value = border;
+				if (x >= 0 && y >= 0 && x < w && y < h)
+					value = src[y * w + x];
+				else if (topology == TP_TORUS)
+					value = src[((y + h) % h) * w + (x + w) % w];
+				*dst++ = value;
+			}
+		}
+	}
+
+	/** Get the row-major index of the field at each padded index.
+	 * \param links Receives \ref getSize() indices. The border gets the index cols * rows. */
+	void link(std::vector<uint32_t>& links) const;
+
+	/// Append the neighbours of a field to a stack in reverse order, so they are popped clockwise.
+	void pushNeighbours(std::vector<Field*>& stack, Field const& field) const;
+	/** Reveal the area around a field that was just \ref Field::open() "opened", depth-first.
+	 * The neighbours are opened before they are pushed, so each field is pushed once at most.
+	 * The stack of the grid grows on demand and keeps its capacity, also across \ref build(),
+	 * so only a cascade that needs more room than all before allocates.
+	 * \param field The opened field without adjacent bombs.
+	 * \param limit The maximum count of fields whose neighbours are visited.
+	 * \return The opened fields whose neighbours were not visited yet, because the limit was hit.
+	 * Valid until the next cascade. */
+	std::vector<Field*> const& cascade(Field const& field, uint32_t limit = std::numeric_limits<uint32_t>::max()) const;
+
+	/// The sentinel in the border of a grid. It is always revealed and never changes.
+	static Field* border();
+
+private:
+	std::vector<Field*> fields;
+	/// The stack of \ref cascade(), kept to reuse its memory. A grid is used by one thread at a time.
+	mutable std::vector<Field*> stack;
+	uint16_t cols;
+	uint16_t rows;
+	size_t stride;
+	TOPOLOGY topology;
+	uint8_t count;
+	/// The offsets of the neighbours for even and odd rows.
+	int32_t offs[2][MAX_NEIGHBOURS];
+
+	Grid(Grid const& cp);
+	Grid& operator=(Grid const& cp);
+};
+
+} // namespace msm
+
+#endif /* GRID_HPP_ */
+
+///\}
@@ -0,0 +1,186 @@
+/**
+ * @file grid_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "matrix.hpp"
+
+namespace
+{
+std::vector<std::pair<int, int> > positions(msm::NeighbourRange const& range)
+{
+	std::vector<std::pair<int, int> > p;
+	for (msm::NeighbourIterator it = range.begin(); it != range.end(); ++it)
+		p.push_back(std::make_pair(it->getPosition().X, it->getPosition().Y));
+	return p;
+}
+
+bool isBomb(msm::Field const& f)
+{
+	return dynamic_cast<msm::Bomb const*>(&f) != 0;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(grid_test_suite)
+
+BOOST_AUTO_TEST_CASE(topology_test)
+{
+	msm::Dimensions d(4, 4, 2);
+	BOOST_CHECK(msm::TP_PLANE == d.getTopology());
+	d.setTopology(msm::TP_HEX);
+	BOOST_CHECK(msm::TP_HEX == d.getTopology());
+	BOOST_CHECK(std::string("TORUS") == msm::toString(msm::TP_TORUS));
+
+	msm::Matrix m(msm::Dimensions(3, 3, 0, msm::TP_TORUS));
+	BOOST_CHECK(msm::TP_TORUS == m.getDimensions().getTopology());
+	m.reset();
+	BOOST_CHECK(msm::TP_TORUS == m.getDimensions().getTopology());
+
+	// Too small for a torus: The neighbours would repeat
+	msm::Dimensions small(2, 5, 1, msm::TP_TORUS);
+	BOOST_CHECK(msm::TP_PLANE == small.getTopology());
+	small.setX(3);
+	BOOST_CHECK(msm::TP_TORUS == small.getTopology());
+	small.setY(1);
+	BOOST_CHECK(msm::TP_PLANE == small.getTopology());
+
+	// Each bomb is counted once, and a field has three neighbours like on a plane
+	msm::Matrix tiny(msm::Dimensions(2, 2, 2, msm::TP_TORUS));
+	for (msm::CellIterator it = tiny.begin(); it != tiny.end(); ++it)
+		BOOST_CHECK(it->getAdjacentBombs() <= 2);
+	BOOST_CHECK(3 == positions(tiny.neighbours(0, 0)).size());
+}
+
+BOOST_AUTO_TEST_CASE(pad_test)
+{
+	msm::Grid grid;
+	msm::Field* cells[] = { 0, 0 };
+	int const src[] = { 1, 2 };
+	int dst[12];
+
+	grid.build(cells, 2, 1, msm::TP_PLANE);
+	BOOST_REQUIRE(12 == grid.getSize());
+	grid.pad(src, dst, -1);
+	int const plane[] = { -1, -1, -1, -1, -1, 1, 2, -1, -1, -1, -1, -1 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(dst, dst + 12, plane, plane + 12);
+
+	grid.build(cells, 2, 1, msm::TP_TORUS);
+	grid.pad(src, dst, -1);
+	int const torus[] = { 2, 1, 2, 1, 2, 1, 2, 1, 2, 1, 2, 1 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(dst, dst + 12, torus, torus + 12);
+}
+
+BOOST_AUTO_TEST_CASE(torus_test)
+{
+	msm::Matrix m(msm::Dimensions(4, 3, 0, msm::TP_TORUS));
+
+	std::vector<std::pair<int, int> > n = positions(m.neighbours(0, 0));
+	BOOST_REQUIRE(8 == n.size());
+	// Clockwise from the upper left one, wrapped around
+	BOOST_CHECK(std::make_pair(3, 2) == n[0]);
+	BOOST_CHECK(std::make_pair(0, 2) == n[1]);
+	BOOST_CHECK(std::make_pair(1, 2) == n[2]);
+	BOOST_CHECK(std::make_pair(1, 0) == n[3]);
+	BOOST_CHECK(std::make_pair(3, 0) == n[7]);
+
+	// An empty torus opens completely from any field, even across the border
+	m.at(1, 1).cycleMark();
+	m.at(1, 1).cycleMark();
+	m.at(2, 0).reveal();
+	BOOST_CHECK(msm::GS_WON == m.getStatus());
+}
+
+BOOST_AUTO_TEST_CASE(hex_test)
+{
+	msm::Matrix m(msm::Dimensions(4, 4, 0, msm::TP_HEX));
+
+	// Even row: The upper neighbours are shifted to the left
+	std::vector<std::pair<int, int> > n = positions(m.neighbours(1, 2));
+	BOOST_REQUIRE(6 == n.size());
+	BOOST_CHECK(std::make_pair(0, 1) == n[0]);
+	BOOST_CHECK(std::make_pair(1, 1) == n[1]);
+	BOOST_CHECK(std::make_pair(2, 2) == n[2]);
+	BOOST_CHECK(std::make_pair(1, 3) == n[3]);
+	BOOST_CHECK(std::make_pair(0, 3) == n[4]);
+	BOOST_CHECK(std::make_pair(0, 2) == n[5]);
+
+	// Odd row: Shifted to the right
+	n = positions(m.neighbours(1, 1));
+	BOOST_REQUIRE(6 == n.size());
+	BOOST_CHECK(std::make_pair(1, 0) == n[0]);
+	BOOST_CHECK(std::make_pair(2, 0) == n[1]);
+	BOOST_CHECK(std::make_pair(2, 2) == n[3]);
+	BOOST_CHECK(std::make_pair(1, 2) == n[4]);
+
+	// Corners: The border is skipped
+	BOOST_CHECK(2 == positions(m.neighbours(0, 0)).size());
+	BOOST_CHECK(3 == positions(m.neighbours(3, 1)).size());
+}
+
+BOOST_AUTO_TEST_CASE(adjacent_bombs_test)
+{
+	msm::TOPOLOGY const topologies[] = { msm::TP_PLANE, msm::TP_TORUS, msm::TP_HEX };
+	for (int t = 0; t < 3; ++t)
+	{
+		msm::Matrix m;
+		m.setThreadCount(3);
+		m.reset(msm::Dimensions(37, 150, 900, topologies[t]), 5);
+
+		for (uint16_t y = 0; y < 150; ++y)
+			for (uint16_t x = 0; x < 37; ++x)
+			{
+				msm::NeighbourRange n = m.neighbours(x, y);
+				BOOST_CHECK(std::count_if(n.begin(), n.end(), isBomb) == m.at(x, y).getAdjacentBombs());
+			}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(parallel_reveal_test)
+{
+	// Same result as the serial cascade in every topology
+	msm::TOPOLOGY const topologies[] = { msm::TP_PLANE, msm::TP_TORUS, msm::TP_HEX };
+	for (int t = 0; t < 3; ++t)
+	{
+		msm::Dimensions d(120, 90, 80, topologies[t]);
+		msm::Matrix serial(d), parallel;
+		parallel.setThreadCount(4);
+		parallel.setParallelRevealThreshold(8);
+		serial.reset(d, 3);
+		parallel.reset(d, 3);
+
+		for (uint16_t y = 0; y < 90; y += 13)
+			for (uint16_t x = 0; x < 120; x += 17)
+				BOOST_CHECK(serial.at(x, y).reveal() == parallel.reveal(x, y));
+
+		for (msm::CellIterator a = serial.begin(), b = parallel.begin(); a != serial.end(); ++a, ++b)
+			BOOST_CHECK(a->getStatus() == b->getStatus());
+	}
+}
+
+BOOST_AUTO_TEST_CASE(frontier_test)
+{
+	// The border must not count as a revealed neighbour
+	msm::Matrix m(msm::Dimensions(3, 3, 0, msm::TP_HEX));
+	BOOST_CHECK(m.frontier().empty());
+
+	m.at(1, 1).cycleMark();
+	m.at(2, 2).reveal();
+	BOOST_CHECK(m.frontier().empty());
+
+	// Queried fields belong to the frontier
+	m.at(1, 1).cycleMark();
+	msm::FrontierRange f = m.frontier();
+	BOOST_REQUIRE(1 == std::distance(f.begin(), f.end()));
+	BOOST_CHECK(1 == f.begin()->getPosition().X && 1 == f.begin()->getPosition().Y);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
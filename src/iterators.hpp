@@ -0,0 +1,389 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file iterators.hpp
+ *
+ * Iterators over the \ref msm::Field "fields" of a \ref msm::Matrix "matrix".
+ * The iterators work on the row-major storage of the matrix directly, visit the
+ * fields in memory order and never throw.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef ITERATORS_HPP_
+#define ITERATORS_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <iterator>
+
+#include "field.hpp"
+#include "grid.hpp"
+
+namespace msm
+{
+
+/// A pair of iterators for the use with range based for loops and algorithms.
+template<typename Iterator>
+class Range
+{
+public:
+	typedef Iterator iterator;
+	typedef Iterator const_iterator;
+
+	/// Constructor.
+	Range(Iterator first, Iterator last) :
+			first(first), last(last)
+	{
+	}
+
+	iterator begin() const
+	{
+		return first;
+	}
+	iterator end() const
+	{
+		return last;
+	}
+	bool empty() const
+	{
+		return first == last;
+	}
+
+private:
+	Iterator first;
+	Iterator last;
+};
+
+/// Random access iterator over all fields in row-major order.
+class CellIterator
+{
+public:
+	typedef std::random_access_iterator_tag iterator_category;
+	typedef Field value_type;
+	typedef ptrdiff_t difference_type;
+	typedef Field* pointer;
+	typedef Field& reference;
+
+	/// Construct a singular iterator.
+	CellIterator() :
+			p(0)
+	{
+	}
+	/** Constructor.
+	 * \param p Position in the row-major storage of the matrix. */
+	explicit CellIterator(Field* const* p) :
+			p(p)
+	{
+	}
+
+	reference operator*() const
+	{
+		return **p;
+	}
+	pointer operator->() const
+	{
+		return *p;
+	}
+	reference operator[](difference_type n) const
+	{
+		return *p[n];
+	}
+	CellIterator& operator++()
+	{
+		++p;
+		return *this;
+	}
+	CellIterator operator++(int)
+	{
+		return CellIterator(p++);
+	}
+	CellIterator& operator--()
+	{
+		--p;
+		return *this;
+	}
+	CellIterator operator--(int)
+	{
+		return CellIterator(p--);
+	}
+	CellIterator& operator+=(difference_type n)
+	{
+		p += n;
+		return *this;
+	}
+	CellIterator& operator-=(difference_type n)
+	{
+		p -= n;
+		return *this;
+	}
+	CellIterator operator+(difference_type n) const
+	{
+		return CellIterator(p + n);
+	}
+	CellIterator operator-(difference_type n) const
+	{
+		return CellIterator(p - n);
+	}
+	difference_type operator-(CellIterator const& rhs) const
+	{
+		return p - rhs.p;
+	}
+	bool operator==(CellIterator const& rhs) const
+	{
+		return p == rhs.p;
+	}
+	bool operator!=(CellIterator const& rhs) const
+	{
+		return p != rhs.p;
+	}
+	bool operator<(CellIterator const& rhs) const
+	{
+		return p < rhs.p;
+	}
+	bool operator>(CellIterator const& rhs) const
+	{
+		return p > rhs.p;
+	}
+	bool operator<=(CellIterator const& rhs) const
+	{
+		return p <= rhs.p;
+	}
+	bool operator>=(CellIterator const& rhs) const
+	{
+		return p >= rhs.p;
+	}
+
+private:
+	Field* const* p;
+};
+
+/// Iterator over a rectangular region of the matrix. Row by row, left to right.
+class RegionIterator
+{
+public:
+	typedef std::forward_iterator_tag iterator_category;
+	typedef Field value_type;
+	typedef ptrdiff_t difference_type;
+	typedef Field* pointer;
+	typedef Field& reference;
+
+	/** Constructor.
+	 * \param row The first field of the current row in the row-major storage.
+	 * \param stride The count of columns of the matrix.
+	 * \param width The width of the region.
+	 * \param column The current column inside the region. */
+	RegionIterator(Field* const* row, uint16_t stride, uint16_t width, uint16_t column) :
+			row(row), stride(stride), width(width), column(column)
+	{
+	}
+
+	reference operator*() const
+	{
+		return *row[column];
+	}
+	pointer operator->() const
+	{
+		return row[column];
+	}
+	RegionIterator& operator++()
+	{
+		if (++column == width)
+		{
+			column = 0;
+			row += stride;
+		}
+		return *this;
+	}
+	RegionIterator operator++(int)
+	{
+		RegionIterator tmp(*this);
+		++*this;
+		return tmp;
+	}
+	bool operator==(RegionIterator const& rhs) const
+	{
+		return row == rhs.row && column == rhs.column;
+	}
+	bool operator!=(RegionIterator const& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+private:
+	Field* const* row;
+	uint16_t stride;
+	uint16_t width;
+	uint16_t column;
+};
+
+/**
+ * Iterator over the neighbours of a field in the topology of the matrix (see \ref Grid).
+ * Neighbours outside of the matrix are skipped.
+ */
+class NeighbourIterator
+{
+public:
+	typedef std::forward_iterator_tag iterator_category;
+	typedef Field value_type;
+	typedef ptrdiff_t difference_type;
+	typedef Field* pointer;
+	typedef Field& reference;
+
+	/** Constructor.
+	 * \param center The position of the field in the padded storage (\ref Grid::cell()).
+	 * \param offsets The offsets of the neighbours (\ref Grid::offsets()).
+	 * \param i The index of the first neighbour to consider.
+	 * \param count The count of neighbours. */
+	NeighbourIterator(Field* const* center, int32_t const* offsets, uint8_t i, uint8_t count) :
+			center(center), offsets(offsets), i(i), count(count)
+	{
+		skip();
+	}
+
+	reference operator*() const
+	{
+		return *center[offsets[i]];
+	}
+	pointer operator->() const
+	{
+		return center[offsets[i]];
+	}
+	NeighbourIterator& operator++()
+	{
+		++i;
+		skip();
+		return *this;
+	}
+	NeighbourIterator operator++(int)
+	{
+		NeighbourIterator tmp(*this);
+		++*this;
+		return tmp;
+	}
+	bool operator==(NeighbourIterator const& rhs) const
+	{
+		return i == rhs.i && center == rhs.center;
+	}
+	bool operator!=(NeighbourIterator const& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+private:
+	void skip()
+	{
+		while (i < count && center[offsets[i]] == Grid::border())
+			++i;
+	}
+
+	Field* const* center;
+	int32_t const* offsets;
+	uint8_t i;
+	uint8_t count;
+};
+
+/**
+ * Iterator over the frontier: All fields that are not revealed and not marked
+ * (\ref FS_HIDDEN or \ref FS_QUERIED) and have at least one revealed neighbour.
+ * The fields are visited in row-major order.
+ */
+class FrontierIterator
+{
+public:
+	typedef std::forward_iterator_tag iterator_category;
+	typedef Field value_type;
+	typedef ptrdiff_t difference_type;
+	typedef Field* pointer;
+	typedef Field& reference;
+
+	/** Constructor.
+	 * \param grid The grid of the matrix.
+	 * \param cells The row-major storage of the matrix.
+	 * \param cols The count of columns.
+	 * \param rows The count of rows.
+	 * \param index The row-major index to start the search at. */
+	FrontierIterator(Grid const* grid, Field* const* cells, uint16_t cols, uint16_t rows, size_t index) :
+			grid(grid), cells(cells), cols(cols), index(index), count((size_t) cols * rows)
+	{
+		skip();
+	}
+
+	reference operator*() const
+	{
+		return *cells[index];
+	}
+	pointer operator->() const
+	{
+		return cells[index];
+	}
+	FrontierIterator& operator++()
+	{
+		++index;
+		skip();
+		return *this;
+	}
+	FrontierIterator operator++(int)
+	{
+		FrontierIterator tmp(*this);
+		++*this;
+		return tmp;
+	}
+	bool operator==(FrontierIterator const& rhs) const
+	{
+		return index == rhs.index && cells == rhs.cells;
+	}
+	bool operator!=(FrontierIterator const& rhs) const
+	{
+		return !(*this == rhs);
+	}
+
+private:
+	bool isFrontier() const
+	{
+		FIELDSTATUS s = cells[index]->getStatus();
+		if (s != FS_HIDDEN && s != FS_QUERIED)
+			return false;
+
+		uint16_t x = index % cols;
+		uint16_t y = index / cols;
+		Field* const* center = grid->cell(x, y);
+		int32_t const* offsets = grid->offsets(y);
+		// The border is revealed, so it must be skipped.
+		for (uint8_t n = 0; n < grid->getNeighbourCount(); ++n)
+		{
+			Field const* f = center[offsets[n]];
+			if (f->getStatus() == FS_UNHIDDEN && f != Grid::border())
+				return true;
+		}
+		return false;
+	}
+	void skip()
+	{
+		while (index < count && !isFrontier())
+			++index;
+	}
+
+	Grid const* grid;
+	Field* const* cells;
+	uint16_t cols;
+	size_t index;
+	size_t count;
+};
+
+/// All fields in row-major order.
+typedef Range<CellIterator> CellRange;
+/// A rectangular region.
+typedef Range<RegionIterator> RegionRange;
+/// The neighbours of a field.
+typedef Range<NeighbourIterator> NeighbourRange;
+/// The frontier of the revealed area.
+typedef Range<FrontierIterator> FrontierRange;
+
+} // namespace msm
+
+#endif /* ITERATORS_HPP_ */
+
+///\}
@@ -0,0 +1,117 @@
+/**
+ * @file iterators_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+#include "matrix.hpp"
+
+namespace
+{
+bool isAt(msm::Field const& f, uint16_t x, uint16_t y)
+{
+	return f.getPosition().X == x && f.getPosition().Y == y;
+}
+
+bool isHidden(msm::Field const& f)
+{
+	return f.getStatus() == msm::FS_HIDDEN;
+}
+
+bool isMarked(msm::Field const& f)
+{
+	return f.getStatus() == msm::FS_MARKED;
+}
+}
+
+struct Fix_iterators_test
+{
+	Fix_iterators_test() :
+			matrix(msm::Dimensions(4, 3, 0))
+	{
+	}
+
+	msm::Matrix matrix;
+};
+
+BOOST_FIXTURE_TEST_SUITE(iterators_test_suite, Fix_iterators_test)
+
+BOOST_AUTO_TEST_CASE(row_major_test)
+{
+	BOOST_REQUIRE(12 == matrix.end() - matrix.begin());
+
+	uint16_t i = 0;
+	for (msm::CellIterator it = matrix.begin(); it != matrix.end(); ++it, ++i)
+		BOOST_CHECK(isAt(*it, i % 4, i / 4));
+
+	BOOST_CHECK(isAt(matrix.begin()[5], 1, 1));
+	BOOST_CHECK(isAt(*(matrix.end() - 1), 3, 2));
+	BOOST_CHECK(&matrix.begin()[6] == &matrix[2][1]);
+
+	matrix.at(2, 2).cycleMark();
+	BOOST_CHECK(11 == std::count_if(matrix.all().begin(), matrix.all().end(), isHidden));
+	msm::CellIterator found = std::find_if(matrix.begin(), matrix.end(), isMarked);
+	BOOST_CHECK(found - matrix.begin() == 2 * 4 + 2);
+}
+
+BOOST_AUTO_TEST_CASE(region_test)
+{
+	msm::RegionRange r = matrix.region(1, 1, 2, 2);
+	BOOST_REQUIRE(4 == std::distance(r.begin(), r.end()));
+
+	msm::RegionIterator it = r.begin();
+	BOOST_CHECK(isAt(*it++, 1, 1));
+	BOOST_CHECK(isAt(*it++, 2, 1));
+	BOOST_CHECK(isAt(*it++, 1, 2));
+	BOOST_CHECK(isAt(*it++, 2, 2));
+	BOOST_CHECK(it == r.end());
+
+	// Clipped
+	msm::RegionRange clipped = matrix.region(2, 1, 10, 10);
+	BOOST_CHECK(4 == std::distance(clipped.begin(), clipped.end()));
+	BOOST_CHECK(isAt(*clipped.begin(), 2, 1));
+
+	BOOST_CHECK(matrix.region(4, 0, 1, 1).empty());
+	BOOST_CHECK(matrix.region(0, 0, 0, 1).empty());
+}
+
+BOOST_AUTO_TEST_CASE(frontier_test)
+{
+	matrix.reset(msm::Dimensions(3, 3, 0));
+	BOOST_CHECK(matrix.frontier().empty());
+
+	// Block the cascade with marks in the middle column.
+	for (uint16_t y = 0; y < 3; ++y)
+		matrix.at(1, y).cycleMark();
+	matrix.at(0, 0).reveal();
+
+	BOOST_CHECK(matrix.frontier().empty());
+
+	// Queried fields are unknown and belong to the frontier.
+	matrix.at(1, 1).cycleMark();
+	msm::FrontierRange f = matrix.frontier();
+	BOOST_REQUIRE(1 == std::distance(f.begin(), f.end()));
+	BOOST_CHECK(isAt(*f.begin(), 1, 1));
+
+	// A hidden field next to a revealed one.
+	matrix.at(1, 0).cycleMark();
+	matrix.at(1, 0).cycleMark();
+	f = matrix.frontier();
+	BOOST_REQUIRE(2 == std::distance(f.begin(), f.end()));
+	BOOST_CHECK(isAt(*f.begin(), 1, 0));
+}
+
+BOOST_AUTO_TEST_CASE(neighbour_range_test)
+{
+	msm::NeighbourRange n = matrix.neighbours(3, 2);
+	BOOST_CHECK(3 == std::distance(n.begin(), n.end()));
+	BOOST_CHECK(std::find_if(n.begin(), n.end(), isHidden) != n.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -13,6 +13,19 @@
 #include "matrix.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "generator.hpp"
+#include "matrixClone.hpp"
+#include "memory.hpp"
+#include "openings.hpp"
+#include "threadPool.hpp"
 
 namespace msm
 {
@@ -41,6 +54,72 @@ namespace
 {
 char const* GS_NAMES[] =
 { "READY", "RUNNING", "WON", "LOST" };
+
+/// Default count of fields that are revealed serially before the parallel search starts.
+uint32_t const PARALLEL_REVEAL_THRESHOLD = 16384;
+/// Edge length of the tiles that assign the fields to the threads.
+uint32_t const TILE_SIZE = 64;
+/// The memory of a field or bomb in an arena.
+size_t const FIELD_SLOT = sizeof(Field) > sizeof(Bomb) ? sizeof(Field) : sizeof(Bomb);
+size_t const FIELD_ALIGNMENT = alignof(Field) > alignof(Bomb) ? alignof(Field) : alignof(Bomb);
+/// Marks a field that was not changed by the current batch of Matrix::apply().
+uint8_t const NOT_CHANGED = 0xFF;
+
+/** The status of a field before its change to the given status.
+ * A revealed field or bomb was hidden or queried before. Both differ from the new
+ * status, which is all that a batch compares. */
+uint8_t previousStatus(FIELDSTATUS newStatus)
+{
+	switch (newStatus)
+	{
+	case FS_MARKED:
+		return FS_HIDDEN;
+	case FS_QUERIED:
+		return FS_MARKED;
+	case FS_HIDDEN:
+		return FS_QUERIED;
+	default:
+		return FS_HIDDEN;
+	}
+}
+
+/// Fields a thread has to expand. The owner works at the back, other threads steal from the front.
+struct WorkQueue
+{
+	std::mutex mutex;
+	std::deque<Field*> fields;
+
+	void push(Field* field)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		fields.push_back(field);
+	}
+	bool pop(Field*& field)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (fields.empty())
+			return false;
+		field = fields.back();
+		fields.pop_back();
+		return true;
+	}
+	bool steal(Field*& field)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (fields.empty())
+			return false;
+		field = fields.front();
+		fields.pop_front();
+		return true;
+	}
+};
+
+/// True if Field::reveal() would reveal the field.
+bool isRevealable(Field const& field)
+{
+	FIELDSTATUS status = field.getStatus();
+	return status == FS_HIDDEN || status == FS_QUERIED;
+}
 }
 
 char const* toString(GAMESTATUS gs)
@@ -51,18 +130,18 @@ char const* toString(GAMESTATUS gs)
 		return "Index out of range!";
 }
 
-Dimensions::Dimensions(uint16_t x, uint16_t y, uint16_t bombs) :
-		x(0), y(0), bombs(0)
+Dimensions::Dimensions(uint16_t x, uint16_t y, uint32_t bombs, TOPOLOGY topology) :
+		x(0), y(0), bombs(0), topology(topology)
 {
 	setX(x);
 	setY(y);
 	setBombs(bombs);
 }
 
-void Dimensions::setBombs(uint16_t _bombs)
+void Dimensions::setBombs(uint32_t _bombs)
 {
-	if (_bombs > (x * y))
-		bombs = x * y;
+	if (_bombs > ((uint32_t) x * y))
+		bombs = (uint32_t) x * y;
 	else
 		bombs = _bombs;
 }
@@ -82,8 +161,13 @@ void Dimensions::setY(uint16_t _y)
 struct Matrix::Impl: public FieldObserver
 {
 	Impl(Matrix* backRef) :
-			backRef(backRef), matrix(0), status(GS_READY)
+			backRef(backRef), status(GS_READY), seed(0), pool(0), upstream(newDeleteResource()), revealThreshold(
+					PARALLEL_REVEAL_THRESHOLD), labelled(false), batching(false), claims(0), fieldLayout(LT_ROWS), fieldTile(0)
+	{
+	}
+	~Impl()
 	{
+		delete pool;
 	}
 
 	Matrix* backRef;
@@ -92,28 +176,93 @@ struct Matrix::Impl: public FieldObserver
 
 	Dimensions dim;
 
-	Field*** matrix;
-
 	GAMESTATUS status;
 
-	uint16_t unhidden;
-	uint16_t marked;
-	uint16_t queried;
+	uint32_t unhidden;
+	uint32_t marked;
+	uint32_t queried;
+
+	uint32_t seed;
+
+	/// Pool for the parallel reset and reveal. 0 when running serially.
+	ThreadPool* pool;
+
+	/// The source of the arenas.
+	MemoryResource* upstream;
+	/// One arena per thread for the fields and the arrays of a board. Released on reset.
+	std::vector<std::unique_ptr<MonotonicResource> > arenas;
+
+	uint32_t revealThreshold;
+	/** Mirror of the field statuses, shared with the clones. Filled by the first clone after
+	 * a reset and kept up to date while there is a \ref layout, so a matrix that is never
+	 * cloned doesn't copy a tile. */
+	TileStore statuses;
+	/// The layout of the clones. Built by the first clone after a reset.
+	std::shared_ptr<MatrixClone::Layout const> layout;
+
+	/// The bombs (1) and the adjacent bombs of each field, row-major. Kept to label the openings.
+	std::vector<uint8_t> bombs;
+	std::vector<uint8_t> adjacent;
+	/// The openings of the layout. Labelled on first use after a reset.
+	Openings openings;
+	bool labelled;
+	/// The count of marked or revealed fields without adjacent bombs of each opening.
+	std::vector<uint32_t> blocked;
+
+	/// True while \ref Matrix::apply() collects the changes instead of informing the observers.
+	bool batching;
+	/// The fields changed by the current batch in the order of their first change.
+	std::vector<uint32_t> changed;
+	/// The status of each field before the current batch, NOT_CHANGED if it didn't change yet.
+	std::vector<uint8_t> original;
+
+	/// One flag per field for the parallel reveal. Allocated on first use, all zero between two reveals.
+	std::atomic<uint8_t>* claims;
+
+	/// The order of the fields in the arenas for the next reset.
+	LAYOUT fieldLayout;
+	/// The edge length of the tiles of the current fields. 0 if they are stored row-major.
+	uint16_t fieldTile;
 
 	void deleteMatrix();
+	void prepareArenas();
+
+	Openings const& label();
+	void open(uint32_t opening);
+	void cascade(Field const& field);
+	void expand(std::vector<Field*> const& seeds);
+
+	/** Collects the changes of \ref Matrix::apply() for its scope and informs the observers
+	 * once. If an action throws, the changes made so far are still reported. */
+	struct Batch
+	{
+		explicit Batch(Impl& impl);
+		~Batch();
+		/// End the batch and inform the observers.
+		void notify();
+
+		Impl& impl;
+		GAMESTATUS const oldStatus;
+		uint32_t const oldMarked;
+		bool notified;
+	};
+
+	void notifyBatch(GAMESTATUS oldStatus, uint32_t oldMarked);
+	/// Forget the changes of a batch that couldn't be reported.
+	void dropBatch();
 
 	void onFieldStatusChanged(Field const&, FIELDSTATUS);
 	void onFieldDelete(Field const&);
 };
 
 Matrix::Matrix() :
-		pImpl(new Matrix::Impl(this))
+		pImpl(new Matrix::Impl(this)), cells(0), cols(0), rows(0)
 {
 	reset(Dimensions());
 }
 
 Matrix::Matrix(Dimensions const& dimensions) :
-		pImpl(new Matrix::Impl(this))
+		pImpl(new Matrix::Impl(this)), cells(0), cols(0), rows(0)
 {
 	reset(dimensions);
 }
@@ -133,7 +282,7 @@ void Matrix::addObserver(MatrixObserver* o)
 
 void Matrix::removeObserver(MatrixObserver* o)
 {
-	std::remove_if(pImpl->observers.begin(), pImpl->observers.end(), compare_address<MatrixObserver>(o));
+	pImpl->observers.remove_if(compare_address<MatrixObserver>(o));
 }
 
 Dimensions const& Matrix::getDimensions() const
@@ -147,10 +296,28 @@ void Matrix::reset()
 }
 
 void Matrix::reset(Dimensions const& dimensions)
+{
+	reset(dimensions, randomSeed());
+}
+
+void Matrix::reset(Dimensions const& dimensions, uint32_t seed)
+{
+	build(dimensions, seed, 0);
+}
+
+void Matrix::reset(Dimensions const& dimensions, uint32_t seed, WeightMap const& weights)
+{
+	if (weights.getCols() != dimensions.getX() || weights.getRows() != dimensions.getY())
+		throw std::invalid_argument("The weight map doesn't match the dimensions");
+	build(dimensions, seed, &weights);
+}
+
+void Matrix::build(Dimensions const& dimensions, uint32_t seed, WeightMap const* weights)
 {
 	pImpl->deleteMatrix();
 
 	pImpl->dim = dimensions;
+	pImpl->seed = seed;
 
 	pImpl->status = GS_READY;
 
@@ -158,97 +325,382 @@ void Matrix::reset(Dimensions const& dimensions)
 	pImpl->marked = 0;
 	pImpl->queried = 0;
 
+	pImpl->layout.reset();
+
 	uint16_t dimX = pImpl->dim.getX();
 	uint16_t dimY = pImpl->dim.getY();
+	uint32_t bands = (dimY + BAND_ROWS - 1) / BAND_ROWS;
 
-	//Create help matrix for bomb positioning
-	uint8_t** bombs = new uint8_t*[dimX];
-	for (uint16_t x = 0; x < dimX; x++)
-		bombs[x] = new uint8_t[dimY];
-
-	//Fill with 0
-	for (uint16_t y = 0; y < dimY; y++)
+	//Create help matrix for bomb positioning (row-major, 1 on bomb positions)
+	std::vector<uint8_t>& bombs = pImpl->bombs;
+	bombs.assign((size_t) dimX * dimY, 0);
+	if (!bombs.empty())
 	{
-		for (uint16_t x = 0; x < dimX; x++)
-			bombs[x][y] = 0;
+		if (weights)
+			pImpl->dim.setBombs(placeWeightedBombs(pImpl->dim, seed, weights->getWeights(), &bombs[0]));
+		else
+			placeBombs(pImpl->dim, seed, &bombs[0], pImpl->pool);
 	}
 
-	//Produce ones on bomb positions
-	srand(time(0));
-	uint32_t position = 0;
-	for (uint16_t b = 0; b < pImpl->dim.getBombs(); b++)
+	//Create matrix
+	pImpl->prepareArenas();
+	cells = static_cast<Field**>(pImpl->arenas[0]->allocate((size_t) dimX * dimY * sizeof(Field*), alignof(Field*)));
+	cols = dimX;
+	rows = dimY;
+
+	//Create bombs or normal fields. The tiles of LT_TILES don't cross the bands.
+	pImpl->fieldTile = pImpl->fieldLayout == LT_TILES ? LAYOUT_TILE : 0;
+	uint16_t const tile = pImpl->fieldTile ? pImpl->fieldTile : BAND_ROWS;
+	uint16_t const tileCols = pImpl->fieldTile ? pImpl->fieldTile : dimX;
+	ThreadPool::Task create = [&](size_t band, unsigned thread)
 	{
-		position = ((rand() % (dimX * dimY)));
+		MonotonicResource* arena = pImpl->arenas[thread].get();
+		uint16_t last = std::min<uint32_t>((band + 1) * BAND_ROWS, dimY);
+		for (uint32_t ty = band * BAND_ROWS; ty < last; ty += tile)
+		{
+			for (uint32_t tx = 0; tx < dimX; tx += tileCols)
+			{
+				uint16_t const lastY = std::min<uint32_t>(ty + tile, last);
+				uint16_t const lastX = std::min<uint32_t>(tx + tileCols, dimX);
+				for (uint16_t y = ty; y < lastY; y++)
+				{
+					for (uint16_t x = tx; x < lastX; x++)
+					{
+						size_t i = (size_t) y * dimX + x;
+						void* slot = arena->allocate(FIELD_SLOT, FIELD_ALIGNMENT);
+						(bombs[i] == 1) ?
+								cells[i] = new (slot) Bomb(Position(x, y), arena) :
+								cells[i] = new (slot) Field(Position(x, y), arena);
+
+						cells[i]->addObserver(pImpl);
+						cells[i]->setGrid(&grid);
+					}
+				}
+			}
+		}
+	};
 
-		//Is already bomb? Try again!
-		if (bombs[(position % dimX)][position / dimX])
-			b--;
-		else
+	//Count adjacent bombs in a padded copy of the bombs, so no bounds checks are needed
+	std::vector<uint8_t> padded;
+	std::vector<uint8_t>& adjacent = pImpl->adjacent;
+	adjacent.resize(bombs.size());
+	ThreadPool::Task count = [&](size_t band, unsigned)
+	{
+		uint8_t const n = grid.getNeighbourCount();
+		uint16_t last = std::min<uint32_t>((band + 1) * BAND_ROWS, dimY);
+		for (uint16_t y = band * BAND_ROWS; y < last; y++)
 		{
-			//Place bomb
-			bombs[(position % dimX)][position / dimX] = 1;
+			int32_t const* offsets = grid.offsets(y);
+			for (uint16_t x = 0; x < dimX; x++)
+			{
+				uint8_t const* b = &padded[grid.index(x, y)];
+				uint8_t sum = 0;
+				for (uint8_t k = 0; k < n; ++k)
+					sum += b[offsets[k]];
+				at(x, y).setAdjacentBombs(adjacent[(size_t) y * dimX + x] = sum);
+			}
 		}
+	};
+
+	//The bands only write their own fields, so no synchronization is needed
+	if (pImpl->pool)
+		pImpl->pool->run(bands, create);
+	else
+	{
+		for (uint32_t b = 0; b < bands; b++)
+			create(b, 0);
 	}
 
-	//Create matrix
-	pImpl->matrix = new Field**[dimX];
-	for (uint16_t x = 0; x < dimX; x++)
-		pImpl->matrix[x] = new Field*[dimY];
+	grid.build(cells, dimX, dimY, pImpl->dim.getTopology());
+	pImpl->statuses.reset(dimX, dimY);
+	if (!bombs.empty())
+	{
+		padded.resize(grid.getSize());
+		grid.pad<uint8_t>(&bombs[0], &padded[0], 0);
+	}
+
+	if (pImpl->pool)
+		pImpl->pool->run(bands, count);
+	else
+	{
+		for (uint32_t b = 0; b < bands; b++)
+			count(b, 0);
+	}
 
-	//Create bombs or normal fields
-	for (uint16_t y = 0; y < dimY; y++)
+	pImpl->labelled = false;
+	pImpl->openings.clear();
+
+	for (std::list<MatrixObserver*>::const_iterator it = pImpl->observers.begin(); it != pImpl->observers.end(); ++it)
 	{
-		for (uint16_t x = 0; x < dimX; x++)
+		(*it)->onGameStatusChanged(*this, pImpl->status);
+	}
+#if SIGNALS
+	signalGameStatusChanged(*this, pImpl->status);
+#endif
+}
+
+uint32_t Matrix::getSeed() const
+{
+	return pImpl->seed;
+}
+
+void Matrix::setThreadCount(unsigned threads)
+{
+	delete pImpl->pool;
+	pImpl->pool = 0;
+
+	if (threads != 1)
+		pImpl->pool = new ThreadPool(threads);
+}
+
+unsigned Matrix::getThreadCount() const
+{
+	return pImpl->pool ? pImpl->pool->getThreadCount() : 1;
+}
+
+void Matrix::setMemoryResource(MemoryResource* resource)
+{
+	pImpl->upstream = resource ? resource : newDeleteResource();
+}
+
+MemoryResource* Matrix::getMemoryResource() const
+{
+	return pImpl->upstream;
+}
+
+void Matrix::setLayout(LAYOUT layout)
+{
+	pImpl->fieldLayout = layout;
+}
+
+LAYOUT Matrix::getLayout() const
+{
+	return pImpl->fieldLayout;
+}
+
+MatrixClone Matrix::clone() const
+{
+	if (!pImpl->layout)
+	{
+		std::vector<uint8_t> const& bombs = pImpl->bombs;
+		std::vector<uint8_t> const& adjacent = pImpl->adjacent;
+		pImpl->layout = bombs.empty() ?
+				std::make_shared<MatrixClone::Layout const>(pImpl->dim, (uint8_t const*) 0, (uint8_t const*) 0) :
+				std::make_shared<MatrixClone::Layout const>(pImpl->dim, &bombs[0], &adjacent[0]);
+
+		// The mirror is hidden since the reset
+		for (CellIterator it = begin(); it != end(); ++it)
 		{
-			(bombs[x][y] == 1) ? pImpl->matrix[x][y] = new Bomb(x, y) : pImpl->matrix[x][y] = new Field(x, y);
+			if (it->getStatus() != FS_HIDDEN)
+				pImpl->statuses.set(it->getPosition().X, it->getPosition().Y, it->getStatus());
+		}
+	}
+	return MatrixClone(pImpl->layout, pImpl->statuses, pImpl->status, pImpl->unhidden, pImpl->marked);
+}
+
+void Matrix::setParallelRevealThreshold(uint32_t fields)
+{
+	pImpl->revealThreshold = fields;
+}
+
+uint32_t Matrix::getParallelRevealThreshold() const
+{
+	return pImpl->revealThreshold;
+}
+
+Openings const& Matrix::getOpenings() const
+{
+	return pImpl->label();
+}
 
-			pImpl->matrix[x][y]->addObserver(pImpl);
+uint8_t Matrix::reveal(uint16_t x, uint16_t y)
+{
+	Field& field = (*this)[x][y];
+
+	// An untouched opening reveals the same fields as the cascade
+	uint32_t const index = (uint32_t) y * cols + x;
+	uint32_t const opening = pImpl->adjacent[index] ? NO_OPENING : pImpl->label().getLabel(index);
+	if (opening != NO_OPENING && !pImpl->blocked[opening])
+	{
+		// The clicked field first, like the cascade
+		field.open();
+		pImpl->open(opening);
+		return 0;
+	}
+
+	if (!pImpl->pool)
+		return field.reveal();
+
+	/* Bombs, marked or already revealed fields and fields with adjacent bombs
+	 * don't cascade. Field::reveal() is a no-op for them now and returns the result. */
+	if (!field.open())
+		return field.reveal();
+
+	pImpl->cascade(field);
+	return field.getAdjacentBombs();
+}
+
+uint8_t Matrix::reveal(uint16_t x, uint16_t y, Waves& waves)
+{
+	Field& field = (*this)[x][y];
+	std::vector<uint32_t>& fields = waves.fields;
+	std::vector<uint32_t>& starts = waves.starts;
+	fields.clear();
+	starts.clear();
+
+	bool const revealable = isRevealable(field);
+	bool const expand = field.open();
+	if (revealable)
+	{
+		starts.push_back(0);
+		fields.push_back((uint32_t) y * cols + x);
+		starts.push_back(1);
+	}
+
+	// Each wave opens the revealable neighbours of its fields without adjacent bombs
+	for (uint32_t begin = 0, end = expand ? 1 : 0; begin != end; begin = end, end = fields.size())
+	{
+		for (uint32_t i = begin; i < end; ++i)
+		{
+			Field& f = *cells[fields[i]];
+			if (f.getAdjacentBombs())
+				continue;
+			Position const& q = f.getPosition();
+			Field* const* c = grid.cell(q.X, q.Y);
+			int32_t const* o = grid.offsets(q.Y);
+			for (uint8_t n = grid.getNeighbourCount(); n-- > 0;)
+			{
+				Field* const neighbour = c[o[n]];
+				if (!isRevealable(*neighbour))
+					continue;
+				neighbour->open();
+				Position const& p = neighbour->getPosition();
+				fields.push_back((uint32_t) p.Y * cols + p.X);
+			}
 		}
+		if (fields.size() != end)
+			starts.push_back(fields.size());
 	}
 
-	//Set links to neighbours
-	for (uint16_t y = 0; y < dimY; y++)
+	// A no-op now that returns the result
+	return field.reveal();
+}
+
+uint32_t Matrix::apply(Action const* actions, uint32_t count, uint8_t* results)
+{
+	// Validate all actions in one pass, the actions below access the fields unchecked
+	bool valid = true;
+	for (uint32_t i = 0; i < count; ++i)
+		valid &= actions[i].x < cols && actions[i].y < rows && actions[i].type <= AT_CYCLEMARK;
+
+	size_t const size = (size_t) cols * rows;
+	if (pImpl->original.size() != size)
+		pImpl->original.assign(size, NOT_CHANGED);
+
+	Impl::Batch batch(*pImpl);
+	uint32_t executed = 0;
+	uint32_t i = 0;
+	for (; i < count && pImpl->status <= GS_RUNNING; ++i)
 	{
-		for (uint16_t x = 0; x < dimX; x++)
+		Action const& a = actions[i];
+		uint8_t result;
+		if (!valid && (a.x >= cols || a.y >= rows || a.type > AT_CYCLEMARK))
+			result = AR_INVALID;
+		else if (a.type == AT_REVEAL)
+			result = reveal(a.x, a.y);
+		else
 		{
-			if (x - 1 >= 0 && y - 1 >= 0)
-				pImpl->matrix[x][y]->addNeighbour(pImpl->matrix[x - 1][y - 1]);
-			if (y - 1 >= 0)
-				pImpl->matrix[x][y]->addNeighbour(pImpl->matrix[x][y - 1]);
-			if (x + 1 < dimX && y - 1 >= 0)
-				pImpl->matrix[x][y]->addNeighbour(pImpl->matrix[x + 1][y - 1]);
-			if (x + 1 < dimX)
-				pImpl->matrix[x][y]->addNeighbour(pImpl->matrix[x + 1][y]);
-			if (x + 1 < dimX && y + 1 < dimY)
-				pImpl->matrix[x][y]->addNeighbour(pImpl->matrix[x + 1][y + 1]);
-			if (y + 1 < dimY)
-				pImpl->matrix[x][y]->addNeighbour(pImpl->matrix[x][y + 1]);
-			if (x - 1 >= 0 && y + 1 < dimY)
-				pImpl->matrix[x][y]->addNeighbour(pImpl->matrix[x - 1][y + 1]);
-			if (x - 1 >= 0)
-				pImpl->matrix[x][y]->addNeighbour(pImpl->matrix[x - 1][y]);
+			Field& field = at(a.x, a.y);
+			field.cycleMark();
+			result = (uint8_t) field.getStatus();
 		}
+		executed += result != AR_INVALID;
+		if (results)
+			results[i] = result;
 	}
+	if (results)
+		std::fill(results + i, results + count, AR_SKIPPED);
 
-	//Increment counters for adjacent bombs
-	for (uint16_t y = 0; y < dimY; y++)
+	batch.notify();
+	return executed;
+}
+
+Matrix::Impl::Batch::Batch(Impl& impl) :
+		impl(impl), oldStatus(impl.status), oldMarked(impl.marked), notified(false)
+{
+	impl.batching = true;
+}
+
+Matrix::Impl::Batch::~Batch()
+{
+	if (notified)
+		return;
+	// An action threw, its exception is on the way already
+	impl.batching = false;
+	try
 	{
-		for (uint16_t x = 0; x < dimX; x++)
-			pImpl->matrix[x][y]->informNeighbours();
+		impl.notifyBatch(oldStatus, oldMarked);
+	} catch (...)
+	{
+		impl.dropBatch();
 	}
+}
 
-	//Delete the help matrix
-	for (uint16_t x = 0; x < dimX; x++)
-		delete[] bombs[x];
-	delete[] bombs;
+void Matrix::Impl::Batch::notify()
+{
+	notified = true;
+	impl.batching = false;
+	try
+	{
+		impl.notifyBatch(oldStatus, oldMarked);
+	} catch (...)
+	{
+		impl.dropBatch();
+		throw;
+	}
+}
 
-	for (std::list<MatrixObserver*>::const_iterator it = pImpl->observers.begin(); it != pImpl->observers.end(); ++it)
+void Matrix::Impl::dropBatch()
+{
+	for (std::vector<uint32_t>::const_iterator it = changed.begin(); it != changed.end(); ++it)
+		original[*it] = NOT_CHANGED;
+	changed.clear();
+}
+
+void Matrix::Impl::notifyBatch(GAMESTATUS oldStatus, uint32_t oldMarked)
+{
+	for (std::vector<uint32_t>::const_iterator it = changed.begin(); it != changed.end(); ++it)
 	{
-		(*it)->onGameStatusChanged(*this, pImpl->status);
+		Field const& field = *backRef->cells[*it];
+		FIELDSTATUS const newStatus = field.getStatus();
+		bool const report = original[*it] != newStatus;
+		original[*it] = NOT_CHANGED;
+		// E.g. marked and unmarked again
+		if (!report)
+			continue;
+
+		SIGNAL_FIELDSTATUSCHANGED(*backRef, field, newStatus);
+#if SIGNALS
+		backRef->signalFieldStatusChanged(field, newStatus);
+#endif
 	}
-#if BOOST_SIGNALS
-	signalGameStatusChanged(*this, pImpl->status);
+	changed.clear();
+
+	if (marked != oldMarked)
+	{
+		SIGNAL_REMAININGBOMBSCHANGED(*backRef, (int32_t) dim.getBombs() - (int32_t) marked);
+#if SIGNALS
+		backRef->signalRemainingBombsChanged(*backRef, (int32_t) dim.getBombs() - (int32_t) marked);
 #endif
+	}
+
+	if (status != oldStatus)
+	{
+		SIGNAL_GAMESTATUSCHANGED(*backRef, status);
+#if SIGNALS
+		backRef->signalGameStatusChanged(*backRef, status);
+#endif
+	}
 }
 
 GAMESTATUS Matrix::getStatus() const
@@ -258,33 +710,176 @@ GAMESTATUS Matrix::getStatus() const
 
 int32_t Matrix::getRemainingBombs() const
 {
-	return pImpl->dim.getBombs() - pImpl->marked;
+	return (int32_t) pImpl->dim.getBombs() - (int32_t) pImpl->marked;
 }
 
 Proxy Matrix::operator[](uint16_t x) const throw (IndexOutOfBoundsException)
 {
-	if (x >= pImpl->dim.getX())
-		throw IndexOutOfBoundsException(x, pImpl->dim.getX(), 'X');
+	if (x >= cols)
+		throw IndexOutOfBoundsException(x, cols, 'X');
 	else
-		return Proxy(pImpl->matrix[x], pImpl->dim.getY());
+		return Proxy(cells + x, rows, cols);
 }
 
 void Matrix::Impl::deleteMatrix()
 {
+	Field**& matrix = backRef->cells;
+
 	//Free up all resources
 	if (matrix != 0)
 	{
-		for (uint16_t y = 0; y < dim.getY(); y++)
+		// The memory is given back by the arenas
+		for (size_t i = 0; i < (size_t) backRef->cols * backRef->rows; i++)
+			matrix[i]->~Field();
+		matrix = 0;
+		claims = 0;
+		backRef->grid.clear();
+		backRef->cols = 0;
+		backRef->rows = 0;
+	}
+	for (size_t a = 0; a < arenas.size(); ++a)
+		arenas[a]->release();
+}
+
+void Matrix::Impl::prepareArenas()
+{
+	size_t const threads = pool ? pool->getThreadCount() : 1;
+	if (arenas.size() == threads && arenas[0]->getUpstream() == upstream)
+		return;
+
+	arenas.clear();
+	for (size_t a = 0; a < threads; ++a)
+		arenas.push_back(std::unique_ptr<MonotonicResource>(new MonotonicResource(upstream)));
+}
+
+Openings const& Matrix::Impl::label()
+{
+	if (labelled)
+		return openings;
+
+	Grid const& grid = backRef->grid;
+	if (bombs.empty())
+		openings.clear();
+	else
+		openings.build(grid, &adjacent[0], &bombs[0], fieldTile);
+
+	// The game may already be running
+	blocked.assign(openings.getCount(), 0);
+	for (uint32_t i = 0; i < bombs.size(); ++i)
+	{
+		uint32_t const opening = openings.getLabel(i);
+		if (opening == NO_OPENING)
+			continue;
+		FIELDSTATUS const s = backRef->cells[i]->getStatus();
+		blocked[opening] += FS_MARKED == s || FS_UNHIDDEN == s;
+	}
+
+	labelled = true;
+	return openings;
+}
+
+void Matrix::Impl::open(uint32_t opening)
+{
+	// In the order of the layout. Marked or revealed numbered fields are skipped by Field::open()
+	for (uint32_t const* it = openings.begin(opening); it != openings.end(opening); ++it)
+		backRef->cells[*it]->open();
+}
+
+void Matrix::Impl::cascade(Field const& field)
+{
+	// Serially like Field::reveal() until the area turns out to be large
+	std::vector<Field*> const& rest = backRef->grid.cascade(field, revealThreshold);
+	if (rest.empty())
+		return;
+
+	// Continue with the neighbours of the fields that were not expanded yet
+	std::vector<Field*> seeds;
+	for (std::vector<Field*>::const_iterator it = rest.begin(); it != rest.end(); ++it)
+		backRef->grid.pushNeighbours(seeds, **it);
+	expand(seeds);
+}
+
+void Matrix::Impl::expand(std::vector<Field*> const& seeds)
+{
+	Grid const& grid = backRef->grid;
+	uint32_t const cols = backRef->cols;
+	uint32_t const tilesPerRow = (cols + TILE_SIZE - 1) / TILE_SIZE;
+	uint8_t const neighbours = grid.getNeighbourCount();
+	unsigned const threads = pool->getThreadCount();
+
+	if (!claims)
+	{
+		size_t const size = (size_t) cols * backRef->rows;
+		claims = static_cast<std::atomic<uint8_t>*>(arenas[0]->allocate(size * sizeof(std::atomic<uint8_t>),
+				alignof(std::atomic<uint8_t>)));
+		for (size_t i = 0; i < size; ++i)
+			new (&claims[i]) std::atomic<uint8_t>(0);
+	}
+
+	std::vector<WorkQueue> queues(threads);
+	std::vector<std::vector<Field*> > found(threads);
+	// Count of claimed fields that are not expanded yet
+	std::atomic<size_t> pending(0);
+
+	/* The statuses are not modified until all threads are done, the border is never revealable.
+	 * The first thread that claims a revealable field hands it to the owner of its tile.
+	 * The claim is keyed by the position, because a torus holds the same field several times. */
+	auto claim = [&](Field* f)
+	{
+		if (!isRevealable(*f))
+			return;
+		Position const& p = f->getPosition();
+		if (claims[(size_t) p.Y * cols + p.X].exchange(1, std::memory_order_relaxed) == 0)
 		{
-			for (uint16_t x = 0; x < dim.getX(); x++)
+			pending.fetch_add(1);
+			uint32_t tile = p.Y / TILE_SIZE * tilesPerRow + p.X / TILE_SIZE;
+			queues[tile % threads].push(f);
+		}
+	};
+
+	for (std::vector<Field*>::const_iterator it = seeds.begin(); it != seeds.end(); ++it)
+		claim(*it);
+
+	pool->run(threads, [&](size_t, unsigned thread)
+	{
+		std::vector<Field*>& mine = found[thread];
+		Field* f;
+		for (;;)
+		{
+			bool got = queues[thread].pop(f);
+			for (unsigned t = 1; !got && t < threads; ++t)
+				got = queues[(thread + t) % threads].steal(f);
+
+			if (!got)
+			{
+				if (pending.load() == 0)
+					return;
+				std::this_thread::yield();
+				continue;
+			}
+
+			mine.push_back(f);
+			if (f->getAdjacentBombs() == 0)
 			{
-				delete matrix[x][y];
+				Position const& p = f->getPosition();
+				Field* const* center = grid.cell(p.X, p.Y);
+				int32_t const* offsets = grid.offsets(p.Y);
+				for (uint8_t n = 0; n < neighbours; ++n)
+					claim(center[offsets[n]]);
 			}
+			pending.fetch_sub(1);
+		}
+	});
+
+	// Merge: Reveal the found fields and inform the observers on this thread
+	for (unsigned t = 0; t < threads; ++t)
+	{
+		for (std::vector<Field*>::const_iterator it = found[t].begin(); it != found[t].end(); ++it)
+		{
+			Position const& p = (*it)->getPosition();
+			claims[(size_t) p.Y * cols + p.X].store(0, std::memory_order_relaxed);
+			(*it)->open();
 		}
-		for (uint16_t x = 0; x < dim.getX(); x++)
-			delete[] matrix[x];
-		delete[] matrix;
-		matrix = 0;
 	}
 }
 
@@ -292,6 +887,30 @@ void Matrix::Impl::onFieldStatusChanged(Field const& field, FIELDSTATUS newStatu
 {
 	GAMESTATUS old = status;
 
+	Position const& p = field.getPosition();
+	if (batching)
+	{
+		uint32_t const index = (uint32_t) p.Y * dim.getX() + p.X;
+		if (original[index] == NOT_CHANGED)
+		{
+			original[index] = previousStatus(newStatus);
+			changed.push_back(index);
+		}
+	}
+	if (layout)
+		statuses.set(p.X, p.Y, newStatus);
+
+	/* A marked or revealed field stops the cascade. Fields without adjacent bombs are
+	 * marked from hidden, queried from marked and revealed from hidden or queried. */
+	uint32_t const opening = labelled ? openings.getLabel((uint32_t) p.Y * dim.getX() + p.X) : NO_OPENING;
+	if (opening != NO_OPENING)
+	{
+		if (FS_MARKED == newStatus || FS_UNHIDDEN == newStatus)
+			++blocked[opening];
+		else if (FS_QUERIED == newStatus)
+			--blocked[opening];
+	}
+
 	// Log field status
 	switch (newStatus)
 	{
@@ -319,29 +938,33 @@ void Matrix::Impl::onFieldStatusChanged(Field const& field, FIELDSTATUS newStatu
 
 	if (status != GS_LOST)
 	{
-		if (unhidden == ((dim.getX() * dim.getY()) - dim.getBombs()) && marked == dim.getBombs())
+		if (unhidden == (((uint32_t) dim.getX() * dim.getY()) - dim.getBombs()) && marked == dim.getBombs())
 			status = GS_WON;
 		else
 			status = GS_RUNNING;
 	}
 
+	// Reported by Matrix::apply() at the end of the batch
+	if (batching)
+		return;
+
 	SIGNAL_FIELDSTATUSCHANGED(*backRef, field, newStatus);
-#if BOOST_SIGNALS
+#if SIGNALS
 	backRef->signalFieldStatusChanged(field, newStatus);
 #endif
 
 	if (FS_MARKED == newStatus || FS_QUERIED == newStatus)
 	{
-		SIGNAL_REMAININGBOMBSCHANGED(*backRef, dim.getBombs() - marked);
-#if BOOST_SIGNALS
-		backRef->signalRemainingBombsChanged(*backRef, dim.getBombs() - marked);
+		SIGNAL_REMAININGBOMBSCHANGED(*backRef, (int32_t) dim.getBombs() - (int32_t) marked);
+#if SIGNALS
+		backRef->signalRemainingBombsChanged(*backRef, (int32_t) dim.getBombs() - (int32_t) marked);
 #endif
 	}
 
 	if (status != old)
 	{
 		SIGNAL_GAMESTATUSCHANGED(*backRef, status);
-#if BOOST_SIGNALS
+#if SIGNALS
 		backRef->signalGameStatusChanged(*backRef, status);
 #endif
 	}
@@ -350,7 +973,7 @@ void Matrix::Impl::onFieldStatusChanged(Field const& field, FIELDSTATUS newStatu
 void Matrix::Impl::onFieldDelete(Field const& field)
 {
 	SIGNAL_FIELDDELETE(*backRef, field);
-#if BOOST_SIGNALS
+#if SIGNALS
 	backRef->signalFieldDelete(field);
 #endif
 }
@@ -13,13 +13,16 @@
 #define MATRIX_H_
 
 #include <stdint.h>
+#include <vector>
 
 #include "config.hpp"
 #include "field.hpp"
+#include "grid.hpp"
+#include "iterators.hpp"
 #include "tools.hpp"
 
-#if BOOST_SIGNALS
-#include <boost/signals2.hpp>
+#if SIGNALS
+#include "signal.hpp"
 #endif
 
 /// Namespace of the library.
@@ -28,28 +31,30 @@ namespace msm
 
 /** This class holds the configuration of a Matrix.
  * X and Y is the count of the fields, not the index.
+ * The \ref #TOPOLOGY "topology" defines the neighbours of the fields.
  * The setters ensures that the count of bombs is never higher than the count of fields. */
 class Dimensions
 {
 public:
 	/// Constuctor that initializes all member to zero.
 	Dimensions() :
-			x(0), y(0), bombs(0)
+			x(0), y(0), bombs(0), topology(TP_PLANE)
 	{
 	}
 	/** Constuctor.
 	 * \param x The horizontal count of fields.
 	 * \param y The vertical count of fields.
 	 * \param bombs The count of bombs.
+	 * \param topology The topology of the matrix.
 	 */
-	Dimensions(uint16_t x, uint16_t y, uint16_t bombs);
+	Dimensions(uint16_t x, uint16_t y, uint32_t bombs, TOPOLOGY topology = TP_PLANE);
 	/// Get the bomb count.
-	uint16_t getBombs() const
+	uint32_t getBombs() const
 	{
 		return bombs;
 	}
 	/// Sets the bomb count.
-	void setBombs(uint16_t bombs);
+	void setBombs(uint32_t bombs);
 	/// Returns the count of \ref Field "fields" in the horizontal direction.
 	uint16_t getX() const
 	{
@@ -64,10 +69,23 @@ public:
 	}
 	/// Sets the count of the \ref Field "fields" in the vertical direction.
 	void setY(uint16_t y);
+	/** Returns the \ref #TOPOLOGY "topology".
+	 * A torus needs at least three fields in each direction, otherwise a field would be its
+	 * own or a double neighbour. A smaller torus is a plane. */
+	TOPOLOGY getTopology() const
+	{
+		return topology == TP_TORUS && (x < 3 || y < 3) ? TP_PLANE : topology;
+	}
+	/// Sets the \ref #TOPOLOGY "topology".
+	void setTopology(TOPOLOGY topology)
+	{
+		this->topology = topology;
+	}
 private:
 	uint16_t x;
 	uint16_t y;
-	uint16_t bombs;
+	uint32_t bombs;
+	TOPOLOGY topology;
 };
 
 /// The current status of the game.
@@ -86,7 +104,97 @@ enum GAMESTATUS
  */
 char const* toString(GAMESTATUS status);
 
+/// The type of an \ref Action.
+enum ACTIONTYPE
+{
+	AT_REVEAL, //!< Reveal the field like Matrix::reveal().
+	AT_CYCLEMARK //!< Cycle the mark of the field like Field::cycleMark().
+};
+
+/// The order of the fields in memory (see \ref Matrix::setLayout()).
+enum LAYOUT
+{
+	LT_ROWS, //!< Row by row.
+	LT_TILES //!< Tile by tile, each tile of \ref LAYOUT_TILE x \ref LAYOUT_TILE fields row by row.
+};
+
+/// The edge length of the tiles of \ref LT_TILES.
+const uint16_t LAYOUT_TILE = 8;
+
+/// A move for \ref Matrix::apply().
+struct Action
+{
+	/// Constructor.
+	Action(ACTIONTYPE type, uint16_t x, uint16_t y) :
+			type(type), x(x), y(y)
+	{
+	}
+	/// The action.
+	ACTIONTYPE type;
+	/// The X-coordinate inside the matrix.
+	uint16_t x;
+	/// The Y-coordinate inside the matrix.
+	uint16_t y;
+};
+
+/// Result of an \ref Action with a position outside of the matrix or an unknown type.
+const uint8_t AR_INVALID = 0xFE;
+/// Result of an \ref Action that was not executed because the game was over.
+const uint8_t AR_SKIPPED = 0xFF;
+
 class Matrix;
+class MatrixClone;
+class MemoryResource;
+class Openings;
+class WeightMap;
+
+/**
+ * The fields revealed by one \ref Matrix::reveal(uint16_t, uint16_t, Waves&) "reveal",
+ * grouped by their distance from the revealed field, e.g. to animate a cascade outward
+ * from the click frame by frame. Wave 0 holds the revealed field, wave n the fields that
+ * are n steps away along the revealed area.
+ */
+class Waves
+{
+public:
+	/// Create an empty instance.
+	Waves()
+	{
+	}
+
+	/// Get the count of waves. 0 if nothing was revealed.
+	uint32_t getCount() const
+	{
+		return starts.empty() ? 0 : starts.size() - 1;
+	}
+	/// Get the count of fields of a wave.
+	uint32_t getSize(uint32_t wave) const
+	{
+		return starts[wave + 1] - starts[wave];
+	}
+	/// Get the count of fields of all waves.
+	uint32_t getTotal() const
+	{
+		return fields.size();
+	}
+	/// Get the row-major indices of the fields of a wave.
+	uint32_t const* begin(uint32_t wave) const
+	{
+		return &fields[0] + starts[wave];
+	}
+	/// Get the end of the fields of a wave.
+	uint32_t const* end(uint32_t wave) const
+	{
+		return &fields[0] + starts[wave + 1];
+	}
+
+private:
+	friend class Matrix;
+
+	/// The first entry in fields of each wave, one more for the end of the last.
+	std::vector<uint32_t> starts;
+	std::vector<uint32_t> fields;
+};
 
 /// Interface for Matrix observers
 struct MatrixObserver
@@ -134,6 +242,10 @@ struct MatrixObserver
  * This class holds the logic to build and manipulate the matrix.
  * It overloads the 2-dimensional array-operator ([][]) to provide convenient
  * access to the \ref Field "fields".
+ * The fields are stored in row-major order. Use the iterators (\ref begin(), \ref region(),
+ * \ref frontier(), \ref neighbours()) to walk the fields in memory order.
+ * The neighbours of the fields are computed by a \ref Grid according to the
+ * \ref #TOPOLOGY "topology" of the \ref Dimensions.
  */
 class Matrix
 {
@@ -156,10 +268,111 @@ public:
 
 	/// Returns the currently used \ref Dimensions.
 	Dimensions const& getDimensions() const;
-	/// Reset Matrix with the currently configured Dimensions.
+	/// Reset Matrix with the currently configured Dimensions and a new random layout.
 	void reset();
-	/// Reset Matrix with new Dimensions.
+	/// Reset Matrix with new Dimensions and a new random layout.
 	void reset(Dimensions const& dimensions);
+	/** Reset Matrix with new Dimensions and a reproducible layout.
+	 * The same dimensions and seed always produce the same layout,
+	 * independent of the \ref setThreadCount() "thread count".
+	 * \param dimensions The new dimensions.
+	 * \param seed The seed for the bomb placement. */
+	void reset(Dimensions const& dimensions, uint32_t seed);
+	/** Reset Matrix with new Dimensions and a non-uniform layout (see \ref placeWeightedBombs()).
+	 * The same dimensions, seed and weights always produce the same layout.
+	 * \note The bombs of the dimensions are reduced to the count of fields with a positive
+	 * weight if there are less. \ref getDimensions() returns the dimensions actually used.
+	 * \param dimensions The new dimensions.
+	 * \param seed The seed for the bomb placement.
+	 * \param weights The weights. Must have the size of the dimensions.
+	 * \throw std::invalid_argument If the size of the weights doesn't match. */
+	void reset(Dimensions const& dimensions, uint32_t seed, WeightMap const& weights);
+	/// Get the seed of the current layout.
+	uint32_t getSeed() const;
+	/** Set the count of threads used to build the matrix on \ref reset().
+	 * The matrix is split into bands of rows that are processed in parallel.
+	 * \param threads The count of threads. 0 for one per hardware thread, 1 for serial. */
+	void setThreadCount(unsigned threads);
+	/// Get the count of threads used on \ref reset() and \ref reveal().
+	unsigned getThreadCount() const;
+	/** Set the source of the memory for the fields.
+	 * The fields are allocated from \ref MonotonicResource "arenas", one per
+	 * \ref setThreadCount() "thread", that take large chunks from the resource and give
+	 * them back in one shot on the next reset. Takes effect on the next \ref reset().
+	 * \note The resource must outlive the matrix. It must be thread-safe when more than
+	 * one thread is configured.
+	 * \note A \ref HugePageResource keeps the TLB misses of cascades over giant boards low.
+	 * \param resource The resource. 0 for \ref newDeleteResource(). */
+	void setMemoryResource(MemoryResource* resource);
+	/// Get the source of the memory for the fields.
+	MemoryResource* getMemoryResource() const;
+	/** Set the order of the fields in memory. Takes effect on the next \ref reset().
+	 * With \ref LT_ROWS the fields above and below a field are a whole row away, so a
+	 * cascade over a wide board touches three distant parts of the memory for each row.
+	 * With \ref LT_TILES most neighbours of a field are stored close to it. The position
+	 * of a field and the result of all methods are the same for both layouts.
+	 * \param layout The layout. The default is \ref LT_ROWS. */
+	void setLayout(LAYOUT layout);
+	/// Get the order of the fields in memory.
+	LAYOUT getLayout() const;
+	/** Set the count of fields that are revealed serially, before \ref reveal()
+	 * searches the rest of the area in parallel.
+	 * \param fields The count of fields. */
+	void setParallelRevealThreshold(uint32_t fields);
+	/// Get the count of fields that are revealed serially by \ref reveal().
+	uint32_t getParallelRevealThreshold() const;
+
+	/** Create a copy-on-write clone of the current game (see \ref MatrixClone).
+	 * The first clone after a reset builds the shared layout, afterwards cloning costs O(1).
+	 * \return The clone. */
+	MatrixClone clone() const;
+
+	/** Get the \ref Openings "openings" of the current layout.
+	 * They are labelled on first use after a \ref reset(), by this method or by \ref reveal(). */
+	Openings const& getOpenings() const;
+
+	/** Reveal a field with the same result as Field::reveal().
+	 * A field of an \ref Openings "opening" reveals the precomputed fields of the opening
+	 * in the order of the \ref setLayout() "layout", unless a field of the opening was
+	 * already marked or revealed.
+	 * When more than one \ref setThreadCount() "thread" is configured and the revealed
+	 * area grows beyond the \ref setParallelRevealThreshold() "threshold", the rest of
+	 * the area is searched in parallel. The matrix is split into tiles and each thread
+	 * expands the fields of its tiles, idle threads steal the work of the others.
+	 * Afterwards the found fields are revealed and the observers are informed on the
+	 * calling thread.
+	 * \note The final board is always the same as with Field::reveal(), only the order
+	 * of the notifications of an opening or of the parallel part differs.
+	 * \param x The X-coordinate inside the matrix.
+	 * \param y The Y-coordinate inside the matrix.
+	 * \return The count of adjacent bombs or \ref FS_BOMB "bomb status".
+	 * \throws IndexOutOfBoundsException If the position is outside of the matrix.
+	 */
+	uint8_t reveal(uint16_t x, uint16_t y);
+	/** Reveal a field like Field::reveal(), but breadth first, and report the revealed
+	 * fields grouped by their distance from the field. The waves are collected in the
+	 * same pass that reveals the fields, and the observers are informed wave by wave too.
+	 * Neither the \ref Openings "openings" nor more \ref setThreadCount() "threads" are used.
+	 * \param x The X-coordinate inside the matrix.
+	 * \param y The Y-coordinate inside the matrix.
+	 * \param waves Receives the revealed fields. Empty if the field was not revealable.
+	 * \return The count of adjacent bombs or \ref FS_BOMB "bomb status".
+	 * \throws IndexOutOfBoundsException If the position is outside of the matrix.
+	 */
+	uint8_t reveal(uint16_t x, uint16_t y, Waves& waves);
+	/** Execute a batch of actions in order, e.g. the moves of a bot or a replay.
+	 * All positions are validated in one pass before the first action is executed.
+	 * The observers are not informed per action but once for the whole batch: Each
+	 * field that changed is reported once with its final status, followed by at most one
+	 * change of the remaining bombs and one change of the game status.
+	 * The batch stops when the game is won or lost.
+	 * \note The observers of the fields itself are still informed per change.
+	 * \param actions The actions.
+	 * \param count The count of actions.
+	 * \param results Optional, receives one result per action: The result of \ref reveal(),
+	 * the new \ref #FIELDSTATUS "status" after a mark, \ref AR_INVALID or \ref AR_SKIPPED.
+	 * \return The count of executed actions. */
+	uint32_t apply(Action const* actions, uint32_t count, uint8_t* results = 0);
 	/// Get the current \ref #GAMESTATUS "game status".
 	GAMESTATUS getStatus() const;
 	/// Get the remaining bomb count.
@@ -172,7 +385,108 @@ public:
 	 */
 	Proxy operator[](uint16_t x) const throw (IndexOutOfBoundsException);
 
-#if BOOST_SIGNALS
+	/** Checked field access without exceptions.
+	 * \param x The X-coordinate inside the matrix.
+	 * \param y The Y-coordinate inside the matrix.
+	 * \return A pointer to the \ref Field "field" or 0 if the position is outside of the matrix.
+	 */
+	Field* tryGet(uint16_t x, uint16_t y) const
+	{
+		return (x < cols && y < rows) ? cells[(size_t) y * cols + x] : 0;
+	}
+
+	/** Unchecked field access.
+	 * Use this in loops whose bounds are already validated against \ref getDimensions().
+	 * \warning Accessing a position outside of the matrix is undefined behaviour.
+	 * \param x The X-coordinate inside the matrix.
+	 * \param y The Y-coordinate inside the matrix.
+	 * \return Reference to the \ref Field "field".
+	 */
+	Field& at(uint16_t x, uint16_t y) const
+	{
+		return *cells[(size_t) y * cols + x];
+	}
+
+	/** Get the neighbours of a field in the topology of the matrix.
+	 * \note The range is empty when the position is outside of the matrix.
+	 * \param x The X-coordinate inside the matrix.
+	 * \param y The Y-coordinate inside the matrix.
+	 * \return A range over the existing neighbours.
+	 */
+	NeighbourRange neighbours(uint16_t x, uint16_t y) const
+	{
+		if (x < cols && y < rows)
+		{
+			Field* const* center = grid.cell(x, y);
+			int32_t const* offsets = grid.offsets(y);
+			uint8_t count = grid.getNeighbourCount();
+			return NeighbourRange(NeighbourIterator(center, offsets, 0, count),
+					NeighbourIterator(center, offsets, count, count));
+		}
+		return NeighbourRange(NeighbourIterator(0, 0, 0, 0), NeighbourIterator(0, 0, 0, 0));
+	}
+
+	/// Iterator to the first field in row-major order.
+	CellIterator begin() const
+	{
+		return CellIterator(cells);
+	}
+
+	/// Iterator behind the last field in row-major order.
+	CellIterator end() const
+	{
+		return CellIterator(cells + (size_t) cols * rows);
+	}
+
+	/// All fields in row-major order.
+	CellRange all() const
+	{
+		return CellRange(begin(), end());
+	}
+
+	/** Get a rectangular region of the matrix.
+	 * The region is clipped to the matrix.
+	 * \param x The left column.
+	 * \param y The top row.
+	 * \param width The count of columns.
+	 * \param height The count of rows.
+	 * \return A range over the fields of the region, row by row.
+	 */
+	RegionRange region(uint16_t x, uint16_t y, uint16_t width, uint16_t height) const
+	{
+		if (x >= cols || y >= rows || width == 0 || height == 0)
+			return RegionRange(RegionIterator(cells, cols, 1, 0), RegionIterator(cells, cols, 1, 0));
+		if (width > cols - x)
+			width = cols - x;
+		if (height > rows - y)
+			height = rows - y;
+		Field* const* first = cells + (size_t) y * cols + x;
+		return RegionRange(RegionIterator(first, cols, width, 0),
+				RegionIterator(first + (size_t) height * cols, cols, width, 0));
+	}
+
+	/** Get the frontier of the revealed area (see \ref FrontierIterator).
+	 * \return A range over the frontier in row-major order.
+	 */
+	FrontierRange frontier() const
+	{
+		return FrontierRange(FrontierIterator(&grid, cells, cols, rows, 0),
+				FrontierIterator(&grid, cells, cols, rows, (size_t) cols * rows));
+	}
+
+	/** Call a function for every field without any bounds check.
+	 * The fields are visited in storage (row-major) order.
+	 * \param func A callable with the signature void(Field&).
+	 */
+	template<typename Func>
+	void forEach(Func func) const
+	{
+		Field* const* end = cells + (size_t) cols * rows;
+		for (Field* const* it = cells; it != end; ++it)
+			func(**it);
+	}
+
+#if SIGNALS
 	/**
 	 * \var signalFieldStatusChanged
 	 * Signal that is emitted on change of the \ref #FIELDSTATUS "status" of a field.
@@ -188,8 +502,8 @@ public:
 	 * instead of this one.
 	 */
 
-	boost::signals2::signal<void(Field const&, FIELDSTATUS)> signalFieldStatusChanged;
-	boost::signals2::signal<void(Field const&)> signalFieldDelete;
+	Signal<void(Field const&, FIELDSTATUS)> signalFieldStatusChanged;
+	Signal<void(Field const&)> signalFieldDelete;
 
 	/**
 	 * \var signalGameStatusChanged
@@ -204,19 +518,30 @@ public:
 	 * negative, when the player marked more fields than bombs are present in the game.
 	 */
 
-	boost::signals2::signal<void(Matrix const&, GAMESTATUS)> signalGameStatusChanged;
-	boost::signals2::signal<void(Matrix const&, int32_t)> signalRemainingBombsChanged;
+	Signal<void(Matrix const&, GAMESTATUS)> signalGameStatusChanged;
+	Signal<void(Matrix const&, int32_t)> signalRemainingBombsChanged;
 #endif
 
 protected:
 	Impl* pImpl;
 
+	/// The fields in row-major order (cells[y * cols + x]). Owned by the Impl.
+	Field** cells;
+	/// Count of columns in cells.
+	uint16_t cols;
+	/// Count of rows in cells.
+	uint16_t rows;
+	/// The neighbourhood of the cells.
+	Grid grid;
+
 private:
 	/* Copy feature removed...
 	 * The deep copy is too error prone
 	 * and not worthwhile. */
 	Matrix(Matrix const& cp);
 	Matrix& operator=(Matrix const& cp);
+
+	void build(Dimensions const& dimensions, uint32_t seed, WeightMap const* weights);
 };
 
 } //namespace msm
@@ -0,0 +1,218 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file matrixClone.cpp
+ *
+ * Implementation of \ref matrixClone.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "matrixClone.hpp"
+
+#include <atomic>
+#include <cstring>
+
+namespace msm
+{
+
+namespace
+{
+/** True if the pointer is the only owner of its object, so it may be changed in place.
+ * use_count() is a relaxed load. The fence pairs with the release of the last other owner,
+ * which may have read the object on another thread, so that read happens before the change. */
+template<typename T>
+bool isUnique(std::shared_ptr<T> const& p)
+{
+	if (p.use_count() != 1)
+		return false;
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return true;
+}
+}
+
+TileStore::TileStore() :
+		table(std::make_shared<Table>()), tilesPerRow(0)
+{
+}
+
+void TileStore::reset(uint16_t cols, uint16_t rows)
+{
+	tilesPerRow = (cols + TILE_EDGE - 1) / TILE_EDGE;
+	size_t const tiles = (size_t) tilesPerRow * ((rows + TILE_EDGE - 1) / TILE_EDGE);
+
+	// All tiles share the same hidden one until they are modified, all chunks the same one
+	std::shared_ptr<Tile> hidden = std::make_shared<Tile>();
+	std::memset(hidden->fields, FS_HIDDEN, sizeof(hidden->fields));
+	std::shared_ptr<Chunk> chunk = std::make_shared<Chunk>();
+	for (uint16_t i = 0; i < CHUNK_TILES; ++i)
+		chunk->tiles[i] = hidden;
+	table = std::make_shared<Table>((tiles + CHUNK_TILES - 1) / CHUNK_TILES, chunk);
+}
+
+void TileStore::set(uint16_t x, uint16_t y, uint8_t status)
+{
+	size_t const t = tile(x, y);
+
+	if (!isUnique(table))
+		table = std::make_shared<Table>(*table);
+
+	std::shared_ptr<Chunk>& c = (*table)[t / CHUNK_TILES];
+	if (!isUnique(c))
+		c = std::make_shared<Chunk>(*c);
+
+	std::shared_ptr<Tile>& f = c->tiles[t % CHUNK_TILES];
+	if (!isUnique(f))
+		f = std::make_shared<Tile>(*f);
+
+	f->fields[offset(x, y)] = status;
+}
+
+size_t TileStore::getOwnTiles() const
+{
+	if (table.use_count() != 1)
+		return 0;
+
+	size_t own = 0;
+	for (Table::const_iterator it = table->begin(); it != table->end(); ++it)
+	{
+		if (it->use_count() != 1)
+			continue;
+		for (uint16_t i = 0; i < CHUNK_TILES; ++i)
+			own += (*it)->tiles[i].use_count() == 1;
+	}
+	return own;
+}
+
+MatrixClone::Layout::Layout(Dimensions const& dim, uint8_t const* bombs, uint8_t const* adjacent) :
+		dim(dim)
+{
+	uint16_t const cols = dim.getX();
+	uint16_t const rows = dim.getY();
+	uint32_t const size = (uint32_t) cols * rows;
+
+	grid.shape(cols, rows, dim.getTopology());
+	grid.link(links);
+
+	// One more for the border
+	this->bombs.assign(bombs, bombs + size);
+	this->bombs.push_back(0);
+	this->adjacent.assign(adjacent, adjacent + size);
+	this->adjacent.push_back(0);
+}
+
+MatrixClone::MatrixClone() :
+		layout(std::make_shared<Layout const>(Dimensions(), (uint8_t const*) 0, (uint8_t const*) 0)), status(GS_READY), unhidden(0), marked(0)
+{
+}
+
+MatrixClone::MatrixClone(std::shared_ptr<Layout const> const& layout, TileStore const& statuses,
+		GAMESTATUS status, uint32_t unhidden, uint32_t marked) :
+		layout(layout), statuses(statuses), status(status), unhidden(unhidden), marked(marked)
+{
+}
+
+Dimensions const& MatrixClone::getDimensions() const
+{
+	return layout->dim;
+}
+
+int32_t MatrixClone::getRemainingBombs() const
+{
+	return (int32_t) layout->dim.getBombs() - (int32_t) marked;
+}
+
+uint8_t MatrixClone::getAdjacentBombs(uint16_t x, uint16_t y) const
+{
+	return layout->adjacent[(size_t) y * layout->dim.getX() + x];
+}
+
+uint8_t MatrixClone::reveal(uint16_t x, uint16_t y)
+{
+	Layout const& l = *layout;
+	uint16_t const cols = l.dim.getX();
+	uint32_t const size = (uint32_t) cols * l.dim.getY();
+	uint32_t const index = (uint32_t) y * cols + x;
+
+	uint8_t const s = statuses.get(x, y);
+	if (l.bombs[index])
+	{
+		if (s != FS_MARKED && s != FS_BOMB && s != FS_UNHIDDEN)
+		{
+			statuses.set(x, y, FS_BOMB);
+			status = GS_LOST;
+		}
+		return FS_BOMB;
+	}
+	if (s == FS_MARKED || s == FS_UNHIDDEN)
+		return l.adjacent[index];
+
+	stack.clear();
+	stack.push_back(index);
+	while (!stack.empty())
+	{
+		uint32_t i = stack.back();
+		stack.pop_back();
+		if (i == size)
+			continue;
+
+		uint16_t const fx = i % cols;
+		uint16_t const fy = i / cols;
+		uint8_t const fs = statuses.get(fx, fy);
+		if (fs == FS_MARKED || fs == FS_UNHIDDEN)
+			continue;
+
+		statuses.set(fx, fy, FS_UNHIDDEN);
+		++unhidden;
+		if (l.adjacent[i] == 0)
+		{
+			uint32_t const* link = &l.links[l.grid.index(fx, fy)];
+			int32_t const* offsets = l.grid.offsets(fy);
+			for (uint8_t n = l.grid.getNeighbourCount(); n-- > 0;)
+				stack.push_back(link[offsets[n]]);
+		}
+	}
+
+	update();
+	return l.adjacent[index];
+}
+
+void MatrixClone::cycleMark(uint16_t x, uint16_t y)
+{
+	switch (statuses.get(x, y))
+	{
+	case FS_HIDDEN:
+		statuses.set(x, y, FS_MARKED);
+		++marked;
+		break;
+	case FS_MARKED:
+		statuses.set(x, y, FS_QUERIED);
+		--marked;
+		break;
+	case FS_QUERIED:
+		statuses.set(x, y, FS_HIDDEN);
+		break;
+	default:
+		return;
+	}
+	update();
+}
+
+void MatrixClone::update()
+{
+	// Same rule as the Matrix
+	Dimensions const& d = layout->dim;
+	if (status != GS_LOST)
+	{
+		if (unhidden == (uint32_t) d.getX() * d.getY() - d.getBombs() && marked == d.getBombs())
+			status = GS_WON;
+		else
+			status = GS_RUNNING;
+	}
+}
+
+} // namespace msm
+
+///\}
@@ -0,0 +1,183 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file matrixClone.hpp
+ *
+ * Cheap copy-on-write clones of a \ref msm::Matrix "matrix" for what-if searches.
+ *
+ * A clone shares the immutable layout (bombs, adjacent bombs, neighbours) with the
+ * matrix and all other clones. The statuses of the fields are stored in tiles of
+ * \ref msm::TILE_EDGE x \ref msm::TILE_EDGE fields, which are shared until they are
+ * modified. The tiles are referenced by a two-level table, whose parts are shared the same way.
+ * So cloning costs O(1) and a modification copies at most one tile and two small tables.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef MATRIXCLONE_HPP_
+#define MATRIXCLONE_HPP_
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+
+#include "grid.hpp"
+#include "matrix.hpp"
+
+namespace msm
+{
+
+/// The edge length of a tile of field statuses.
+const uint16_t TILE_EDGE = 16;
+/// The count of tiles referenced by one chunk of the table of a \ref TileStore.
+const uint16_t CHUNK_TILES = 64;
+
+/**
+ * \internal The statuses of the fields of a board in copy-on-write tiles.
+ * Copying a store is O(1). A store must not be used by two threads at the same time,
+ * but copies of it may: A part is only changed in place by its last owner, after an
+ * acquire fence that orders the reads of the owners before.
+ */
+class TileStore
+{
+public:
+	/// Create an empty store.
+	TileStore();
+
+	/** Resize the store. All fields are hidden afterwards.
+	 * \param cols The count of columns.
+	 * \param rows The count of rows. */
+	void reset(uint16_t cols, uint16_t rows);
+
+	/// Get the status of a field.
+	uint8_t get(uint16_t x, uint16_t y) const
+	{
+		size_t t = tile(x, y);
+		return (*table)[t / CHUNK_TILES]->tiles[t % CHUNK_TILES]->fields[offset(x, y)];
+	}
+	/// Set the status of a field. Copies the tile if it is shared.
+	void set(uint16_t x, uint16_t y, uint8_t status);
+
+	/// Get the count of tiles that are not shared with another store.
+	size_t getOwnTiles() const;
+
+private:
+	struct Tile
+	{
+		uint8_t fields[TILE_EDGE * TILE_EDGE];
+	};
+	struct Chunk
+	{
+		std::shared_ptr<Tile> tiles[CHUNK_TILES];
+	};
+	typedef std::vector<std::shared_ptr<Chunk> > Table;
+
+	std::shared_ptr<Table> table;
+	uint16_t tilesPerRow;
+
+	size_t tile(uint16_t x, uint16_t y) const
+	{
+		return (size_t) (y / TILE_EDGE) * tilesPerRow + x / TILE_EDGE;
+	}
+	static size_t offset(uint16_t x, uint16_t y)
+	{
+		return (y % TILE_EDGE) * TILE_EDGE + x % TILE_EDGE;
+	}
+};
+
+/**
+ * A copy-on-write clone of a \ref Matrix, created by \ref Matrix::clone().
+ * It follows the same rules as the matrix, but has no field objects and no observers.
+ * Copying a clone is as cheap as creating it.
+ * \note Different clones can be used by different threads at the same time.
+ */
+class MatrixClone
+{
+public:
+	/// The shared, immutable part.
+	struct Layout;
+
+	/// Create an empty clone.
+	MatrixClone();
+
+	/// Get the \ref Dimensions.
+	Dimensions const& getDimensions() const;
+	/// Get the current \ref #GAMESTATUS "game status".
+	GAMESTATUS getStatus() const
+	{
+		return status;
+	}
+	/// Get the remaining bomb count.
+	int32_t getRemainingBombs() const;
+
+	/** Get the \ref #FIELDSTATUS "status" of a field.
+	 * \warning Accessing a position outside of the matrix is undefined behaviour. */
+	FIELDSTATUS getFieldStatus(uint16_t x, uint16_t y) const
+	{
+		return (FIELDSTATUS) statuses.get(x, y);
+	}
+	/** Get the count of adjacent bombs of a field.
+	 * \warning Accessing a position outside of the matrix is undefined behaviour. */
+	uint8_t getAdjacentBombs(uint16_t x, uint16_t y) const;
+
+	/** Reveal a field like Field::reveal().
+	 * \warning Accessing a position outside of the matrix is undefined behaviour.
+	 * \return The count of adjacent bombs or \ref FS_BOMB "bomb status". */
+	uint8_t reveal(uint16_t x, uint16_t y);
+	/** Cycle the mark of a field like Field::cycleMark().
+	 * \warning Accessing a position outside of the matrix is undefined behaviour. */
+	void cycleMark(uint16_t x, uint16_t y);
+
+	/// Fork this clone.
+	MatrixClone clone() const
+	{
+		return *this;
+	}
+
+	/// \internal Get the status store (e.g. to check the sharing of the tiles).
+	TileStore const& getStore() const
+	{
+		return statuses;
+	}
+
+private:
+	friend class Matrix;
+
+	MatrixClone(std::shared_ptr<Layout const> const& layout, TileStore const& statuses, GAMESTATUS status,
+			uint32_t unhidden, uint32_t marked);
+
+	std::shared_ptr<Layout const> layout;
+	TileStore statuses;
+	GAMESTATUS status;
+	uint32_t unhidden;
+	uint32_t marked;
+	std::vector<uint32_t> stack;
+
+	void update();
+};
+
+/// \internal The shared, immutable part of \ref MatrixClone "clones".
+struct MatrixClone::Layout
+{
+	/** Build the layout.
+	 * \param dim The dimensions.
+	 * \param bombs 1 for each bomb, row-major.
+	 * \param adjacent The adjacent bombs of each field, row-major. */
+	Layout(Dimensions const& dim, uint8_t const* bombs, uint8_t const* adjacent);
+
+	Dimensions dim;
+	Grid grid;
+	/// The row-major index of each padded index (see Grid::link()).
+	std::vector<uint32_t> links;
+	/// Adjacent bombs, the count of fields + 1 for the border.
+	std::vector<uint8_t> adjacent;
+	std::vector<uint8_t> bombs;
+};
+
+} // namespace msm
+
+#endif /* MATRIXCLONE_HPP_ */
+
+///\}
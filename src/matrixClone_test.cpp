@@ -0,0 +1,129 @@
+/**
+ * @file matrixClone_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include "matrixClone.hpp"
+
+namespace
+{
+void checkSame(msm::Matrix const& matrix, msm::MatrixClone const& clone)
+{
+	BOOST_CHECK(matrix.getStatus() == clone.getStatus());
+	BOOST_CHECK(matrix.getRemainingBombs() == clone.getRemainingBombs());
+	for (msm::CellIterator it = matrix.begin(); it != matrix.end(); ++it)
+	{
+		msm::Position const& p = it->getPosition();
+		BOOST_CHECK(it->getStatus() == clone.getFieldStatus(p.X, p.Y));
+		BOOST_CHECK(it->getAdjacentBombs() == clone.getAdjacentBombs(p.X, p.Y));
+	}
+}
+}
+
+BOOST_AUTO_TEST_SUITE(matrixClone_test_suite)
+
+BOOST_AUTO_TEST_CASE(empty_test)
+{
+	msm::MatrixClone clone;
+	BOOST_CHECK(0 == clone.getDimensions().getX());
+	BOOST_CHECK(msm::GS_READY == clone.getStatus());
+}
+
+BOOST_AUTO_TEST_CASE(isolation_test)
+{
+	msm::Matrix matrix(msm::Dimensions(40, 40, 100));
+	matrix.at(3, 3).cycleMark();
+
+	msm::MatrixClone a = matrix.clone();
+	checkSame(matrix, a);
+	BOOST_CHECK(0 == a.getStore().getOwnTiles());
+
+	// Modifying the clone leaves the matrix alone
+	a.cycleMark(20, 20);
+	BOOST_CHECK(msm::FS_MARKED == a.getFieldStatus(20, 20));
+	BOOST_CHECK(msm::FS_HIDDEN == matrix.at(20, 20).getStatus());
+	BOOST_CHECK(1 == a.getStore().getOwnTiles());
+
+	// Modifying the matrix leaves the clone alone
+	msm::MatrixClone b = a.clone();
+	matrix.at(3, 3).cycleMark();
+	BOOST_CHECK(msm::FS_MARKED == a.getFieldStatus(3, 3));
+	BOOST_CHECK(msm::FS_QUERIED == matrix.at(3, 3).getStatus());
+
+	// Forks are independent
+	b.cycleMark(20, 20);
+	BOOST_CHECK(msm::FS_QUERIED == b.getFieldStatus(20, 20));
+	BOOST_CHECK(msm::FS_MARKED == a.getFieldStatus(20, 20));
+	BOOST_CHECK(a.getRemainingBombs() == b.getRemainingBombs() - 1);
+}
+
+BOOST_AUTO_TEST_CASE(rules_test)
+{
+	// The same moves on the matrix and the clone give the same game
+	msm::TOPOLOGY const topologies[] = { msm::TP_PLANE, msm::TP_TORUS, msm::TP_HEX };
+	for (int t = 0; t < 3; ++t)
+	{
+		msm::Dimensions d(50, 30, 120, topologies[t]);
+		msm::Matrix matrix;
+		matrix.reset(d, 21);
+		matrix.at(10, 10).cycleMark();
+		msm::MatrixClone clone = matrix.clone();
+
+		for (uint16_t y = 0; y < 30; y += 3)
+			for (uint16_t x = (y * 7) % 5; x < 50; x += 5)
+			{
+				if (x % 4 == 0)
+				{
+					matrix.at(x, y).cycleMark();
+					clone.cycleMark(x, y);
+				}
+				BOOST_CHECK(matrix.at(x, y).reveal() == clone.reveal(x, y));
+			}
+		checkSame(matrix, clone);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(mirror_test)
+{
+	// The first clone picks up the moves made before it, the later ones those made after it
+	msm::Matrix matrix;
+	matrix.reset(msm::Dimensions(60, 40, 200), 5);
+	for (uint16_t i = 0; i < 40; i += 3)
+	{
+		matrix.at(i, i).cycleMark();
+		matrix.at(59 - i, i).reveal();
+	}
+	checkSame(matrix, matrix.clone());
+
+	matrix.at(1, 2).cycleMark();
+	matrix.at(30, 20).reveal();
+	checkSame(matrix, matrix.clone());
+
+	// A reset starts over
+	matrix.reset(msm::Dimensions(60, 40, 200), 6);
+	checkSame(matrix, matrix.clone());
+}
+
+BOOST_AUTO_TEST_CASE(win_test)
+{
+	msm::Matrix matrix(msm::Dimensions(2, 1, 1));
+	msm::MatrixClone clone = matrix.clone();
+	uint16_t bomb = dynamic_cast<msm::Bomb*>(&matrix.at(0, 0)) ? 0 : 1;
+
+	clone.reveal(1 - bomb, 0);
+	BOOST_CHECK(msm::GS_RUNNING == clone.getStatus());
+	clone.cycleMark(bomb, 0);
+	BOOST_CHECK(msm::GS_WON == clone.getStatus());
+
+	// A new game needs a new clone
+	msm::MatrixClone lost = matrix.clone();
+	BOOST_CHECK(msm::FS_BOMB == lost.reveal(bomb, 0));
+	BOOST_CHECK(msm::GS_LOST == lost.getStatus());
+	BOOST_CHECK(msm::GS_READY == matrix.getStatus());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -10,12 +10,17 @@
 #define BOOST_TEST_MODULE "MineSweeperMatrix Test Suite"
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <vector>
+
 #include "matrix.hpp"
 
 struct Fix_matrix_test: public msm::MatrixObserver
 {
 	Fix_matrix_test() :
-			uut(0), last_status(msm::GS_READY), gs_cb_count(0), last_remaining_bomb_count(0), rb_cb_count(0)
+			uut(0), last_status(msm::GS_READY), gs_cb_count(0), last_remaining_bomb_count(0), rb_cb_count(0), fs_cb_count(0)
 	{
 	}
 	~Fix_matrix_test()
@@ -37,6 +42,7 @@ struct Fix_matrix_test: public msm::MatrixObserver
 	}
 	void onFieldStatusChanged(msm::Matrix const&, msm::Field const&, msm::FIELDSTATUS)
 	{
+		++fs_cb_count;
 	}
 	void onFieldDelete(msm::Matrix const&, msm::Field const&)
 	{
@@ -49,6 +55,8 @@ struct Fix_matrix_test: public msm::MatrixObserver
 
 	int32_t last_remaining_bomb_count;
 	int rb_cb_count;
+
+	int fs_cb_count;
 };
 
 namespace
@@ -85,6 +93,275 @@ BOOST_AUTO_TEST_CASE(exception_test)
 	BOOST_CHECK_EXCEPTION((*uut)[0][1], msm::IndexOutOfBoundsException, check_y);
 }
 
+BOOST_AUTO_TEST_CASE(exception_message_test)
+{
+	msm::IndexOutOfBoundsException ex(7, 3, 'Y');
+	BOOST_CHECK(std::string(ex.what()) == "Matrix index out of bounds. Index: 7 exceeding array length of: 3 in dimension: Y");
+}
+
+BOOST_AUTO_TEST_CASE(try_get_test)
+{
+	uut = new msm::Matrix();
+	BOOST_CHECK(0 == uut->tryGet(0, 0));
+
+	uut->reset(msm::Dimensions(2, 3, 0));
+	BOOST_CHECK(&(*uut)[1][2] == uut->tryGet(1, 2));
+	BOOST_CHECK(&(*uut)[1][2] == &uut->at(1, 2));
+	BOOST_CHECK(0 == uut->tryGet(2, 0));
+	BOOST_CHECK(0 == uut->tryGet(0, 3));
+}
+
+BOOST_AUTO_TEST_CASE(neighbours_test)
+{
+	uut = new msm::Matrix(msm::Dimensions(3, 3, 0));
+
+	BOOST_CHECK(8 == std::distance(uut->neighbours(1, 1).begin(), uut->neighbours(1, 1).end()));
+	BOOST_CHECK(3 == std::distance(uut->neighbours(0, 0).begin(), uut->neighbours(0, 0).end()));
+	BOOST_CHECK(5 == std::distance(uut->neighbours(2, 1).begin(), uut->neighbours(2, 1).end()));
+	BOOST_CHECK(0 == std::distance(uut->neighbours(3, 1).begin(), uut->neighbours(3, 1).end()));
+
+	msm::NeighbourRange range = uut->neighbours(0, 0);
+	msm::NeighbourIterator it = range.begin();
+	BOOST_CHECK(1 == it->getPosition().X && 0 == it->getPosition().Y);
+	++it;
+	BOOST_CHECK(1 == it->getPosition().X && 1 == it->getPosition().Y);
+	++it;
+	BOOST_CHECK(0 == it->getPosition().X && 1 == it->getPosition().Y);
+	++it;
+	BOOST_CHECK(it == range.end());
+}
+
+namespace
+{
+struct CountHidden
+{
+	explicit CountHidden(int* count) :
+			count(count)
+	{
+	}
+	void operator()(msm::Field& f) const
+	{
+		if (f.getStatus() == msm::FS_HIDDEN)
+			++*count;
+	}
+	int* count;
+};
+}
+
+BOOST_AUTO_TEST_CASE(for_each_test)
+{
+	uut = new msm::Matrix(msm::Dimensions(4, 3, 0));
+	uut->at(3, 2).cycleMark();
+
+	int hidden = 0;
+	uut->forEach(CountHidden(&hidden));
+	BOOST_CHECK(11 == hidden);
+}
+
+namespace
+{
+std::vector<int> layout(msm::Matrix const& m)
+{
+	std::vector<int> l;
+	for (msm::CellIterator it = m.begin(); it != m.end(); ++it)
+		l.push_back(dynamic_cast<msm::Bomb const*>(&*it) ? -1 : it->getAdjacentBombs());
+	return l;
+}
+
+std::vector<int> statuses(msm::Matrix const& m)
+{
+	std::vector<int> s;
+	for (msm::CellIterator it = m.begin(); it != m.end(); ++it)
+		s.push_back(it->getStatus());
+	return s;
+}
+}
+
+BOOST_AUTO_TEST_CASE(seed_test)
+{
+	msm::Dimensions d(30, 150, 700);
+	uut = new msm::Matrix();
+
+	uut->reset(d, 99);
+	BOOST_CHECK(99 == uut->getSeed());
+	std::vector<int> serial = layout(*uut);
+	BOOST_CHECK(700 == std::count(serial.begin(), serial.end(), -1));
+
+	uut->reset(d, 100);
+	BOOST_CHECK(serial != layout(*uut));
+
+	uut->setThreadCount(4);
+	BOOST_CHECK(4 == uut->getThreadCount());
+	uut->reset(d, 99);
+	BOOST_CHECK(serial == layout(*uut));
+
+	// Adjacent counts match the neighbours
+	for (uint16_t y = 0; y < d.getY(); ++y)
+		for (uint16_t x = 0; x < d.getX(); ++x)
+		{
+			msm::NeighbourRange n = uut->neighbours(x, y);
+			int bombs = 0;
+			for (msm::NeighbourIterator it = n.begin(); it != n.end(); ++it)
+				bombs += dynamic_cast<msm::Bomb*>(&*it) ? 1 : 0;
+			BOOST_CHECK(bombs == uut->at(x, y).getAdjacentBombs());
+		}
+
+	uut->setThreadCount(1);
+	BOOST_CHECK(1 == uut->getThreadCount());
+	uut->reset();
+	BOOST_CHECK(d.getBombs() == uut->getDimensions().getBombs());
+}
+
+BOOST_AUTO_TEST_CASE(parallel_reveal_test)
+{
+	msm::Dimensions d(200, 180, 300);
+	msm::Matrix serial(d);
+	uut = new msm::Matrix();
+	uut->setThreadCount(4);
+	uut->setParallelRevealThreshold(16);
+	BOOST_CHECK(16 == uut->getParallelRevealThreshold());
+
+	for (uint32_t seed = 1; seed <= 5; ++seed)
+	{
+		serial.reset(d, seed);
+		uut->reset(d, seed);
+
+		// Marked and queried fields stop the cascade
+		for (uint16_t i = 0; i < 50; ++i)
+		{
+			serial[i * 3][i].cycleMark();
+			uut->at(i * 3, i).cycleMark();
+		}
+		for (uint16_t i = 0; i < 20; ++i)
+		{
+			serial[100][i].cycleMark();
+			serial[100][i].cycleMark();
+			uut->at(100, i).cycleMark();
+			uut->at(100, i).cycleMark();
+		}
+
+		for (uint16_t y = 0; y < d.getY(); y += 37)
+			for (uint16_t x = 0; x < d.getX(); x += 41)
+			{
+				uint8_t expected = serial[x][y].reveal();
+				BOOST_CHECK(expected == uut->reveal(x, y));
+			}
+
+		BOOST_CHECK(statuses(serial) == statuses(*uut));
+		BOOST_CHECK(serial.getStatus() == uut->getStatus());
+		BOOST_CHECK(serial.getRemainingBombs() == uut->getRemainingBombs());
+	}
+
+	BOOST_CHECK_THROW(uut->reveal(200, 0), msm::IndexOutOfBoundsException);
+}
+
+BOOST_AUTO_TEST_CASE(layout_test)
+{
+	// Neither multiples of the tile nor of the band
+	msm::Dimensions d(203, 130, 900);
+	msm::Matrix rows;
+	uut = new msm::Matrix();
+	BOOST_CHECK(msm::LT_ROWS == uut->getLayout());
+	uut->setLayout(msm::LT_TILES);
+	BOOST_CHECK(msm::LT_TILES == uut->getLayout());
+
+	for (unsigned threads = 1; threads <= 3; threads += 2)
+	{
+		uut->setThreadCount(threads);
+		rows.reset(d, 12);
+		uut->reset(d, 12);
+		BOOST_CHECK(layout(rows) == layout(*uut));
+		for (uint16_t y = 0; y < d.getY(); ++y)
+			for (uint16_t x = 0; x < d.getX(); ++x)
+				BOOST_CHECK(x == uut->at(x, y).getPosition().X && y == uut->at(x, y).getPosition().Y);
+
+		for (uint16_t y = 0; y < d.getY(); y += 13)
+			for (uint16_t x = 0; x < d.getX(); x += 17)
+				BOOST_CHECK(rows[x][y].reveal() == uut->at(x, y).reveal());
+		BOOST_CHECK(statuses(rows) == statuses(*uut));
+		BOOST_CHECK(rows.getStatus() == uut->getStatus());
+	}
+
+	// The field below is in the same tile, not a whole row away
+	uut->setThreadCount(1);
+	uut->reset(d, 12);
+	char const* const first = reinterpret_cast<char const*>(&uut->at(0, 0));
+	char const* const below = reinterpret_cast<char const*>(&uut->at(0, 1));
+	char const* const right = reinterpret_cast<char const*>(&uut->at(1, 0));
+	BOOST_CHECK(below - first == (right - first) * msm::LAYOUT_TILE);
+}
+
+BOOST_AUTO_TEST_CASE(waves_test)
+{
+	msm::Dimensions d(60, 40, 120);
+	msm::Matrix serial(d);
+	uut = new msm::Matrix();
+	uut->addObserver(this);
+	msm::Waves waves;
+
+	for (uint32_t seed = 1; seed <= 3; ++seed)
+	{
+		serial.reset(d, seed);
+		uut->reset(d, seed);
+		serial[5][5].cycleMark();
+		uut->at(5, 5).cycleMark();
+
+		for (uint16_t y = 0; y < d.getY(); y += 7)
+			for (uint16_t x = 0; x < d.getX(); x += 9)
+			{
+				if (dynamic_cast<msm::Bomb*>(&serial[x][y]))
+					continue;
+				bool const revealable = serial[x][y].getStatus() == msm::FS_HIDDEN;
+				int const before = fs_cb_count;
+				BOOST_CHECK(serial[x][y].reveal() == uut->reveal(x, y, waves));
+				BOOST_CHECK((int) waves.getTotal() == fs_cb_count - before);
+				if (!revealable)
+				{
+					BOOST_CHECK(0 == waves.getCount());
+					continue;
+				}
+				BOOST_REQUIRE(waves.getCount() > 0);
+				BOOST_CHECK(1 == waves.getSize(0));
+				BOOST_CHECK((uint32_t) y * d.getX() + x == *waves.begin(0));
+
+				// Each field is one step further than an expanded field of the previous wave
+				std::vector<int> distance(d.getX() * d.getY(), -1);
+				for (uint32_t w = 0; w < waves.getCount(); ++w)
+					for (uint32_t const* i = waves.begin(w); i != waves.end(w); ++i)
+					{
+						BOOST_CHECK(-1 == distance[*i]);
+						distance[*i] = w;
+						BOOST_CHECK(msm::FS_UNHIDDEN == uut->at(*i % d.getX(), *i / d.getX()).getStatus());
+					}
+				for (uint32_t w = 1; w < waves.getCount(); ++w)
+					for (uint32_t const* i = waves.begin(w); i != waves.end(w); ++i)
+					{
+						int closest = w;
+						msm::NeighbourRange n = uut->neighbours(*i % d.getX(), *i / d.getX());
+						for (msm::NeighbourIterator it = n.begin(); it != n.end(); ++it)
+						{
+							uint32_t const j = it->getPosition().Y * d.getX() + it->getPosition().X;
+							if (it->getAdjacentBombs() == 0 && distance[j] >= 0 && distance[j] < closest)
+								closest = distance[j];
+						}
+						BOOST_CHECK(closest == (int) w - 1);
+					}
+			}
+
+		BOOST_CHECK(statuses(serial) == statuses(*uut));
+		BOOST_CHECK(serial.getStatus() == uut->getStatus());
+	}
+
+	// A bomb is a wave of its own
+	uint16_t x = 0;
+	while (!dynamic_cast<msm::Bomb*>(&uut->at(x, 0)) || uut->at(x, 0).getStatus() != msm::FS_HIDDEN)
+		++x;
+	BOOST_CHECK(msm::FS_BOMB == uut->reveal(x, 0, waves));
+	BOOST_CHECK(1 == waves.getCount() && 1 == waves.getTotal());
+	BOOST_CHECK(msm::GS_LOST == uut->getStatus());
+	BOOST_CHECK_THROW(uut->reveal(60, 0, waves), msm::IndexOutOfBoundsException);
+}
+
 BOOST_AUTO_TEST_CASE(remaining_bombs_check)
 {
 	uut = new msm::Matrix(msm::Dimensions(1,1,0));
@@ -137,4 +414,115 @@ BOOST_AUTO_TEST_CASE(callback_test)
 	BOOST_CHECK(1 == rb_cb_count);
 }
 
+BOOST_AUTO_TEST_CASE(apply_test)
+{
+	msm::Dimensions d(30, 20, 60);
+	msm::Matrix single;
+	single.reset(d, 21);
+	uut = new msm::Matrix();
+	uut->reset(d, 21);
+	uut->addObserver(this);
+
+	std::vector<msm::Action> actions;
+	for (uint16_t y = 1; y < 20; y += 4)
+		for (uint16_t x = y % 3; x < 30; x += 5)
+		{
+			if ((x + y) % 4 == 0)
+			{
+				// Marked, queried and hidden again: no notification
+				for (int i = 0; i < 3; ++i)
+					actions.push_back(msm::Action(msm::AT_CYCLEMARK, x, y));
+			}
+			else if ((x + y) % 4 == 1)
+				actions.push_back(msm::Action(msm::AT_CYCLEMARK, x, y));
+			else if (!dynamic_cast<msm::Bomb*>(&single.at(x, y)))
+				actions.push_back(msm::Action(msm::AT_REVEAL, x, y));
+		}
+	actions.push_back(msm::Action(msm::AT_REVEAL, 30, 0));
+
+	std::vector<uint8_t> results(actions.size());
+	uint32_t executed = uut->apply(&actions[0], (uint32_t) actions.size(), &results[0]);
+	BOOST_CHECK(actions.size() - 1 == executed);
+	BOOST_CHECK(msm::AR_INVALID == results.back());
+
+	// The same results and board as the single moves
+	for (size_t i = 0; i + 1 < actions.size(); ++i)
+	{
+		msm::Field& f = single.at(actions[i].x, actions[i].y);
+		if (actions[i].type == msm::AT_REVEAL)
+			BOOST_CHECK(results[i] == single.reveal(actions[i].x, actions[i].y));
+		else
+		{
+			f.cycleMark();
+			BOOST_CHECK(results[i] == f.getStatus());
+		}
+	}
+	int changed = 0;
+	for (msm::CellIterator a = uut->begin(), b = single.begin(); a != uut->end(); ++a, ++b)
+	{
+		BOOST_CHECK(a->getStatus() == b->getStatus());
+		changed += a->getStatus() != msm::FS_HIDDEN;
+	}
+	BOOST_CHECK(uut->getRemainingBombs() == single.getRemainingBombs());
+
+	// One notification per changed field, one per counter
+	BOOST_CHECK(changed == fs_cb_count);
+	BOOST_CHECK(1 == rb_cb_count);
+	BOOST_CHECK(uut->getRemainingBombs() == last_remaining_bomb_count);
+	BOOST_CHECK(1 == gs_cb_count);
+	BOOST_CHECK(msm::GS_RUNNING == last_status);
+
+	// The batch stops at the end of the game
+	msm::CellIterator bomb = uut->begin();
+	while (!dynamic_cast<msm::Bomb const*>(&*bomb))
+		++bomb;
+	msm::Position const& p = bomb->getPosition();
+	msm::Action const lose[] = { msm::Action(msm::AT_REVEAL, p.X, p.Y), msm::Action(msm::AT_CYCLEMARK, 0, 0) };
+	uint8_t lost[2];
+	BOOST_CHECK(1 == uut->apply(lose, 2, lost));
+	BOOST_CHECK(msm::FS_BOMB == lost[0]);
+	BOOST_CHECK(msm::AR_SKIPPED == lost[1]);
+	BOOST_CHECK(msm::GS_LOST == last_status);
+	BOOST_CHECK(0 == uut->apply(lose, 2));
+}
+
+namespace
+{
+/// Throws on the first change of a field.
+struct Thrower: public msm::FieldObserver
+{
+	void onFieldStatusChanged(msm::Field const&, msm::FIELDSTATUS)
+	{
+		throw 42;
+	}
+	void onFieldDelete(msm::Field const&)
+	{
+	}
+};
+}
+
+BOOST_AUTO_TEST_CASE(apply_exception_test)
+{
+	uut = new msm::Matrix(msm::Dimensions(5, 5, 0));
+	uut->addObserver(this);
+	Thrower thrower;
+	uut->at(1, 0).addObserver(&thrower);
+
+	// The changes up to the exception are reported, the batch ends anyway
+	msm::Action const actions[] = { msm::Action(msm::AT_CYCLEMARK, 0, 0), msm::Action(msm::AT_CYCLEMARK, 1, 0),
+			msm::Action(msm::AT_CYCLEMARK, 2, 0) };
+	BOOST_CHECK_THROW(uut->apply(actions, 3), int);
+	uut->at(1, 0).removeObserver(&thrower);
+	BOOST_CHECK(2 == fs_cb_count);
+	BOOST_CHECK(msm::FS_HIDDEN == uut->at(2, 0).getStatus());
+	BOOST_CHECK(-2 == last_remaining_bomb_count);
+
+	// Single moves are reported at once again
+	uut->at(2, 0).cycleMark();
+	BOOST_CHECK(3 == fs_cb_count);
+	BOOST_CHECK(1 == uut->apply(actions, 1));
+	BOOST_CHECK(4 == fs_cb_count);
+	BOOST_CHECK(msm::FS_QUERIED == uut->at(0, 0).getStatus());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
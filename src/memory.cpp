@@ -0,0 +1,178 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file memory.cpp
+ *
+ * Implementation of \ref memory.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "memory.hpp"
+
+#include <stdint.h>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace msm
+{
+
+namespace
+{
+/// Chunks stop growing at this size.
+size_t const MAX_CHUNK = 16 * 1024 * 1024;
+
+struct NewDeleteResource: public MemoryResource
+{
+	void* doAllocate(size_t bytes, size_t)
+	{
+		return ::operator new(bytes);
+	}
+	void doDeallocate(void* p, size_t, size_t)
+	{
+		::operator delete(p);
+	}
+};
+}
+
+MemoryResource* newDeleteResource()
+{
+	static NewDeleteResource resource;
+	return &resource;
+}
+
+HugePageResource::HugePageResource(HUGEPAGES pages) :
+		pages(pages), explicitBytes(0), transparentBytes(0)
+{
+}
+
+HugePageResource::~HugePageResource()
+{
+}
+
+void* HugePageResource::doAllocate(size_t bytes, size_t alignment)
+{
+#if defined(__linux__)
+	if (bytes >= HUGE_PAGE && alignment <= HUGE_PAGE)
+	{
+		size_t const size = (bytes + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+#ifdef MAP_HUGETLB
+		if (pages == HP_EXPLICIT)
+		{
+			void* p = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (p != MAP_FAILED)
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				explicitMappings.insert(p);
+				explicitBytes += size;
+				return p;
+			}
+		}
+#endif
+		// Map one huge page more and cut it to a huge page boundary, so the kernel can use whole huge pages
+		char* raw = static_cast<char*>(mmap(0, size + HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+				-1, 0));
+		if (raw == MAP_FAILED)
+			throw std::bad_alloc();
+		char* p = raw + (HUGE_PAGE - (uintptr_t) raw % HUGE_PAGE) % HUGE_PAGE;
+		if (p != raw)
+			munmap(raw, p - raw);
+		if (p + size != raw + size + HUGE_PAGE)
+			munmap(p + size, raw + size + HUGE_PAGE - (p + size));
+#ifdef MADV_HUGEPAGE
+		// Only a hint: Fails if the kernel has no transparent huge pages
+		madvise(p, size, MADV_HUGEPAGE);
+#endif
+		transparentBytes += size;
+		return p;
+	}
+#endif
+	return newDeleteResource()->allocate(bytes, alignment);
+}
+
+void HugePageResource::doDeallocate(void* p, size_t bytes, size_t alignment)
+{
+#if defined(__linux__)
+	if (bytes >= HUGE_PAGE && alignment <= HUGE_PAGE)
+	{
+		size_t const size = (bytes + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+		bool mapped;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			mapped = explicitMappings.erase(p) > 0;
+		}
+		munmap(p, size);
+		(mapped ? explicitBytes : transparentBytes) -= size;
+		return;
+	}
+#endif
+	newDeleteResource()->deallocate(p, bytes, alignment);
+}
+
+MonotonicResource::MonotonicResource(MemoryResource* upstream, size_t chunkSize) :
+		upstream(upstream ? upstream : newDeleteResource()), firstChunk(chunkSize), nextChunk(chunkSize), chunks(
+				0), current(0), remaining(0), allocated(0)
+{
+}
+
+MonotonicResource::~MonotonicResource()
+{
+	release();
+}
+
+void MonotonicResource::release()
+{
+	while (chunks)
+	{
+		Chunk* next = chunks->next;
+		upstream->deallocate(chunks, chunks->size);
+		chunks = next;
+	}
+	nextChunk = firstChunk;
+	current = 0;
+	remaining = 0;
+	allocated = 0;
+}
+
+void* MonotonicResource::doAllocate(size_t bytes, size_t alignment)
+{
+	size_t padding = (alignment - (uintptr_t) current % alignment) % alignment;
+	if (!current || padding + bytes > remaining)
+	{
+		// The chunk header keeps the maximum alignment for the rest of the chunk
+		size_t const header = (sizeof(Chunk) + MAX_ALIGNMENT - 1) / MAX_ALIGNMENT * MAX_ALIGNMENT;
+		size_t size = nextChunk;
+		while (size < header + bytes + alignment)
+			size *= 2;
+
+		Chunk* chunk = static_cast<Chunk*>(upstream->allocate(size));
+		chunk->next = chunks;
+		chunk->size = size;
+		chunks = chunk;
+		allocated += size;
+		if (size < MAX_CHUNK)
+			nextChunk = size * 2;
+
+		current = reinterpret_cast<char*>(chunk) + header;
+		remaining = size - header;
+		padding = (alignment - (uintptr_t) current % alignment) % alignment;
+	}
+
+	void* p = current + padding;
+	current += padding + bytes;
+	remaining -= padding + bytes;
+	return p;
+}
+
+void MonotonicResource::doDeallocate(void*, size_t, size_t)
+{
+}
+
+} // namespace msm
+
+///\}
@@ -0,0 +1,250 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file memory.hpp
+ *
+ * Pluggable memory resources for the allocations of a \ref msm::Matrix "matrix".
+ *
+ * The interface follows std::pmr::memory_resource (C++17), which is not available here.
+ * A matrix allocates its fields from \ref msm::MonotonicResource "arenas", one per
+ * thread, that take large chunks from an upstream resource and return them in one shot
+ * on reset. The upstream resource can be replaced (see Matrix::setMemoryResource()),
+ * e.g. by a pool of NUMA-local memory or by a \ref msm::HugePageResource "resource of huge
+ * pages" for boards with tens of millions of fields.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef MEMORY_HPP_
+#define MEMORY_HPP_
+
+#include <stddef.h>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <set>
+
+namespace msm
+{
+
+/// The alignment used when none is given, suitable for every scalar type.
+const size_t MAX_ALIGNMENT = alignof(std::max_align_t);
+
+/// Interface for a source of memory.
+class MemoryResource
+{
+public:
+	virtual ~MemoryResource()
+	{
+	}
+
+	/** Allocate memory.
+	 * \param bytes The size in bytes.
+	 * \param alignment The alignment, a power of two.
+	 * \return The memory. Never 0, throws std::bad_alloc instead. */
+	void* allocate(size_t bytes, size_t alignment = MAX_ALIGNMENT)
+	{
+		return doAllocate(bytes, alignment);
+	}
+	/** Give memory back.
+	 * \param p The memory returned by \ref allocate().
+	 * \param bytes The size passed to \ref allocate().
+	 * \param alignment The alignment passed to \ref allocate(). */
+	void deallocate(void* p, size_t bytes, size_t alignment = MAX_ALIGNMENT)
+	{
+		doDeallocate(p, bytes, alignment);
+	}
+
+protected:
+	virtual void* doAllocate(size_t bytes, size_t alignment) = 0;
+	virtual void doDeallocate(void* p, size_t bytes, size_t alignment) = 0;
+};
+
+/**
+ * Get the resource that uses the global operator new and delete.
+ * It is thread-safe and supports alignments up to \ref MAX_ALIGNMENT.
+ * \return A resource that lives as long as the program.
+ */
+MemoryResource* newDeleteResource();
+
+/// The kind of huge pages a \ref HugePageResource asks for.
+enum HUGEPAGES
+{
+	HP_TRANSPARENT, //!< Normal mappings that are advised for transparent huge pages.
+	HP_EXPLICIT     //!< Mappings of the reserved huge pages (MAP_HUGETLB). Transparent if none are left.
+};
+
+/// The size of a huge page.
+const size_t HUGE_PAGE = 2 * 1024 * 1024;
+
+/**
+ * A resource that maps allocations of at least one \ref HUGE_PAGE "huge page" with huge
+ * pages, so a large board needs only a few entries in the TLB. Smaller allocations come
+ * from \ref newDeleteResource(). Use it as the upstream of the arenas of a matrix.
+ *
+ * The mappings are aligned to and rounded up to whole huge pages. Their memory is only
+ * placed when it is touched first. When a matrix is \ref Matrix::setThreadCount() "built
+ * in parallel", each thread touches the chunks of its own arena first, so on a NUMA system
+ * the fields of each band are placed on the node of the thread that creates them.
+ *
+ * \note Falls back to a normal mapping when the kernel has no huge pages left or doesn't
+ * support the advice, and to \ref newDeleteResource() on systems other than Linux.
+ * Thread-safe.
+ */
+class HugePageResource: public MemoryResource
+{
+public:
+	/** Constructor.
+	 * \param pages The kind of huge pages. */
+	explicit HugePageResource(HUGEPAGES pages = HP_TRANSPARENT);
+	/// Destructor. All memory must be given back before.
+	virtual ~HugePageResource();
+
+	/// Get the kind of huge pages.
+	HUGEPAGES getPages() const
+	{
+		return pages;
+	}
+	/// Get the count of bytes currently mapped with reserved huge pages.
+	size_t getExplicitBytes() const
+	{
+		return explicitBytes.load(std::memory_order_relaxed);
+	}
+	/// Get the count of bytes currently mapped and advised for transparent huge pages.
+	size_t getTransparentBytes() const
+	{
+		return transparentBytes.load(std::memory_order_relaxed);
+	}
+
+protected:
+	void* doAllocate(size_t bytes, size_t alignment);
+	void doDeallocate(void* p, size_t bytes, size_t alignment);
+
+private:
+	HUGEPAGES const pages;
+	std::atomic<size_t> explicitBytes;
+	std::atomic<size_t> transparentBytes;
+	/// The mappings of reserved huge pages.
+	std::mutex mutex;
+	std::set<void*> explicitMappings;
+
+	HugePageResource(HugePageResource const& cp);
+	HugePageResource& operator=(HugePageResource const& cp);
+};
+
+/**
+ * An arena: Hands out memory from chunks of an upstream resource, deallocation is a no-op.
+ * All memory is given back at once by \ref release() or the destructor.
+ * The chunks grow geometrically, so a board needs only a few upstream allocations.
+ * \note Not thread-safe. Use one arena per thread.
+ */
+class MonotonicResource: public MemoryResource
+{
+public:
+	/** Constructor.
+	 * \param upstream The source of the chunks. 0 for \ref newDeleteResource().
+	 * \param chunkSize The size of the first chunk. */
+	explicit MonotonicResource(MemoryResource* upstream = 0, size_t chunkSize = 64 * 1024);
+	/// Destructor. Releases all memory.
+	virtual ~MonotonicResource();
+
+	/// Give all chunks back to the upstream resource.
+	void release();
+
+	/// Get the upstream resource.
+	MemoryResource* getUpstream() const
+	{
+		return upstream;
+	}
+	/// Get the count of bytes currently taken from the upstream resource.
+	size_t getAllocated() const
+	{
+		return allocated;
+	}
+
+protected:
+	void* doAllocate(size_t bytes, size_t alignment);
+	void doDeallocate(void* p, size_t bytes, size_t alignment);
+
+private:
+	struct Chunk
+	{
+		Chunk* next;
+		size_t size;
+	};
+
+	MemoryResource* upstream;
+	size_t const firstChunk;
+	size_t nextChunk;
+	Chunk* chunks;
+	char* current;
+	size_t remaining;
+	size_t allocated;
+
+	MonotonicResource(MonotonicResource const& cp);
+	MonotonicResource& operator=(MonotonicResource const& cp);
+};
+
+/**
+ * An allocator for the standard containers that allocates from a \ref MemoryResource.
+ * A default constructed allocator uses \ref newDeleteResource().
+ */
+template<typename T>
+class ResourceAllocator
+{
+public:
+	typedef T value_type;
+
+	ResourceAllocator() :
+			resource(newDeleteResource())
+	{
+	}
+	/// Constructor. 0 for \ref newDeleteResource().
+	ResourceAllocator(MemoryResource* resource) :
+			resource(resource ? resource : newDeleteResource())
+	{
+	}
+	template<typename U>
+	ResourceAllocator(ResourceAllocator<U> const& other) :
+			resource(other.getResource())
+	{
+	}
+
+	T* allocate(size_t n)
+	{
+		return static_cast<T*>(resource->allocate(n * sizeof(T), alignof(T)));
+	}
+	void deallocate(T* p, size_t n)
+	{
+		resource->deallocate(p, n * sizeof(T), alignof(T));
+	}
+
+	/// Get the resource.
+	MemoryResource* getResource() const
+	{
+		return resource;
+	}
+
+private:
+	MemoryResource* resource;
+};
+
+template<typename T, typename U>
+bool operator==(ResourceAllocator<T> const& a, ResourceAllocator<U> const& b)
+{
+	return a.getResource() == b.getResource();
+}
+
+template<typename T, typename U>
+bool operator!=(ResourceAllocator<T> const& a, ResourceAllocator<U> const& b)
+{
+	return a.getResource() != b.getResource();
+}
+
+} // namespace msm
+
+#endif /* MEMORY_HPP_ */
+
+///\}
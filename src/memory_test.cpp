@@ -0,0 +1,165 @@
+/**
+ * @file memory_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <stdint.h>
+#include <vector>
+
+#include "matrix.hpp"
+#include "memory.hpp"
+
+namespace
+{
+/// Counts the allocations and the bytes in use.
+struct CountingResource: public msm::MemoryResource
+{
+	CountingResource() :
+			allocations(0), used(0)
+	{
+	}
+
+	size_t allocations;
+	size_t used;
+
+	void* doAllocate(size_t bytes, size_t alignment)
+	{
+		++allocations;
+		used += bytes;
+		return msm::newDeleteResource()->allocate(bytes, alignment);
+	}
+	void doDeallocate(void* p, size_t bytes, size_t alignment)
+	{
+		used -= bytes;
+		msm::newDeleteResource()->deallocate(p, bytes, alignment);
+	}
+};
+}
+
+BOOST_AUTO_TEST_SUITE(memory_test_suite)
+
+BOOST_AUTO_TEST_CASE(monotonic_test)
+{
+	CountingResource upstream;
+	{
+		msm::MonotonicResource arena(&upstream, 256);
+		BOOST_CHECK(&upstream == arena.getUpstream());
+
+		for (size_t alignment = 1; alignment <= 64; alignment *= 2)
+		{
+			void* p = arena.allocate(3, alignment);
+			BOOST_CHECK(0 == (uintptr_t) p % alignment);
+		}
+		// Larger than a chunk
+		void* big = arena.allocate(1000);
+		BOOST_CHECK(0 == (uintptr_t) big % msm::MAX_ALIGNMENT);
+		arena.deallocate(big, 1000);
+
+		BOOST_CHECK(upstream.used == arena.getAllocated());
+		BOOST_CHECK(upstream.allocations >= 2);
+
+		arena.release();
+		BOOST_CHECK(0 == upstream.used);
+		BOOST_CHECK(0 == arena.getAllocated());
+
+		arena.allocate(10);
+		BOOST_CHECK(upstream.used > 0);
+	}
+	// The destructor releases the rest
+	BOOST_CHECK(0 == upstream.used);
+}
+
+BOOST_AUTO_TEST_CASE(allocator_test)
+{
+	CountingResource resource;
+	{
+		std::vector<int, msm::ResourceAllocator<int> > v((msm::ResourceAllocator<int>(&resource)));
+		for (int i = 0; i < 100; ++i)
+			v.push_back(i);
+		BOOST_CHECK(resource.used >= 100 * sizeof(int));
+	}
+	BOOST_CHECK(0 == resource.used);
+	BOOST_CHECK(msm::ResourceAllocator<int>() == msm::ResourceAllocator<char>(0));
+}
+
+BOOST_AUTO_TEST_CASE(matrix_test)
+{
+	CountingResource upstream;
+	{
+		msm::Matrix matrix;
+		BOOST_CHECK(msm::newDeleteResource() == matrix.getMemoryResource());
+		matrix.setMemoryResource(&upstream);
+		BOOST_CHECK(&upstream == matrix.getMemoryResource());
+		BOOST_CHECK(0 == upstream.used);
+
+		matrix.reset(msm::Dimensions(100, 100, 1000), 7);
+		size_t const used = upstream.used;
+		BOOST_CHECK(used > 10000 * sizeof(msm::Field));
+		// Large chunks instead of one allocation per field
+		BOOST_CHECK(upstream.allocations < 20);
+
+		// The same game on more threads with one arena each
+		msm::Matrix serial;
+		serial.reset(msm::Dimensions(100, 100, 1000), 7);
+		matrix.setThreadCount(3);
+		matrix.reset(msm::Dimensions(100, 100, 1000), 7);
+		matrix.reveal(50, 50);
+		serial.reveal(50, 50);
+		for (msm::CellIterator a = matrix.begin(), b = serial.begin(); a != matrix.end(); ++a, ++b)
+			BOOST_CHECK(a->getStatus() == b->getStatus());
+
+		// A smaller board gives the memory back
+		matrix.reset(msm::Dimensions(10, 10, 10));
+		BOOST_CHECK(upstream.used < used);
+	}
+	BOOST_CHECK(0 == upstream.used);
+}
+
+BOOST_AUTO_TEST_CASE(huge_page_test)
+{
+	msm::HugePageResource pages(msm::HP_EXPLICIT);
+	BOOST_CHECK(msm::HP_EXPLICIT == pages.getPages());
+
+	// Small allocations come from the heap
+	void* small = pages.allocate(1000);
+	BOOST_CHECK(0 == pages.getExplicitBytes() + pages.getTransparentBytes());
+	pages.deallocate(small, 1000);
+
+	// Reserved huge pages if there are some, a normal mapping otherwise
+	size_t const bytes = msm::HUGE_PAGE + 100;
+	char* p = static_cast<char*>(pages.allocate(bytes));
+#if defined(__linux__)
+	BOOST_CHECK(0 == (uintptr_t) p % msm::HUGE_PAGE);
+	BOOST_CHECK(2 * msm::HUGE_PAGE == pages.getExplicitBytes() + pages.getTransparentBytes());
+#endif
+	p[0] = 1;
+	p[bytes - 1] = 2;
+	pages.deallocate(p, bytes);
+	BOOST_CHECK(0 == pages.getExplicitBytes() + pages.getTransparentBytes());
+
+	// The same game from arenas of huge pages
+	msm::HugePageResource transparent;
+	BOOST_CHECK(msm::HP_TRANSPARENT == transparent.getPages());
+	{
+		msm::Matrix matrix, serial;
+		matrix.setMemoryResource(&transparent);
+		matrix.setThreadCount(2);
+		matrix.reset(msm::Dimensions(300, 300, 9000), 3);
+		serial.reset(msm::Dimensions(300, 300, 9000), 3);
+		BOOST_CHECK(0 == transparent.getExplicitBytes());
+#if defined(__linux__)
+		BOOST_CHECK(transparent.getTransparentBytes() >= msm::HUGE_PAGE);
+#endif
+		matrix.reveal(150, 150);
+		serial.reveal(150, 150);
+		for (msm::CellIterator a = matrix.begin(), b = serial.begin(); a != matrix.end(); ++a, ++b)
+			BOOST_CHECK(a->getStatus() == b->getStatus());
+	}
+	BOOST_CHECK(0 == transparent.getTransparentBytes());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
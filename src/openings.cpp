@@ -0,0 +1,159 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file openings.cpp
+ *
+ * Implementation of \ref openings.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "openings.hpp"
+
+namespace msm
+{
+
+namespace
+{
+uint32_t find(std::vector<uint32_t>& parents, uint32_t i)
+{
+	// Path halving
+	while (parents[i] != i)
+	{
+		parents[i] = parents[parents[i]];
+		i = parents[i];
+	}
+	return i;
+}
+}
+
+Openings::Openings()
+{
+}
+
+void Openings::build(Grid const& grid, uint8_t const* adjacent, uint8_t const* bombs, uint16_t tile)
+{
+	uint16_t const cols = grid.getCols();
+	uint16_t const rows = grid.getRows();
+	uint32_t const size = (uint32_t) cols * rows;
+	uint8_t const neighbours = grid.getNeighbourCount();
+
+	clear();
+	labels.assign(size, NO_OPENING);
+	if (!size)
+		return;
+
+	std::vector<uint32_t> links;
+	grid.link(links);
+
+	// Union-find: The root of an opening is its smallest index
+	std::vector<uint32_t> parents(size + 1, NO_OPENING);
+	for (uint32_t i = 0; i < size; ++i)
+		if (!adjacent[i] && !bombs[i])
+			parents[i] = i;
+
+	// Every pair of neighbours is seen once from the later one (also across a torus border).
+	for (uint16_t y = 0; y < rows; ++y)
+	{
+		uint32_t const* l = &links[grid.index(0, y)];
+		int32_t const* offsets = grid.offsets(y);
+		for (uint16_t x = 0; x < cols; ++x, ++l)
+		{
+			uint32_t const i = *l;
+			if (parents[i] == NO_OPENING)
+				continue;
+			for (uint8_t n = 0; n < neighbours; ++n)
+			{
+				uint32_t const j = l[offsets[n]];
+				if (offsets[n] > 0 || parents[j] == NO_OPENING)
+					continue;
+				uint32_t a = find(parents, i), b = find(parents, j);
+				if (a < b)
+					parents[b] = a;
+				else
+					parents[a] = b;
+			}
+		}
+	}
+
+	// Number the roots in row-major order, the roots come before the rest of their opening
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < size; ++i)
+	{
+		if (parents[i] == NO_OPENING)
+			continue;
+		uint32_t const root = find(parents, i);
+		labels[i] = root == i ? count++ : labels[root];
+	}
+
+	/* Collect the fields of each opening in the order of the scan: One scan lists the (field, opening)
+	 * pairs and counts the fields of each opening, then the pairs are sorted by a counting sort. */
+	std::vector<uint32_t> padded(grid.getSize());
+	grid.pad<uint32_t>(&labels[0], &padded[0], NO_OPENING);
+	std::vector<uint32_t> pairs;
+	starts.assign(count + 1, 0);
+	auto collect = [&](uint16_t x, uint16_t y)
+	{
+		uint32_t const i = (uint32_t) y * cols + x;
+		uint32_t const* p = &padded[grid.index(x, y)];
+		if (*p != NO_OPENING)
+		{
+			pairs.push_back(i);
+			pairs.push_back(*p);
+			++starts[*p + 1];
+			return;
+		}
+		if (bombs[i])
+			return;
+
+		// A numbered field borders each opening once
+		int32_t const* offsets = grid.offsets(y);
+		uint32_t found[MAX_NEIGHBOURS];
+		uint8_t n = 0;
+		for (uint8_t k = 0; k < neighbours; ++k)
+		{
+			uint32_t const label = p[offsets[k]];
+			if (label == NO_OPENING)
+				continue;
+			uint8_t m = 0;
+			while (m < n && found[m] != label)
+				++m;
+			if (m == n)
+			{
+				found[n++] = label;
+				pairs.push_back(i);
+				pairs.push_back(label);
+				++starts[label + 1];
+			}
+		}
+	};
+
+	// Row-major is a single tile as wide as the grid
+	uint32_t const tileCols = tile ? tile : cols;
+	uint32_t const tileRows = tile ? tile : rows;
+	for (uint32_t ty = 0; ty < rows; ty += tileRows)
+		for (uint32_t tx = 0; tx < cols; tx += tileCols)
+			for (uint32_t y = ty; y < ty + tileRows && y < rows; ++y)
+				for (uint32_t x = tx; x < tx + tileCols && x < cols; ++x)
+					collect(x, y);
+
+	for (uint32_t o = 0; o < count; ++o)
+		starts[o + 1] += starts[o];
+	fields.resize(starts.back());
+	std::vector<uint32_t> next(starts.begin(), starts.end() - 1);
+	for (size_t k = 0; k < pairs.size(); k += 2)
+		fields[next[pairs[k + 1]]++] = pairs[k];
+}
+
+void Openings::clear()
+{
+	labels.clear();
+	starts.clear();
+	fields.clear();
+}
+
+} // namespace msm
+
+///\}
@@ -0,0 +1,95 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file openings.hpp
+ *
+ * The openings of a layout: The connected areas of fields without adjacent bombs.
+ *
+ * Revealing any field of an opening reveals the whole opening and its border of
+ * numbered fields. The layout doesn't change after a reset, so the openings are
+ * labelled once and a reveal just walks the precomputed fields instead of searching them.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef OPENINGS_HPP_
+#define OPENINGS_HPP_
+
+#include <stdint.h>
+#include <limits>
+#include <vector>
+
+#include "grid.hpp"
+
+namespace msm
+{
+
+/// The label of a field that is not part of an opening.
+const uint32_t NO_OPENING = std::numeric_limits<uint32_t>::max();
+
+/**
+ * The openings of a layout.
+ * The openings are numbered in the row-major order of their first field. The fields of
+ * each opening (the fields without adjacent bombs and the numbered fields around them) are
+ * stored in row-major order, or tile by tile to match the \ref LT_TILES "layout" of a
+ * matrix. A numbered field belongs to all openings it borders.
+ */
+class Openings
+{
+public:
+	/// Create an empty instance.
+	Openings();
+
+	/** Label the openings of a layout.
+	 * \param grid The grid of the layout, at least \ref Grid::shape() "shaped".
+	 * \param adjacent The count of adjacent bombs of each field, row-major.
+	 * \param bombs 1 for bombs, 0 for all other fields, row-major.
+	 * \param tile The edge length of square tiles to store the fields of an opening
+	 * tile by tile, each tile row-major. 0 to store them row-major. */
+	void build(Grid const& grid, uint8_t const* adjacent, uint8_t const* bombs, uint16_t tile = 0);
+	/// Forget all openings.
+	void clear();
+
+	/// Get the count of openings.
+	uint32_t getCount() const
+	{
+		return starts.empty() ? 0 : starts.size() - 1;
+	}
+	/** Get the opening of a field without adjacent bombs.
+	 * \param index The row-major index of the field.
+	 * \return The opening or \ref NO_OPENING for numbered fields and bombs. */
+	uint32_t getLabel(uint32_t index) const
+	{
+		return labels[index];
+	}
+	/// Get the count of fields revealed by the opening, including its border.
+	uint32_t getSize(uint32_t opening) const
+	{
+		return starts[opening + 1] - starts[opening];
+	}
+	/// Get the row-major indices of the fields of an opening.
+	uint32_t const* begin(uint32_t opening) const
+	{
+		return &fields[0] + starts[opening];
+	}
+	/// Get the end of the fields of an opening.
+	uint32_t const* end(uint32_t opening) const
+	{
+		return &fields[0] + starts[opening + 1];
+	}
+
+private:
+	/// The opening of each field.
+	std::vector<uint32_t> labels;
+	/// The first entry in fields of each opening, one more for the end of the last.
+	std::vector<uint32_t> starts;
+	std::vector<uint32_t> fields;
+};
+
+} // namespace msm
+
+#endif /* OPENINGS_HPP_ */
+
+///\}
@@ -0,0 +1,118 @@
+/**
+ * @file openings_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include "matrix.hpp"
+#include "openings.hpp"
+
+namespace
+{
+/// A 5x3 layout with bombs in the middle column.
+void build(msm::Openings& openings, msm::TOPOLOGY topology, uint16_t tile = 0)
+{
+	uint8_t const bombs[] = { 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0 };
+	uint8_t const adjacent[] = { 0, 2, 2, 2, 0, 0, 3, 1, 3, 0, 0, 2, 2, 2, 0 };
+	msm::Grid grid;
+	grid.shape(5, 3, topology);
+	openings.build(grid, adjacent, bombs, tile);
+}
+}
+
+BOOST_AUTO_TEST_SUITE(openings_test_suite)
+
+BOOST_AUTO_TEST_CASE(label_test)
+{
+	msm::Openings openings;
+	build(openings, msm::TP_PLANE);
+	BOOST_REQUIRE(2 == openings.getCount());
+	BOOST_CHECK(0 == openings.getLabel(10));
+	BOOST_CHECK(1 == openings.getLabel(4));
+	BOOST_CHECK(msm::NO_OPENING == openings.getLabel(1));
+	BOOST_CHECK(msm::NO_OPENING == openings.getLabel(7));
+
+	uint32_t const left[] = { 0, 1, 5, 6, 10, 11 };
+	uint32_t const right[] = { 3, 4, 8, 9, 13, 14 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(openings.begin(0), openings.end(0), left, left + 6);
+	BOOST_CHECK_EQUAL_COLLECTIONS(openings.begin(1), openings.end(1), right, right + 6);
+
+	// Tile by tile, the labels stay the same
+	build(openings, msm::TP_PLANE, 2);
+	BOOST_REQUIRE(2 == openings.getCount());
+	BOOST_CHECK(0 == openings.getLabel(10));
+	uint32_t const rightTiles[] = { 3, 8, 4, 9, 13, 14 };
+	BOOST_CHECK_EQUAL_COLLECTIONS(openings.begin(0), openings.end(0), left, left + 6);
+	BOOST_CHECK_EQUAL_COLLECTIONS(openings.begin(1), openings.end(1), rightTiles, rightTiles + 6);
+
+	// Both sides are connected across the border of a torus
+	build(openings, msm::TP_TORUS);
+	BOOST_REQUIRE(1 == openings.getCount());
+	BOOST_CHECK(12 == openings.getSize(0));
+	BOOST_CHECK(0 == openings.getLabel(4));
+}
+
+BOOST_AUTO_TEST_CASE(matrix_test)
+{
+	msm::Matrix matrix(msm::Dimensions(30, 20, 60));
+	msm::Openings const& openings = matrix.getOpenings();
+	BOOST_REQUIRE(openings.getCount() > 0);
+
+	// Every field without adjacent bombs belongs to an opening
+	uint32_t i = 0, zero = 0, listed = 0;
+	for (msm::CellIterator it = matrix.begin(); it != matrix.end(); ++it, ++i)
+	{
+		bool empty = it->getAdjacentBombs() == 0 && !dynamic_cast<msm::Bomb const*>(&*it);
+		zero += empty;
+		BOOST_CHECK(empty == (openings.getLabel(i) != msm::NO_OPENING));
+	}
+	for (uint32_t o = 0; o < openings.getCount(); ++o)
+		for (uint32_t const* f = openings.begin(o); f != openings.end(o); ++f)
+			listed += openings.getLabel(*f) == o;
+	BOOST_CHECK(zero == listed);
+
+	matrix.reset(msm::Dimensions(0, 0, 0));
+	BOOST_CHECK(0 == matrix.getOpenings().getCount());
+}
+
+BOOST_AUTO_TEST_CASE(reveal_test)
+{
+	// The precomputed openings reveal the same fields as the cascade, also after marks
+	msm::TOPOLOGY const topologies[] = { msm::TP_PLANE, msm::TP_TORUS, msm::TP_HEX };
+	for (int t = 0; t < 3; ++t)
+	{
+		msm::Dimensions d(40, 30, 150, topologies[t]);
+		msm::Matrix a, b;
+		a.reset(d, 99);
+		b.reset(d, 99);
+
+		for (uint16_t y = 0; y < 30; y += 2)
+			for (uint16_t x = (y * 3) % 7; x < 40; x += 7)
+			{
+				if ((x + y) % 3 == 0)
+				{
+					a.at(x, y).cycleMark();
+					b.at(x, y).cycleMark();
+					// Queried fields are revealed like hidden ones
+					if (x % 2)
+					{
+						a.at(x, y).cycleMark();
+						b.at(x, y).cycleMark();
+					}
+				}
+				else if (a.getStatus() != msm::GS_LOST)
+					BOOST_CHECK(a.reveal(x, y) == b.at(x, y).reveal());
+			}
+
+		for (msm::CellIterator ia = a.begin(), ib = b.begin(); ia != a.end(); ++ia, ++ib)
+			BOOST_CHECK(ia->getStatus() == ib->getStatus());
+		BOOST_CHECK(a.getStatus() == b.getStatus());
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
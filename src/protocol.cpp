@@ -0,0 +1,198 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file protocol.cpp
+ *
+ * Implementation of \ref protocol.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "protocol.hpp"
+
+namespace msm
+{
+
+namespace
+{
+void put16(std::vector<uint8_t>& out, uint16_t v)
+{
+	out.push_back((uint8_t) v);
+	out.push_back((uint8_t) (v >> 8));
+}
+
+void put32(std::vector<uint8_t>& out, uint32_t v)
+{
+	put16(out, (uint16_t) v);
+	put16(out, (uint16_t) (v >> 16));
+}
+
+uint16_t get16(uint8_t const* p)
+{
+	return (uint16_t) (p[0] | p[1] << 8);
+}
+
+uint32_t get32(uint8_t const* p)
+{
+	return get16(p) | (uint32_t) get16(p + 2) << 16;
+}
+}
+
+void encodeReset(std::vector<uint8_t>& out, Dimensions const& dimensions, uint32_t seed)
+{
+	out.push_back(MT_RESET);
+	put16(out, dimensions.getX());
+	put16(out, dimensions.getY());
+	put32(out, dimensions.getBombs());
+	put32(out, seed);
+	out.push_back((uint8_t) dimensions.getTopology());
+}
+
+void encodeAction(std::vector<uint8_t>& out, MESSAGETYPE type, uint16_t x, uint16_t y)
+{
+	out.push_back((uint8_t) type);
+	put16(out, x);
+	put16(out, y);
+}
+
+ServerSession::ServerSession() :
+		pending(0), started(false), reset(false)
+{
+	matrix.addObserver(&encoder);
+}
+
+bool ServerSession::receive(uint8_t const* data, size_t size, size_t& consumed)
+{
+	consumed = 0;
+	while (consumed < size && !isFull())
+	{
+		uint8_t const* p = data + consumed;
+		size_t const left = size - consumed;
+		if (p[0] == MT_RESET)
+		{
+			if (left < PROTOCOL_RESET)
+				return true;
+			uint16_t const x = get16(p + 1), y = get16(p + 3);
+			if (!x || !y || (uint32_t) x * y > PROTOCOL_MAX_FIELDS || p[13] > TP_HEX)
+				return false;
+			// The moves before are overwritten by the reset anyway
+			actions.clear();
+			matrix.reset(Dimensions(x, y, get32(p + 5), (TOPOLOGY) p[13]), get32(p + 9));
+			encoder.clear();
+			started = true;
+			reset = true;
+			consumed += PROTOCOL_RESET;
+		}
+		else if (p[0] == MT_REVEAL || p[0] == MT_MARK || p[0] == MT_CHORD)
+		{
+			if (left < PROTOCOL_ACTION)
+				return true;
+			uint16_t const x = get16(p + 1), y = get16(p + 3);
+			if (!started || x >= matrix.getDimensions().getX() || y >= matrix.getDimensions().getY())
+				return false;
+			if (p[0] == MT_CHORD)
+				chord(x, y);
+			else
+				actions.push_back(Action(p[0] == MT_REVEAL ? AT_REVEAL : AT_CYCLEMARK, x, y));
+			consumed += PROTOCOL_ACTION;
+		}
+		else
+			return false;
+		++pending;
+	}
+	return true;
+}
+
+void ServerSession::execute()
+{
+	if (actions.empty())
+		return;
+	matrix.apply(&actions[0], (uint32_t) actions.size());
+	actions.clear();
+}
+
+void ServerSession::chord(uint16_t x, uint16_t y)
+{
+	// The chord depends on the moves before
+	execute();
+	Field const& field = matrix.at(x, y);
+	if (field.getStatus() != FS_UNHIDDEN || !field.getAdjacentBombs())
+		return;
+	uint8_t marked = 0;
+	NeighbourRange const range = matrix.neighbours(x, y);
+	for (NeighbourIterator it = range.begin(); it != range.end(); ++it)
+		marked += it->getStatus() == FS_MARKED;
+	if (marked != field.getAdjacentBombs())
+		return;
+	for (NeighbourIterator it = range.begin(); it != range.end(); ++it)
+		if (it->getStatus() == FS_HIDDEN || it->getStatus() == FS_QUERIED)
+			actions.push_back(Action(AT_REVEAL, it->getPosition().X, it->getPosition().Y));
+}
+
+size_t ServerSession::flush(std::vector<uint8_t>& out)
+{
+	if (!pending)
+		return 0;
+	execute();
+
+	size_t const start = out.size();
+	out.push_back(MT_UPDATE);
+	out.push_back((uint8_t) matrix.getStatus());
+	out.push_back(reset ? UF_RESET : 0);
+	out.push_back(0);
+	put32(out, pending);
+	put32(out, (uint32_t) matrix.getRemainingBombs());
+	put16(out, matrix.getDimensions().getX());
+	put16(out, matrix.getDimensions().getY());
+	put32(out, 0);
+	size_t const delta = encoder.flush(out);
+	uint8_t* size = &out[start + PROTOCOL_UPDATE - 4];
+	for (unsigned i = 0; i < 4; ++i)
+		size[i] = (uint8_t) (delta >> 8 * i);
+
+	pending = 0;
+	reset = false;
+	return out.size() - start;
+}
+
+ClientSession::ClientSession() :
+		status(GS_READY), remaining(0), answered(0)
+{
+}
+
+bool ClientSession::receive(uint8_t const* data, size_t size, size_t& consumed, std::vector<uint32_t>* changed)
+{
+	consumed = 0;
+	if (changed)
+		changed->clear();
+	std::vector<uint32_t> cells;
+	while (size - consumed >= PROTOCOL_UPDATE)
+	{
+		uint8_t const* p = data + consumed;
+		uint32_t const delta = get32(p + PROTOCOL_UPDATE - 4);
+		if (p[0] != MT_UPDATE || p[1] > GS_LOST)
+			return false;
+		if (size - consumed - PROTOCOL_UPDATE < delta)
+			return true;
+
+		uint16_t const x = get16(p + 12), y = get16(p + 14);
+		if ((p[2] & UF_RESET) || x != board.getWidth() || y != board.getHeight())
+			board.reset(x, y);
+		if (delta && !board.apply(p + PROTOCOL_UPDATE, delta, changed ? &cells : 0))
+			return false;
+		if (changed)
+			changed->insert(changed->end(), cells.begin(), cells.end());
+
+		status = (GAMESTATUS) p[1];
+		answered += get32(p + 4);
+		remaining = (int32_t) get32(p + 8);
+		consumed += PROTOCOL_UPDATE + delta;
+	}
+	return true;
+}
+
+} // namespace msm
+
+///\}
@@ -0,0 +1,211 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file protocol.hpp
+ *
+ * A compact binary protocol to play games over a stream socket, one game per connection.
+ *
+ * The client sends requests, the server answers with updates. A server collects the
+ * requests of a connection that arrive within one tick of its event loop, executes them
+ * as one batch and answers all of them with one update. The client may send the next
+ * requests before the update of the previous ones arrived.
+ *
+ * Requests:
+ * \code
+ * uint8   MT_RESET
+ * uint16  columns
+ * uint16  rows
+ * uint32  bombs
+ * uint32  seed
+ * uint8   topology
+ *
+ * uint8   MT_REVEAL, MT_MARK or MT_CHORD
+ * uint16  x
+ * uint16  y
+ * \endcode
+ * A chord reveals the hidden neighbours of a revealed field, if as many of its neighbours
+ * are marked as it has adjacent bombs.
+ *
+ * Updates:
+ * \code
+ * uint8   MT_UPDATE
+ * uint8   game status
+ * uint8   flags (UF_*)
+ * uint8   reserved, 0
+ * uint32  count of requests answered
+ * int32   remaining bombs
+ * uint16  columns
+ * uint16  rows
+ * uint32  size of the delta
+ * delta   the changed fields (see \ref delta.hpp)
+ * \endcode
+ * All numbers are little-endian. A malformed request ends the connection.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef PROTOCOL_HPP_
+#define PROTOCOL_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+#include "delta.hpp"
+#include "matrix.hpp"
+
+namespace msm
+{
+
+/// The size of a reset request in bytes.
+const size_t PROTOCOL_RESET = 14;
+/// The size of a reveal, mark or chord request in bytes.
+const size_t PROTOCOL_ACTION = 5;
+/// The size of the header of an update in bytes.
+const size_t PROTOCOL_UPDATE = 20;
+/// The largest board a client may request.
+const uint32_t PROTOCOL_MAX_FIELDS = 1 << 20;
+/// The most requests a \ref ServerSession reads before they are answered by a flush.
+const uint32_t PROTOCOL_MAX_PENDING = 4096;
+
+/// The type of a message of the \ref protocol.hpp "protocol".
+enum MESSAGETYPE
+{
+	MT_RESET, //!< Start a new game.
+	MT_REVEAL, //!< Reveal a field.
+	MT_MARK, //!< Cycle the mark of a field.
+	MT_CHORD, //!< Reveal the neighbours of a revealed field.
+	MT_UPDATE //!< The answer of the server.
+};
+
+/// The flags of an update.
+enum UPDATEFLAG
+{
+	UF_RESET = 1 //!< The game was reset, all fields before the delta are hidden.
+};
+
+/** Append a reset request.
+ * \param out The buffer.
+ * \param dimensions The dimensions of the new game.
+ * \param seed The seed of the layout. */
+void encodeReset(std::vector<uint8_t>& out, Dimensions const& dimensions, uint32_t seed);
+/** Append a reveal, mark or chord request.
+ * \param out The buffer.
+ * \param type \ref MT_REVEAL, \ref MT_MARK or \ref MT_CHORD.
+ * \param x The X-coordinate of the field.
+ * \param y The Y-coordinate of the field. */
+void encodeAction(std::vector<uint8_t>& out, MESSAGETYPE type, uint16_t x, uint16_t y);
+
+/**
+ * The server side of a connection: It owns the game and answers the requests.
+ */
+class ServerSession
+{
+public:
+	/// Constructor. The game starts with the first reset request.
+	ServerSession();
+
+	/** Read the complete requests of a buffer. The moves are executed on \ref flush().
+	 * Stops after \ref PROTOCOL_MAX_PENDING unanswered requests, so a client that sends
+	 * faster than it is answered can't pile up unlimited work.
+	 * \param data The received bytes.
+	 * \param size The count of received bytes.
+	 * \param consumed Receives the count of bytes read. The rest is an incomplete request
+	 * or waits for the next flush (see \ref isFull()).
+	 * \return False if a request is malformed: An unknown type, a position outside of the
+	 * board, an action before the first reset or a board with more than
+	 * \ref PROTOCOL_MAX_FIELDS fields. */
+	bool receive(uint8_t const* data, size_t size, size_t& consumed);
+
+	/** Execute the moves received since the last flush and append one update that answers
+	 * all requests.
+	 * \param out The buffer.
+	 * \return The count of bytes appended. 0 if no request was received. */
+	size_t flush(std::vector<uint8_t>& out);
+
+	/// Get the count of requests that are not answered yet.
+	uint32_t getPending() const
+	{
+		return pending;
+	}
+	/// True if no more requests are read before the next \ref flush().
+	bool isFull() const
+	{
+		return pending >= PROTOCOL_MAX_PENDING;
+	}
+	/// Get the game.
+	Matrix const& getMatrix() const
+	{
+		return matrix;
+	}
+
+private:
+	/// Declared before the matrix, it observes the matrix until its end.
+	DeltaEncoder encoder;
+	Matrix matrix;
+	/// The reveals and marks not executed yet.
+	std::vector<Action> actions;
+	uint32_t pending;
+	bool started;
+	bool reset;
+
+	void execute();
+	void chord(uint16_t x, uint16_t y);
+
+	ServerSession(ServerSession const& cp);
+	ServerSession& operator=(ServerSession const& cp);
+};
+
+/**
+ * The client side of a connection: A mirror of the game kept in sync by the updates.
+ */
+class ClientSession
+{
+public:
+	/// Constructor.
+	ClientSession();
+
+	/** Apply the complete updates of a buffer.
+	 * \param data The received bytes.
+	 * \param size The count of received bytes.
+	 * \param consumed Receives the count of bytes read. The rest is an incomplete update.
+	 * \param changed Receives the row-major indices of the fields in the deltas, if not 0.
+	 * A reset hides all other fields without reporting them.
+	 * \return False if an update is malformed. */
+	bool receive(uint8_t const* data, size_t size, size_t& consumed, std::vector<uint32_t>* changed = 0);
+
+	/// Get the mirror of the board.
+	MirrorBoard const& getBoard() const
+	{
+		return board;
+	}
+	/// Get the \ref #GAMESTATUS "game status".
+	GAMESTATUS getStatus() const
+	{
+		return status;
+	}
+	/// Get the remaining bomb count.
+	int32_t getRemainingBombs() const
+	{
+		return remaining;
+	}
+	/// Get the count of requests answered by the server.
+	uint64_t getAnswered() const
+	{
+		return answered;
+	}
+
+private:
+	MirrorBoard board;
+	GAMESTATUS status;
+	int32_t remaining;
+	uint64_t answered;
+};
+
+} // namespace msm
+
+#endif /* PROTOCOL_HPP_ */
+
+///\}
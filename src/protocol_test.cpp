@@ -0,0 +1,198 @@
+/**
+ * @file protocol_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include "protocol.hpp"
+
+namespace
+{
+bool isBomb(msm::Field const& f)
+{
+	return dynamic_cast<msm::Bomb const*>(&f) != 0;
+}
+
+/// Deliver the requests in pieces of a size and the update in one piece.
+void transfer(msm::ServerSession& server, std::vector<uint8_t>& requests, msm::ClientSession& client, size_t piece)
+{
+	std::vector<uint8_t> received;
+	for (size_t offset = 0; offset < requests.size(); offset += piece)
+	{
+		size_t const end = std::min(requests.size(), offset + piece);
+		received.insert(received.end(), requests.begin() + offset, requests.begin() + end);
+		size_t consumed = 0;
+		BOOST_REQUIRE(server.receive(&received[0], received.size(), consumed));
+		received.erase(received.begin(), received.begin() + consumed);
+	}
+	BOOST_CHECK(received.empty());
+	requests.clear();
+
+	std::vector<uint8_t> update;
+	server.flush(update);
+	size_t consumed = 0;
+	BOOST_REQUIRE(client.receive(&update[0], update.size(), consumed));
+	BOOST_CHECK(update.size() == consumed);
+}
+
+void checkSame(msm::Matrix const& matrix, msm::ClientSession const& client)
+{
+	BOOST_CHECK(matrix.getStatus() == client.getStatus());
+	BOOST_CHECK(matrix.getRemainingBombs() == client.getRemainingBombs());
+	uint32_t i = 0;
+	for (msm::CellIterator it = matrix.begin(); it != matrix.end(); ++it, ++i)
+		BOOST_CHECK(msm::packCell(it->getStatus(), it->getAdjacentBombs()) == client.getBoard().getCell(i));
+}
+}
+
+BOOST_AUTO_TEST_SUITE(protocol_test_suite)
+
+BOOST_AUTO_TEST_CASE(loopback_test)
+{
+	msm::ServerSession server;
+	msm::ClientSession client;
+	std::vector<uint8_t> requests;
+	std::vector<uint8_t> update;
+	BOOST_CHECK(0 == server.flush(update));
+
+	msm::encodeReset(requests, msm::Dimensions(30, 16, 40), 4711);
+	BOOST_CHECK(msm::PROTOCOL_RESET == requests.size());
+	transfer(server, requests, client, 3);
+	BOOST_CHECK(1 == client.getAnswered());
+	BOOST_CHECK(30 == client.getBoard().getWidth());
+	checkSame(server.getMatrix(), client);
+
+	// Pipelined moves, answered by one update per batch
+	uint64_t sent = 1;
+	for (unsigned batch = 0; batch < 20 && client.getStatus() != msm::GS_LOST; ++batch)
+	{
+		for (unsigned i = 0; i < 7; ++i, ++sent)
+		{
+			uint16_t const x = (batch * 11 + i * 7) % 30, y = (batch * 5 + i * 3) % 16;
+			msm::encodeAction(requests, i % 3 ? msm::MT_REVEAL : msm::MT_MARK, x, y);
+		}
+		BOOST_CHECK(7 * msm::PROTOCOL_ACTION == requests.size());
+		transfer(server, requests, client, batch % 4 + 1);
+		BOOST_CHECK(sent == client.getAnswered());
+		BOOST_CHECK(0 == server.getPending());
+		checkSame(server.getMatrix(), client);
+	}
+
+	// A reset and a move in one batch
+	msm::encodeReset(requests, msm::Dimensions(8, 9, 10, msm::TP_TORUS), 1);
+	msm::encodeAction(requests, msm::MT_MARK, 2, 3);
+	transfer(server, requests, client, 64);
+	BOOST_CHECK(9 == client.getBoard().getHeight());
+	BOOST_CHECK(msm::FS_MARKED == (client.getBoard().getCell(3 * 8 + 2) & msm::CELL_STATUS_MASK));
+	checkSame(server.getMatrix(), client);
+}
+
+BOOST_AUTO_TEST_CASE(chord_test)
+{
+	msm::ServerSession server;
+	msm::ClientSession client;
+	std::vector<uint8_t> requests;
+	msm::encodeReset(requests, msm::Dimensions(16, 16, 40), 99);
+	transfer(server, requests, client, 64);
+	msm::Matrix const& matrix = server.getMatrix();
+
+	// A field with adjacent bombs
+	uint16_t x = 1, y = 1;
+	while (isBomb(matrix.at(x, y)) || !matrix.at(x, y).getAdjacentBombs())
+		if (++x == 15)
+			x = 1, ++y;
+	msm::encodeAction(requests, msm::MT_REVEAL, x, y);
+	// Not enough marks: nothing happens
+	msm::encodeAction(requests, msm::MT_CHORD, x, y);
+	transfer(server, requests, client, 64);
+	BOOST_REQUIRE(msm::FS_UNHIDDEN == matrix.at(x, y).getStatus());
+	msm::NeighbourRange const range = matrix.neighbours(x, y);
+	for (msm::NeighbourIterator it = range.begin(); it != range.end(); ++it)
+		BOOST_CHECK(msm::FS_HIDDEN == it->getStatus());
+
+	// Mark the bombs, the chord reveals the others
+	for (msm::NeighbourIterator it = range.begin(); it != range.end(); ++it)
+		if (isBomb(*it))
+			msm::encodeAction(requests, msm::MT_MARK, it->getPosition().X, it->getPosition().Y);
+	msm::encodeAction(requests, msm::MT_CHORD, x, y);
+	transfer(server, requests, client, 64);
+	for (msm::NeighbourIterator it = range.begin(); it != range.end(); ++it)
+		BOOST_CHECK((isBomb(*it) ? msm::FS_MARKED : msm::FS_UNHIDDEN) == it->getStatus());
+	checkSame(matrix, client);
+}
+
+BOOST_AUTO_TEST_CASE(malformed_test)
+{
+	std::vector<uint8_t> requests;
+	size_t consumed = 0;
+	{
+		// A move before the first reset
+		msm::ServerSession server;
+		msm::encodeAction(requests, msm::MT_REVEAL, 0, 0);
+		BOOST_CHECK(!server.receive(&requests[0], requests.size(), consumed));
+	}
+	{
+		// Outside of the board
+		msm::ServerSession server;
+		requests.clear();
+		msm::encodeReset(requests, msm::Dimensions(10, 10, 10), 1);
+		msm::encodeAction(requests, msm::MT_REVEAL, 0, 10);
+		BOOST_CHECK(!server.receive(&requests[0], requests.size(), consumed));
+		BOOST_CHECK(msm::PROTOCOL_RESET == consumed);
+	}
+	{
+		// Too large, unknown type
+		msm::ServerSession server;
+		requests.clear();
+		msm::encodeReset(requests, msm::Dimensions(2000, 2000, 10), 1);
+		BOOST_CHECK(!server.receive(&requests[0], requests.size(), consumed));
+		uint8_t const unknown[] = { msm::MT_UPDATE, 0, 0, 0, 0 };
+		BOOST_CHECK(!server.receive(unknown, sizeof(unknown), consumed));
+	}
+	{
+		// Incomplete requests wait for the rest
+		msm::ServerSession server;
+		requests.clear();
+		msm::encodeReset(requests, msm::Dimensions(10, 10, 10), 1);
+		BOOST_CHECK(server.receive(&requests[0], requests.size() - 1, consumed));
+		BOOST_CHECK(0 == consumed);
+		BOOST_CHECK(0 == server.getPending());
+	}
+	{
+		msm::ClientSession client;
+		uint8_t update[msm::PROTOCOL_UPDATE] = { msm::MT_RESET };
+		BOOST_CHECK(!client.receive(update, sizeof(update), consumed));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(pending_test)
+{
+	msm::ServerSession server;
+	std::vector<uint8_t> requests;
+	msm::encodeReset(requests, msm::Dimensions(10, 10, 10), 1);
+	for (uint32_t i = 0; i < msm::PROTOCOL_MAX_PENDING + 100; ++i)
+		msm::encodeAction(requests, msm::MT_MARK, i % 10, 0);
+
+	// The requests beyond the limit wait for the next flush
+	size_t consumed = 0;
+	BOOST_CHECK(server.receive(&requests[0], requests.size(), consumed));
+	BOOST_CHECK(server.isFull());
+	BOOST_CHECK(msm::PROTOCOL_MAX_PENDING == server.getPending());
+	BOOST_CHECK(msm::PROTOCOL_RESET + (msm::PROTOCOL_MAX_PENDING - 1) * msm::PROTOCOL_ACTION == consumed);
+
+	std::vector<uint8_t> update;
+	BOOST_CHECK(server.flush(update) > 0);
+	BOOST_CHECK(!server.isFull());
+	size_t rest = 0;
+	BOOST_CHECK(server.receive(&requests[consumed], requests.size() - consumed, rest));
+	BOOST_CHECK(requests.size() == consumed + rest);
+	BOOST_CHECK(101 == server.getPending());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,251 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file sharedBoard.cpp
+ *
+ * Implementation of \ref sharedBoard.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "sharedBoard.hpp"
+
+#include <stdlib.h>
+#include <new>
+
+#include "threadPool.hpp"
+
+namespace msm
+{
+
+namespace
+{
+/// Hands out the shard of each thread round-robin.
+std::atomic<unsigned> nextThread(0);
+}
+
+SharedBoard::SharedBoard(unsigned shards) :
+		size(0), shardCount(shards ? shards : ThreadPool::hardwareThreads()), shards(0), started(false), lost(
+				false)
+{
+	void* memory = 0;
+	if (posix_memalign(&memory, alignof(Shard), shardCount * sizeof(Shard)) != 0)
+		throw std::bad_alloc();
+	this->shards = static_cast<Shard*>(memory);
+	for (unsigned s = 0; s < shardCount; ++s)
+		new (&this->shards[s]) Shard();
+}
+
+SharedBoard::~SharedBoard()
+{
+	for (unsigned s = 0; s < shardCount; ++s)
+		shards[s].~Shard();
+	free(shards);
+}
+
+void SharedBoard::reset(Dimensions const& dimensions, uint32_t seed)
+{
+	uint16_t const cols = dimensions.getX();
+	uint16_t const rows = dimensions.getY();
+	bool const reshape = !cells || size != (uint32_t) cols * rows || dim.getX() != cols
+			|| dim.getTopology() != dimensions.getTopology();
+	bool const resize = !cells || size != (uint32_t) cols * rows;
+
+	dim = dimensions;
+	size = (uint32_t) cols * rows;
+	started.store(false);
+	lost.store(false);
+	for (unsigned s = 0; s < shardCount; ++s)
+	{
+		shards[s].unhidden.store(0);
+		shards[s].marked.store(0);
+	}
+
+	if (reshape)
+	{
+		grid.shape(cols, rows, dim.getTopology());
+		grid.link(links);
+
+		// The border has no bomb
+		bombs.assign(size + 1, 0);
+		adjacent.resize(size + 1);
+	}
+	if (resize)
+		cells.reset(new std::atomic<uint32_t>[size + 1]);
+
+	uint32_t const hidden = (uint32_t) NO_PLAYER << PLAYER_SHIFT | FS_HIDDEN;
+	for (uint32_t i = 0; i < size; ++i)
+		cells[i].store(hidden, std::memory_order_relaxed);
+	cells[size].store((uint32_t) NO_PLAYER << PLAYER_SHIFT | FS_UNHIDDEN, std::memory_order_relaxed);
+
+	if (!size)
+		return;
+
+	placeBombs(dim, seed, &bombs[0]);
+
+	// Count via the links
+	for (uint16_t y = 0; y < rows; ++y)
+	{
+		uint32_t const* l = &links[grid.index(0, y)];
+		int32_t const* offsets = grid.offsets(y);
+		for (uint16_t x = 0; x < cols; ++x, ++l)
+		{
+			uint8_t a = 0;
+			for (uint8_t n = 0; n < grid.getNeighbourCount(); ++n)
+				a += bombs[l[offsets[n]]];
+			adjacent[(uint32_t) y * cols + x] = a;
+		}
+	}
+}
+
+GAMESTATUS SharedBoard::getStatus() const
+{
+	// Same rule as the Matrix
+	if (lost.load(std::memory_order_acquire))
+		return GS_LOST;
+	if (getUnhidden() == size - dim.getBombs() && getMarked() == dim.getBombs())
+		return GS_WON;
+	return started.load(std::memory_order_acquire) ? GS_RUNNING : GS_READY;
+}
+
+uint32_t SharedBoard::getUnhidden() const
+{
+	int64_t sum = 0;
+	for (unsigned s = 0; s < shardCount; ++s)
+		sum += shards[s].unhidden.load(std::memory_order_relaxed);
+	return (uint32_t) sum;
+}
+
+uint32_t SharedBoard::getMarked() const
+{
+	// A single shard may go negative when one thread marks and another one unmarks
+	int64_t sum = 0;
+	for (unsigned s = 0; s < shardCount; ++s)
+		sum += shards[s].marked.load(std::memory_order_relaxed);
+	return (uint32_t) sum;
+}
+
+void SharedBoard::getScores(std::vector<uint32_t>& scores) const
+{
+	scores.clear();
+	for (uint32_t i = 0; i < size; ++i)
+	{
+		uint32_t c = cells[i].load(std::memory_order_relaxed);
+		uint16_t player = (uint16_t) (c >> PLAYER_SHIFT);
+		if ((c & STATUS_MASK) != FS_UNHIDDEN || player == NO_PLAYER)
+			continue;
+		if (player >= scores.size())
+			scores.resize(player + 1, 0);
+		++scores[player];
+	}
+}
+
+bool SharedBoard::tryOpen(std::atomic<uint32_t>& cell, uint32_t player)
+{
+	uint32_t c = cell.load(std::memory_order_relaxed);
+	do
+	{
+		uint32_t s = c & STATUS_MASK;
+		if (s != FS_HIDDEN && s != FS_QUERIED)
+			return false;
+	} while (!cell.compare_exchange_weak(c, player << PLAYER_SHIFT | FS_UNHIDDEN, std::memory_order_acq_rel,
+			std::memory_order_relaxed));
+	return true;
+}
+
+uint32_t SharedBoard::reveal(uint32_t index, uint16_t player)
+{
+	std::atomic<uint32_t>& cell = cells[index];
+	if (bombs[index])
+	{
+		uint32_t c = cell.load(std::memory_order_relaxed);
+		do
+		{
+			uint32_t s = c & STATUS_MASK;
+			if (s != FS_HIDDEN && s != FS_QUERIED)
+				return 0;
+		} while (!cell.compare_exchange_weak(c, (uint32_t) player << PLAYER_SHIFT | FS_BOMB,
+				std::memory_order_acq_rel, std::memory_order_relaxed));
+		started.store(true, std::memory_order_release);
+		lost.store(true, std::memory_order_release);
+		return 0;
+	}
+
+	// Only the thread that opened a field expands it, so each field is expanded once
+	static thread_local std::vector<uint32_t> stack;
+	uint32_t opened = 0;
+	stack.clear();
+	stack.push_back(index);
+	while (!stack.empty())
+	{
+		uint32_t i = stack.back();
+		stack.pop_back();
+		// Fields without adjacent bombs have no bomb neighbours, the border is revealed.
+		if (!tryOpen(cells[i], player))
+			continue;
+
+		++opened;
+		if (adjacent[i] == 0)
+		{
+			uint16_t const x = i % dim.getX();
+			uint16_t const y = i / dim.getX();
+			uint32_t const* l = &links[grid.index(x, y)];
+			int32_t const* offsets = grid.offsets(y);
+			for (uint8_t n = grid.getNeighbourCount(); n-- > 0;)
+				stack.push_back(l[offsets[n]]);
+		}
+	}
+
+	if (opened)
+	{
+		shard().unhidden.fetch_add(opened, std::memory_order_relaxed);
+		started.store(true, std::memory_order_release);
+	}
+	return opened;
+}
+
+FIELDSTATUS SharedBoard::cycleMark(uint32_t index, uint16_t player)
+{
+	std::atomic<uint32_t>& cell = cells[index];
+	uint32_t c = cell.load(std::memory_order_relaxed);
+	uint32_t next;
+	int delta;
+	do
+	{
+		switch (c & STATUS_MASK)
+		{
+		case FS_HIDDEN:
+			next = FS_MARKED;
+			delta = 1;
+			break;
+		case FS_MARKED:
+			next = FS_QUERIED;
+			delta = -1;
+			break;
+		case FS_QUERIED:
+			next = FS_HIDDEN;
+			delta = 0;
+			break;
+		default:
+			return (FIELDSTATUS) (c & STATUS_MASK);
+		}
+	} while (!cell.compare_exchange_weak(c, (uint32_t) player << PLAYER_SHIFT | next, std::memory_order_acq_rel,
+			std::memory_order_relaxed));
+
+	if (delta)
+		shard().marked.fetch_add(delta, std::memory_order_relaxed);
+	started.store(true, std::memory_order_release);
+	return (FIELDSTATUS) next;
+}
+
+SharedBoard::Shard& SharedBoard::shard()
+{
+	static thread_local unsigned thread = nextThread.fetch_add(1, std::memory_order_relaxed);
+	return shards[thread % shardCount];
+}
+
+} // namespace msm
+
+///\}
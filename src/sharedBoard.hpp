@@ -0,0 +1,165 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file sharedBoard.hpp
+ *
+ * A board that many players mutate at the same time, for co-op and race modes.
+ *
+ * A \ref msm::Matrix "matrix" must only be used by one thread: Field::reveal() walks
+ * the neighbours without any synchronization and notifies observers on the way.
+ * A \ref msm::SharedBoard "shared board" has no field objects and no observers like
+ * the \ref msm::SimulationBoard "simulation board", but every field is one atomic word
+ * that holds the status and the player who changed it last. Each status transition is
+ * a compare-and-swap, so exactly one player opens a field. Cascades of different
+ * threads that run into each other cooperate: A thread only expands the fields it
+ * opened itself and skips those opened by another thread, which expands them instead.
+ *
+ * The counters are sharded per thread and padded to separate cache lines, so the
+ * threads don't contend on one counter. Reading the \ref msm::SharedBoard::getStatus()
+ * "status" sums up the shards.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef SHAREDBOARD_HPP_
+#define SHAREDBOARD_HPP_
+
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "generator.hpp"
+#include "grid.hpp"
+#include "matrix.hpp"
+
+namespace msm
+{
+
+/// The player of a field that no player has touched yet.
+const uint16_t NO_PLAYER = 0xFFFF;
+
+/**
+ * A board that is safe to mutate from many threads at once.
+ * The fields are addressed by their row-major index (y * width + x).
+ * The rules are the same as the rules of the matrix: A serial sequence of moves gives
+ * the same board as on a Matrix with the same seed.
+ * \note Only \ref reveal() and \ref cycleMark() may be called concurrently with
+ * each other and the getters. \ref reset() needs exclusive access.
+ * \note While moves are running the counters may lag behind the fields.
+ * They are exact as soon as all moves returned.
+ */
+class SharedBoard
+{
+public:
+	/** Create an empty board.
+	 * \param shards The count of counter shards. 0 for one per hardware thread. */
+	explicit SharedBoard(unsigned shards = 0);
+	/// Destructor.
+	~SharedBoard();
+
+	/** Start a new game with the layout of Matrix::reset(dimensions, seed).
+	 * \param dimensions The dimensions.
+	 * \param seed The seed for the bomb placement. */
+	void reset(Dimensions const& dimensions, uint32_t seed);
+
+	/// Get the \ref Dimensions.
+	Dimensions const& getDimensions() const
+	{
+		return dim;
+	}
+	/// Get the count of fields.
+	uint32_t getSize() const
+	{
+		return size;
+	}
+	/// Get the count of counter shards.
+	unsigned getShardCount() const
+	{
+		return shardCount;
+	}
+	/// Get the \ref #GAMESTATUS "game status".
+	GAMESTATUS getStatus() const;
+	/// Get the count of revealed fields.
+	uint32_t getUnhidden() const;
+	/// Get the count of marked fields.
+	uint32_t getMarked() const;
+
+	/// Get the \ref #FIELDSTATUS "status" of a field.
+	FIELDSTATUS getFieldStatus(uint32_t index) const
+	{
+		return (FIELDSTATUS) (cells[index].load(std::memory_order_acquire) & STATUS_MASK);
+	}
+	/** Get the player who changed the field last, e.g. who revealed it.
+	 * \return The player or \ref NO_PLAYER. */
+	uint16_t getPlayer(uint32_t index) const
+	{
+		return (uint16_t) (cells[index].load(std::memory_order_acquire) >> PLAYER_SHIFT);
+	}
+	/// Get the count of adjacent bombs of a revealed field. 0 for all other fields.
+	uint8_t getAdjacentBombs(uint32_t index) const
+	{
+		return getFieldStatus(index) == FS_UNHIDDEN ? adjacent[index] : 0;
+	}
+	/** Count the revealed fields of each player, e.g. for the scores of a race.
+	 * \param scores Resized to the highest player + 1 and receives the counts. */
+	void getScores(std::vector<uint32_t>& scores) const;
+
+	/** Reveal a field like Field::reveal(). Thread-safe.
+	 * \param index The field.
+	 * \param player The player, less than \ref NO_PLAYER. Recorded for every field
+	 * that this call reveals.
+	 * \return The count of fields revealed by this call. */
+	uint32_t reveal(uint32_t index, uint16_t player);
+	/** Cycle the mark of a field like Field::cycleMark(). Thread-safe.
+	 * \param index The field.
+	 * \param player The player, less than \ref NO_PLAYER.
+	 * \return The new status, or the unchanged status of a revealed field. */
+	FIELDSTATUS cycleMark(uint32_t index, uint16_t player);
+
+private:
+	static const uint32_t STATUS_MASK = 0xFF;
+	static const unsigned PLAYER_SHIFT = 16;
+
+	/// The counters of some threads. Each shard fills a cache line of its own.
+	struct alignas(64) Shard
+	{
+		Shard() :
+				unhidden(0), marked(0)
+		{
+		}
+		std::atomic<int64_t> unhidden;
+		std::atomic<int64_t> marked;
+	};
+
+	Dimensions dim;
+	uint32_t size;
+	unsigned const shardCount;
+	/// Allocated aligned to a cache line, which new[] doesn't guarantee for over-aligned types.
+	Shard* shards;
+	std::atomic<bool> started;
+	std::atomic<bool> lost;
+
+	Grid grid;
+	/// The field of each padded index. The border refers to the extra field at index size.
+	std::vector<uint32_t> links;
+	/// Status and player of each field plus the always revealed border.
+	std::unique_ptr<std::atomic<uint32_t>[]> cells;
+	std::vector<uint8_t> adjacent;
+	std::vector<uint8_t> bombs;
+
+	Shard& shard();
+	/// Reveal a hidden or queried field for the player. False if another move got it first.
+	static bool tryOpen(std::atomic<uint32_t>& cell, uint32_t player);
+
+	SharedBoard(SharedBoard const& cp);
+	SharedBoard& operator=(SharedBoard const& cp);
+};
+
+} // namespace msm
+
+#endif /* SHAREDBOARD_HPP_ */
+
+///\}
@@ -0,0 +1,141 @@
+/**
+ * @file sharedBoard_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "sharedBoard.hpp"
+#include "simulation.hpp"
+
+BOOST_AUTO_TEST_SUITE(sharedBoard_test_suite)
+
+BOOST_AUTO_TEST_CASE(serial_test)
+{
+	// Serial moves give the same board as the simulation board (and so the matrix)
+	msm::Dimensions d(30, 20, 80, msm::TP_HEX);
+	msm::SharedBoard shared(3);
+	msm::SimulationBoard board;
+	shared.reset(d, 5);
+	board.reset(d, 5);
+	BOOST_CHECK(3 == shared.getShardCount());
+	BOOST_CHECK(msm::GS_READY == shared.getStatus());
+	BOOST_CHECK(msm::NO_PLAYER == shared.getPlayer(0));
+
+	for (uint32_t i = 0; i < 600; i += 7)
+	{
+		if (i % 3 == 0)
+		{
+			board.cycleMark(i);
+			BOOST_CHECK(shared.cycleMark(i, 1) == board.getFieldStatus(i));
+		}
+		else if (board.getStatus() != msm::GS_LOST)
+			BOOST_CHECK(shared.reveal(i, 2) == board.reveal(i));
+	}
+
+	BOOST_CHECK(shared.getStatus() == board.getStatus());
+	BOOST_CHECK(shared.getUnhidden() == board.getUnhidden());
+	BOOST_CHECK(shared.getMarked() == board.getMarked());
+	for (uint32_t i = 0; i < 600; ++i)
+	{
+		BOOST_CHECK(shared.getFieldStatus(i) == board.getFieldStatus(i));
+		BOOST_CHECK(shared.getAdjacentBombs(i) == board.getAdjacentBombs(i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_test)
+{
+	msm::Dimensions d(200, 150, 3000);
+	msm::SharedBoard shared;
+	shared.reset(d, 17);
+	uint32_t const size = shared.getSize();
+	std::vector<uint8_t> bombs(size);
+	msm::placeBombs(d, 17, &bombs[0]);
+	unsigned const PLAYERS = 4;
+
+	// All players reveal every field without a bomb, each in another order, and mark
+	// every bomb. Each field is opened by exactly one of them.
+	std::vector<uint32_t> opened(PLAYERS, 0);
+	std::vector<std::thread> players;
+	for (unsigned p = 0; p < PLAYERS; ++p)
+		players.push_back(std::thread([&, p]()
+		{
+			for (uint32_t k = 0; k < size; ++k)
+			{
+				uint32_t i = p % 2 ? size - 1 - k : (uint32_t) (((uint64_t) k * 7919 + p) % size);
+				if (!bombs[i])
+					opened[p] += shared.reveal(i, (uint16_t) p);
+				else if (i % PLAYERS == p)
+					shared.cycleMark(i, (uint16_t) p);
+			}
+		}));
+	for (size_t t = 0; t < players.size(); ++t)
+		players[t].join();
+
+	std::vector<uint32_t> scores;
+	shared.getScores(scores);
+	BOOST_REQUIRE(scores.size() <= PLAYERS);
+	scores.resize(PLAYERS, 0);
+	uint32_t total = 0;
+	for (unsigned p = 0; p < PLAYERS; ++p)
+	{
+		BOOST_CHECK(opened[p] == scores[p]);
+		total += opened[p];
+	}
+	BOOST_CHECK(size - d.getBombs() == total);
+	BOOST_CHECK(size - d.getBombs() == shared.getUnhidden());
+	BOOST_CHECK(d.getBombs() == shared.getMarked());
+	BOOST_CHECK(msm::GS_WON == shared.getStatus());
+
+	for (uint32_t i = 0; i < size; ++i)
+	{
+		BOOST_CHECK(shared.getFieldStatus(i) == (bombs[i] ? msm::FS_MARKED : msm::FS_UNHIDDEN));
+		BOOST_CHECK(shared.getPlayer(i) < PLAYERS);
+	}
+}
+
+BOOST_AUTO_TEST_CASE(mark_test)
+{
+	// Concurrent mark cycles keep the counter in line with the fields
+	msm::SharedBoard shared(2);
+	shared.reset(msm::Dimensions(10, 10, 10), 3);
+	std::vector<std::thread> players;
+	for (unsigned p = 0; p < 4; ++p)
+		players.push_back(std::thread([&shared, p]()
+		{
+			for (unsigned k = 0; k < 10000 + p; ++k)
+				shared.cycleMark(k % 7, (uint16_t) p);
+		}));
+	for (size_t t = 0; t < players.size(); ++t)
+		players[t].join();
+
+	uint32_t marked = 0;
+	for (uint32_t i = 0; i < 7; ++i)
+		marked += shared.getFieldStatus(i) == msm::FS_MARKED;
+	BOOST_CHECK(marked == shared.getMarked());
+	BOOST_CHECK(msm::GS_RUNNING == shared.getStatus());
+
+	// Revealed fields can't be marked, a bomb loses the game
+	shared.reset(msm::Dimensions(10, 10, 10), 3);
+	std::vector<uint8_t> bombs(100);
+	msm::placeBombs(shared.getDimensions(), 3, &bombs[0]);
+	uint32_t bomb = 0, free = 0;
+	while (!bombs[bomb])
+		++bomb;
+	while (bombs[free])
+		++free;
+	BOOST_CHECK(shared.reveal(free, 0) > 0);
+	BOOST_CHECK(msm::FS_UNHIDDEN == shared.cycleMark(free, 1));
+	BOOST_CHECK(0 == shared.getPlayer(free));
+	BOOST_CHECK(0 == shared.reveal(bomb, 1));
+	BOOST_CHECK(msm::FS_BOMB == shared.getFieldStatus(bomb));
+	BOOST_CHECK(1 == shared.getPlayer(bomb));
+	BOOST_CHECK(msm::GS_LOST == shared.getStatus());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,301 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file signal.hpp
+ *
+ * A lightweight signal/slot mechanism with the ergonomics of boost::signals2.
+ *
+ * \code
+ * msm::Connection c = matrix.signalFieldStatusChanged.connect(&onStatusChanged);
+ * ...
+ * c.disconnect();
+ * \endcode
+ *
+ * Unlike boost::signals2 a signal takes no lock and doesn't allocate on emission:
+ * The slots are kept in a vector and called by index. A signal must only be used by
+ * one thread at a time, like the \ref msm::Matrix "matrix" that emits it.
+ * Slots may connect or disconnect slots of the same signal while it is emitted, and even
+ * destroy the signal. Slots connected during an emission are called from the next emission on.
+ * If a slot throws, the emission ends and the exception is passed on.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef SIGNAL_HPP_
+#define SIGNAL_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace msm
+{
+
+namespace detail
+{
+/// The part of a signal that is shared with its connections.
+struct SignalBase
+{
+	virtual ~SignalBase()
+	{
+	}
+	virtual void disconnect(uint64_t id) = 0;
+	virtual bool connected(uint64_t id) const = 0;
+};
+}
+
+/**
+ * The handle of a slot that is connected to a \ref Signal.
+ * The handle may outlive the signal, it is disconnected then.
+ */
+class Connection
+{
+public:
+	/// Create a handle that is not connected.
+	Connection() :
+			id(0)
+	{
+	}
+	/// \internal
+	Connection(std::weak_ptr<detail::SignalBase> const& signal, uint64_t id) :
+			signal(signal), id(id)
+	{
+	}
+
+	/// Disconnect the slot. Does nothing if it is not connected.
+	void disconnect() const
+	{
+		std::shared_ptr<detail::SignalBase> s = signal.lock();
+		if (s)
+			s->disconnect(id);
+	}
+	/// Check if the slot is connected.
+	bool connected() const
+	{
+		std::shared_ptr<detail::SignalBase> s = signal.lock();
+		return s && s->connected(id);
+	}
+
+private:
+	std::weak_ptr<detail::SignalBase> signal;
+	uint64_t id;
+};
+
+/// A \ref Connection that is disconnected when the handle is destroyed.
+class ScopedConnection: public Connection
+{
+public:
+	ScopedConnection()
+	{
+	}
+	ScopedConnection(Connection const& c) :
+			Connection(c)
+	{
+	}
+	~ScopedConnection()
+	{
+		disconnect();
+	}
+	ScopedConnection& operator=(Connection const& c)
+	{
+		disconnect();
+		Connection::operator=(c);
+		return *this;
+	}
+
+private:
+	ScopedConnection(ScopedConnection const& cp);
+	ScopedConnection& operator=(ScopedConnection const& cp);
+};
+
+template<typename Signature>
+class Signal;
+
+/**
+ * A signal with the signature void(Args...).
+ * \note The slots are called in the order they were connected.
+ */
+template<typename ... Args>
+class Signal<void(Args...)>
+{
+public:
+	/// The type of a slot.
+	typedef std::function<void(Args...)> Slot;
+
+	Signal()
+	{
+	}
+	/// Destructor. Disconnects all slots.
+	~Signal()
+	{
+		if (slots)
+			slots->clear();
+	}
+
+	/** Connect a slot.
+	 * \param slot A callable with the signature of the signal.
+	 * \return The handle to disconnect the slot. */
+	Connection connect(Slot const& slot)
+	{
+		if (!slots)
+			slots = std::make_shared<Slots>();
+		Slots& s = *slots;
+		// Don't move the running slots
+		(s.emitting ? s.pending : s.entries).push_back(Entry(++s.lastId, slot));
+		++s.count;
+		s.dirty |= s.emitting != 0;
+		return Connection(slots, s.lastId);
+	}
+	/// Disconnect all slots.
+	void disconnectAll()
+	{
+		if (slots)
+			slots->clear();
+	}
+	/// Check if no slot is connected.
+	bool empty() const
+	{
+		return numSlots() == 0;
+	}
+	/// Get the count of connected slots.
+	size_t numSlots() const
+	{
+		return slots ? slots->count : 0;
+	}
+
+	/// Call all connected slots.
+	void operator()(Args ... args) const
+	{
+		if (!slots || !slots->count)
+			return;
+
+		// Keeps the slots alive if a slot destroys the signal
+		std::shared_ptr<Slots> const keep(slots);
+		Slots& s = *keep;
+		{
+			Emission const emission(s);
+			for (size_t i = 0, n = s.entries.size(); i < n; ++i)
+			{
+				if (s.entries[i].id)
+					s.entries[i].slot(args...);
+			}
+		}
+		if (!s.emitting && s.dirty)
+			s.compact();
+	}
+
+private:
+	struct Entry
+	{
+		Entry(uint64_t id, Slot const& slot) :
+				id(id), slot(slot)
+		{
+		}
+		/// 0 when disconnected.
+		uint64_t id;
+		Slot slot;
+	};
+
+	struct Slots: public detail::SignalBase
+	{
+		Slots() :
+				lastId(0), count(0), emitting(0), dirty(false)
+		{
+		}
+
+		std::vector<Entry> entries;
+		/// Connected while emitting.
+		std::vector<Entry> pending;
+		uint64_t lastId;
+		size_t count;
+		unsigned emitting;
+		/// Disconnected or pending entries have to be merged.
+		bool dirty;
+
+		Entry* find(uint64_t id)
+		{
+			for (size_t i = 0; i < entries.size(); ++i)
+				if (entries[i].id == id)
+					return &entries[i];
+			for (size_t i = 0; i < pending.size(); ++i)
+				if (pending[i].id == id)
+					return &pending[i];
+			return 0;
+		}
+		void disconnect(uint64_t id)
+		{
+			Entry* e = find(id);
+			if (!e)
+				return;
+			// Only marked: the slot might be running
+			e->id = 0;
+			--count;
+			dirty = true;
+			if (!emitting)
+				compact();
+		}
+		bool connected(uint64_t id) const
+		{
+			return const_cast<Slots*>(this)->find(id) != 0;
+		}
+		void clear()
+		{
+			for (size_t i = 0; i < entries.size(); ++i)
+				entries[i].id = 0;
+			pending.clear();
+			count = 0;
+			dirty = true;
+			if (!emitting)
+				compact();
+		}
+		void compact()
+		{
+			size_t k = 0;
+			for (size_t i = 0; i < entries.size(); ++i)
+			{
+				if (entries[i].id)
+				{
+					if (k != i)
+						entries[k] = entries[i];
+					++k;
+				}
+			}
+			entries.erase(entries.begin() + k, entries.end());
+			for (size_t i = 0; i < pending.size(); ++i)
+				if (pending[i].id)
+					entries.push_back(pending[i]);
+			pending.clear();
+			dirty = false;
+		}
+	};
+
+	/// Counts a running emission, also if a slot throws. The next emission compacts then.
+	struct Emission
+	{
+		explicit Emission(Slots& s) :
+				s(s)
+		{
+			++s.emitting;
+		}
+		~Emission()
+		{
+			--s.emitting;
+		}
+		Slots& s;
+	};
+
+	std::shared_ptr<Slots> slots;
+
+	Signal(Signal const& cp);
+	Signal& operator=(Signal const& cp);
+};
+
+} // namespace msm
+
+#endif /* SIGNAL_HPP_ */
+
+///\}
@@ -0,0 +1,161 @@
+/**
+ * @file signal_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include "matrix.hpp"
+#include "signal.hpp"
+
+namespace
+{
+struct Recorder
+{
+	std::vector<int> calls;
+	void operator()(int value)
+	{
+		calls.push_back(value);
+	}
+};
+}
+
+BOOST_AUTO_TEST_SUITE(signal_test_suite)
+
+BOOST_AUTO_TEST_CASE(connect_test)
+{
+	msm::Signal<void(int)> signal;
+	BOOST_CHECK(signal.empty());
+	// Emitting without slots is fine
+	signal(0);
+
+	std::vector<int> calls;
+	msm::Connection a = signal.connect([&](int v)
+	{	calls.push_back(v);});
+	msm::Connection b = signal.connect([&](int v)
+	{	calls.push_back(10 * v);});
+	BOOST_CHECK(2 == signal.numSlots());
+	BOOST_CHECK(a.connected());
+
+	signal(1);
+	BOOST_REQUIRE(2 == calls.size());
+	BOOST_CHECK(1 == calls[0]);
+	BOOST_CHECK(10 == calls[1]);
+
+	a.disconnect();
+	BOOST_CHECK(!a.connected());
+	BOOST_CHECK(b.connected());
+	signal(2);
+	BOOST_REQUIRE(3 == calls.size());
+	BOOST_CHECK(20 == calls[2]);
+
+	// Twice is harmless
+	a.disconnect();
+	signal.disconnectAll();
+	BOOST_CHECK(!b.connected());
+	signal(3);
+	BOOST_CHECK(3 == calls.size());
+}
+
+BOOST_AUTO_TEST_CASE(emission_test)
+{
+	msm::Signal<void(int)> signal;
+	std::vector<int> calls;
+	msm::Connection self, late;
+
+	// A slot disconnects itself and connects another one while the signal is emitted
+	self = signal.connect([&](int v)
+	{
+		calls.push_back(v);
+		self.disconnect();
+		late = signal.connect([&](int w)
+				{	calls.push_back(100 + w);});
+	});
+	Recorder recorder;
+	signal.connect(std::ref(recorder));
+
+	signal(1);
+	BOOST_REQUIRE(1 == calls.size());
+	BOOST_CHECK(1 == recorder.calls.size());
+	BOOST_CHECK(!self.connected());
+	BOOST_CHECK(late.connected());
+
+	signal(2);
+	BOOST_REQUIRE(2 == calls.size());
+	BOOST_CHECK(102 == calls[1]);
+	BOOST_CHECK(2 == recorder.calls.size());
+}
+
+BOOST_AUTO_TEST_CASE(exception_test)
+{
+	msm::Signal<void(int)> signal;
+	std::vector<int> calls;
+	msm::Connection thrower = signal.connect([&](int v)
+	{
+		calls.push_back(v);
+		throw v;
+	});
+	BOOST_CHECK_THROW(signal(1), int);
+
+	// The signal still merges new slots and compacts
+	signal.connect([&](int v)
+	{	calls.push_back(10 * v);});
+	thrower.disconnect();
+	BOOST_CHECK(1 == signal.numSlots());
+	signal(2);
+	BOOST_REQUIRE(2 == calls.size());
+	BOOST_CHECK(20 == calls[1]);
+
+	// A slot destroys the signal, the later slots aren't called anymore
+	msm::Signal<void(int)>* owned = new msm::Signal<void(int)>();
+	owned->connect([&](int)
+	{	delete owned;});
+	owned->connect([&](int v)
+	{	calls.push_back(v);});
+	(*owned)(3);
+	BOOST_CHECK(2 == calls.size());
+}
+
+BOOST_AUTO_TEST_CASE(lifetime_test)
+{
+	msm::Connection c;
+	BOOST_CHECK(!c.connected());
+	int calls = 0;
+	{
+		msm::Signal<void(int)> signal;
+		c = signal.connect([&](int)
+		{	++calls;});
+		{
+			msm::ScopedConnection scoped(signal.connect([&](int)
+			{	++calls;}));
+			signal(0);
+			BOOST_CHECK(2 == calls);
+		}
+		signal(0);
+		BOOST_CHECK(3 == calls);
+	}
+	// The handle outlives the signal
+	BOOST_CHECK(!c.connected());
+	c.disconnect();
+}
+
+BOOST_AUTO_TEST_CASE(matrix_test)
+{
+	msm::Matrix matrix(msm::Dimensions(10, 10, 0));
+	int fields = 0, games = 0;
+	msm::ScopedConnection f(matrix.signalFieldStatusChanged.connect([&](msm::Field const&, msm::FIELDSTATUS s)
+	{	fields += s == msm::FS_UNHIDDEN;}));
+	msm::ScopedConnection g(matrix.signalGameStatusChanged.connect([&](msm::Matrix const&, msm::GAMESTATUS)
+	{	++games;}));
+
+	// One emission per revealed field
+	matrix.reveal(5, 5);
+	BOOST_CHECK(100 == fields);
+	BOOST_CHECK(games > 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,326 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file simulation.cpp
+ *
+ * Implementation of \ref simulation.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "simulation.hpp"
+
+#include <algorithm>
+
+namespace msm
+{
+
+namespace
+{
+/// Count of games of a task.
+uint64_t const GAMES_PER_TASK = 16;
+}
+
+SimulationBoard::SimulationBoard() :
+		size(0), status(GS_READY), unhidden(0), marked(0)
+{
+}
+
+void SimulationBoard::reset(Dimensions const& dimensions, uint32_t seed)
+{
+	uint16_t const cols = dimensions.getX();
+	uint16_t const rows = dimensions.getY();
+	bool const reshape = size != (uint32_t) cols * rows || dim.getX() != cols
+			|| dim.getTopology() != dimensions.getTopology();
+
+	dim = dimensions;
+	size = (uint32_t) cols * rows;
+	status = GS_READY;
+	unhidden = 0;
+	marked = 0;
+
+	if (reshape)
+	{
+		grid.shape(cols, rows, dim.getTopology());
+		grid.link(links);
+
+		// The border has no bomb
+		bombs.assign(size + 1, 0);
+		adjacent.resize(size + 1);
+		fields.resize(size + 1);
+	}
+
+	std::fill(fields.begin(), fields.end() - 1, (uint8_t) FS_HIDDEN);
+	fields[size] = FS_UNHIDDEN;
+
+	if (!size)
+		return;
+
+	placeBombs(dim, seed, &bombs[0]);
+
+	// Count via the links
+	for (uint16_t y = 0; y < rows; ++y)
+	{
+		uint32_t const* l = &links[grid.index(0, y)];
+		int32_t const* offsets = grid.offsets(y);
+		for (uint16_t x = 0; x < cols; ++x, ++l)
+		{
+			uint8_t a = 0;
+			for (uint8_t n = 0; n < grid.getNeighbourCount(); ++n)
+				a += bombs[l[offsets[n]]];
+			adjacent[(uint32_t) y * cols + x] = a;
+		}
+	}
+}
+
+uint8_t SimulationBoard::getNeighbours(uint32_t index, uint32_t* neighbours) const
+{
+	uint16_t const x = index % dim.getX();
+	uint16_t const y = index / dim.getX();
+	uint32_t const* l = &links[grid.index(x, y)];
+	int32_t const* offsets = grid.offsets(y);
+
+	uint8_t count = 0;
+	for (uint8_t n = 0; n < grid.getNeighbourCount(); ++n)
+	{
+		uint32_t i = l[offsets[n]];
+		if (i != size)
+			neighbours[count++] = i;
+	}
+	return count;
+}
+
+uint32_t SimulationBoard::reveal(uint32_t index)
+{
+	uint8_t& f = fields[index];
+	if (f == FS_MARKED || f == FS_UNHIDDEN || f == FS_BOMB)
+		return 0;
+
+	if (bombs[index])
+	{
+		f = FS_BOMB;
+		status = GS_LOST;
+		return 0;
+	}
+
+	uint32_t const before = unhidden;
+	stack.clear();
+	stack.push_back(index);
+	while (!stack.empty())
+	{
+		uint32_t i = stack.back();
+		stack.pop_back();
+		// Fields without adjacent bombs have no bomb neighbours, the border is revealed.
+		if (fields[i] == FS_MARKED || fields[i] == FS_UNHIDDEN)
+			continue;
+
+		fields[i] = FS_UNHIDDEN;
+		++unhidden;
+		if (adjacent[i] == 0)
+		{
+			uint16_t const x = i % dim.getX();
+			uint16_t const y = i / dim.getX();
+			uint32_t const* l = &links[grid.index(x, y)];
+			int32_t const* offsets = grid.offsets(y);
+			for (uint8_t n = grid.getNeighbourCount(); n-- > 0;)
+				stack.push_back(l[offsets[n]]);
+		}
+	}
+
+	update();
+	return unhidden - before;
+}
+
+void SimulationBoard::cycleMark(uint32_t index)
+{
+	uint8_t& f = fields[index];
+	switch (f)
+	{
+	case FS_HIDDEN:
+		f = FS_MARKED;
+		++marked;
+		break;
+	case FS_MARKED:
+		f = FS_QUERIED;
+		--marked;
+		break;
+	case FS_QUERIED:
+		f = FS_HIDDEN;
+		break;
+	default:
+		return;
+	}
+	update();
+}
+
+void SimulationBoard::update()
+{
+	// Same rule as the Matrix
+	if (status != GS_LOST)
+	{
+		if (unhidden == size - dim.getBombs() && marked == dim.getBombs())
+			status = GS_WON;
+		else
+			status = GS_RUNNING;
+	}
+}
+
+void SimpleStrategy::next(SimulationBoard const& board, Random& random, std::vector<Move>& moves) const
+{
+	uint32_t const size = board.getSize();
+
+	// Only bombs left
+	if (board.getUnhidden() == size - board.getDimensions().getBombs())
+	{
+		for (uint32_t i = 0; i < size; ++i)
+			if (board.getFieldStatus(i) == FS_HIDDEN)
+				moves.push_back(Move(i, MT_MARK));
+		return;
+	}
+
+	uint32_t neighbours[MAX_NEIGHBOURS];
+	uint32_t hidden[MAX_NEIGHBOURS];
+	for (uint32_t i = 0; i < size; ++i)
+	{
+		uint8_t bombs = board.getAdjacentBombs(i);
+		if (bombs == 0)
+			continue;
+
+		uint8_t n = board.getNeighbours(i, neighbours);
+		uint8_t h = 0, m = 0;
+		for (uint8_t k = 0; k < n; ++k)
+		{
+			FIELDSTATUS s = board.getFieldStatus(neighbours[k]);
+			if (s == FS_HIDDEN)
+				hidden[h++] = neighbours[k];
+			else if (s == FS_MARKED)
+				++m;
+		}
+		if (h == 0)
+			continue;
+
+		if (m == bombs)
+			for (uint8_t k = 0; k < h; ++k)
+				moves.push_back(Move(hidden[k], MT_REVEAL));
+		else if (m + h == bombs)
+			for (uint8_t k = 0; k < h; ++k)
+				moves.push_back(Move(hidden[k], MT_MARK));
+	}
+
+	if (!moves.empty())
+		return;
+
+	// Guess: Reservoir sampling over the hidden fields
+	uint32_t candidates = 0, guess = 0;
+	for (uint32_t i = 0; i < size; ++i)
+	{
+		if (board.getFieldStatus(i) == FS_HIDDEN && random.below(++candidates) == 0)
+			guess = i;
+	}
+	if (candidates)
+		moves.push_back(Move(guess, MT_REVEAL, true));
+}
+
+void Statistics::add(GameResult const& result)
+{
+	++games;
+	won += result.status == GS_WON;
+	lost += result.status == GS_LOST;
+	moves += result.moves;
+	reveals += result.reveals;
+	revealed += result.revealed;
+	guesses += result.guesses;
+}
+
+void Statistics::merge(Statistics const& other)
+{
+	games += other.games;
+	won += other.won;
+	lost += other.lost;
+	moves += other.moves;
+	reveals += other.reveals;
+	revealed += other.revealed;
+	guesses += other.guesses;
+}
+
+Simulation::Simulation(unsigned threads) :
+		pool(threads)
+{
+}
+
+Statistics Simulation::run(Dimensions const& dimensions, Strategy const& strategy, uint64_t games,
+		uint32_t firstSeed)
+{
+	unsigned const threads = pool.getThreadCount();
+	std::vector<SimulationBoard> boards(threads);
+	std::vector<Statistics> statistics(threads);
+
+	pool.run((games + GAMES_PER_TASK - 1) / GAMES_PER_TASK, [&](size_t task, unsigned thread)
+	{
+		uint64_t last = std::min(games, (task + 1) * GAMES_PER_TASK);
+		for (uint64_t g = task * GAMES_PER_TASK; g < last; ++g)
+			statistics[thread].add(play(boards[thread], dimensions, (uint32_t) (firstSeed + g), strategy));
+	});
+
+	Statistics total;
+	for (unsigned t = 0; t < threads; ++t)
+		total.merge(statistics[t]);
+	return total;
+}
+
+GameResult Simulation::play(SimulationBoard& board, Dimensions const& dimensions, uint32_t seed,
+		Strategy const& strategy, std::vector<Move>* log)
+{
+	board.reset(dimensions, seed);
+	Random random(seed, STRATEGY_STREAM);
+
+	GameResult result;
+	// Every move that changes the board reveals, marks or unmarks a field
+	uint64_t const limit = 4 * (uint64_t) board.getSize() + 1;
+	std::vector<Move> moves;
+	uint64_t turns = 0;
+
+	while (board.getStatus() <= GS_RUNNING && ++turns <= limit)
+	{
+		moves.clear();
+		strategy.next(board, random, moves);
+		if (moves.empty())
+			break;
+
+		for (std::vector<Move>::const_iterator it = moves.begin(); it != moves.end(); ++it)
+		{
+			if (board.getStatus() > GS_RUNNING)
+				break;
+
+			FIELDSTATUS before = board.getFieldStatus(it->index);
+			if (it->type == MT_REVEAL)
+			{
+				uint32_t revealed = board.reveal(it->index);
+				if (revealed)
+				{
+					++result.reveals;
+					result.revealed += revealed;
+				}
+			}
+			else if (before == FS_HIDDEN)
+				board.cycleMark(it->index);
+
+			if (board.getFieldStatus(it->index) == before)
+				continue;
+
+			++result.moves;
+			result.guesses += it->guess;
+			if (log)
+				log->push_back(*it);
+		}
+	}
+
+	result.status = board.getStatus();
+	return result;
+}
+
+} // namespace msm
+
+///\}
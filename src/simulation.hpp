@@ -0,0 +1,260 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file simulation.hpp
+ *
+ * Headless simulation of complete games, e.g. to tune the difficulty of presets.
+ *
+ * The games are played on a \ref msm::SimulationBoard "stripped-down board" without
+ * field objects, observers or signals. The layout of a game is produced by the same
+ * generator as \ref msm::Matrix::reset(Dimensions const&, uint32_t) "Matrix::reset()"
+ * and the rules are the same, so a game gives the same result as the same moves on
+ * a Matrix with the same seed.
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef SIMULATION_HPP_
+#define SIMULATION_HPP_
+
+#include <stdint.h>
+#include <vector>
+
+#include "generator.hpp"
+#include "grid.hpp"
+#include "matrix.hpp"
+#include "threadPool.hpp"
+
+namespace msm
+{
+
+/// The random stream of a game that is used by the \ref Strategy (the layout uses the streams below).
+const uint64_t STRATEGY_STREAM = 1ull << 32;
+
+/**
+ * A board for simulations. Holds only one status byte and the adjacent bombs per field.
+ * The fields are addressed by their row-major index (y * width + x).
+ */
+class SimulationBoard
+{
+public:
+	/// Create an empty board.
+	SimulationBoard();
+
+	/** Start a new game with the layout of Matrix::reset(dimensions, seed).
+	 * \param dimensions The dimensions.
+	 * \param seed The seed for the bomb placement. */
+	void reset(Dimensions const& dimensions, uint32_t seed);
+
+	/// Get the \ref Dimensions.
+	Dimensions const& getDimensions() const
+	{
+		return dim;
+	}
+	/// Get the count of fields.
+	uint32_t getSize() const
+	{
+		return size;
+	}
+	/// Get the \ref #GAMESTATUS "game status".
+	GAMESTATUS getStatus() const
+	{
+		return status;
+	}
+	/// Get the count of revealed fields.
+	uint32_t getUnhidden() const
+	{
+		return unhidden;
+	}
+	/// Get the count of marked fields.
+	uint32_t getMarked() const
+	{
+		return marked;
+	}
+	/// Get the \ref #FIELDSTATUS "status" of a field.
+	FIELDSTATUS getFieldStatus(uint32_t index) const
+	{
+		return (FIELDSTATUS) fields[index];
+	}
+	/// Get the count of adjacent bombs of a revealed field. 0 for all other fields.
+	uint8_t getAdjacentBombs(uint32_t index) const
+	{
+		return fields[index] == FS_UNHIDDEN ? adjacent[index] : 0;
+	}
+	/** Get the neighbours of a field in the topology of the board.
+	 * \param index The field.
+	 * \param neighbours Receives up to \ref MAX_NEIGHBOURS indices.
+	 * \return The count of neighbours. */
+	uint8_t getNeighbours(uint32_t index, uint32_t* neighbours) const;
+
+	/** Reveal a field like Field::reveal().
+	 * \return The count of revealed fields. */
+	uint32_t reveal(uint32_t index);
+	/// Cycle the mark of a field like Field::cycleMark().
+	void cycleMark(uint32_t index);
+
+private:
+	Dimensions dim;
+	uint32_t size;
+	GAMESTATUS status;
+	uint32_t unhidden;
+	uint32_t marked;
+
+	Grid grid;
+	/// The field of each padded index. The border refers to the extra field at index size.
+	std::vector<uint32_t> links;
+	/// One status per field plus the always revealed border.
+	std::vector<uint8_t> fields;
+	std::vector<uint8_t> adjacent;
+	std::vector<uint8_t> bombs;
+	std::vector<uint32_t> stack;
+
+	void update();
+};
+
+/// The type of a \ref Move.
+enum MOVETYPE
+{
+	MT_REVEAL, //!< Reveal the field.
+	MT_MARK    //!< Mark the field if it is hidden, otherwise nothing happens.
+};
+
+/// A move of a \ref Strategy.
+struct Move
+{
+	/// Constructor.
+	Move(uint32_t index, MOVETYPE type, bool guess = false) :
+			index(index), type(type), guess(guess)
+	{
+	}
+	/// The row-major index of the field.
+	uint32_t index;
+	/// The action.
+	MOVETYPE type;
+	/// True if the strategy had to guess.
+	bool guess;
+};
+
+/// Interface for the player of simulated games.
+struct Strategy
+{
+	virtual ~Strategy()
+	{
+	}
+	/**
+	 * Choose the next moves. Called until the game is over or no move is returned.
+	 * \note The same strategy is used by all threads at the same time.
+	 * \param board The board.
+	 * \param random The random numbers of the current game.
+	 * \param moves Receives the moves. They are applied in order until the game is over.
+	 */
+	virtual void next(SimulationBoard const& board, Random& random, std::vector<Move>& moves) const = 0;
+};
+
+/**
+ * A simple strategy: Reveals or marks all neighbours of revealed fields whose
+ * count of adjacent bombs is already satisfied. Guesses a random hidden field
+ * if nothing is certain.
+ */
+struct SimpleStrategy: public Strategy
+{
+	void next(SimulationBoard const& board, Random& random, std::vector<Move>& moves) const;
+};
+
+/// The outcome of a single game.
+struct GameResult
+{
+	GameResult() :
+			status(GS_READY), moves(0), reveals(0), revealed(0), guesses(0)
+	{
+	}
+	/// GS_WON or GS_LOST. Other values if the strategy gave up or hit the move limit.
+	GAMESTATUS status;
+	/// The count of moves that changed the board.
+	uint32_t moves;
+	/// The count of reveal moves that changed the board.
+	uint32_t reveals;
+	/// The count of fields revealed by these moves.
+	uint32_t revealed;
+	/// The count of guesses.
+	uint32_t guesses;
+};
+
+/// Aggregated outcome of many games.
+struct Statistics
+{
+	Statistics() :
+			games(0), won(0), lost(0), moves(0), reveals(0), revealed(0), guesses(0)
+	{
+	}
+
+	uint64_t games;
+	uint64_t won;
+	uint64_t lost;
+	uint64_t moves;
+	uint64_t reveals;
+	uint64_t revealed;
+	uint64_t guesses;
+
+	/// Add a game.
+	void add(GameResult const& result);
+	/// Add the games of other statistics.
+	void merge(Statistics const& other);
+
+	/// The ratio of won games.
+	double getWinRate() const
+	{
+		return games ? (double) won / games : 0;
+	}
+	/// The average count of fields revealed per reveal.
+	double getAverageCascade() const
+	{
+		return reveals ? (double) revealed / reveals : 0;
+	}
+	/// The average count of guesses per game.
+	double getAverageGuesses() const
+	{
+		return games ? (double) guesses / games : 0;
+	}
+};
+
+/**
+ * Plays many games in parallel.
+ * Game i uses the seed firstSeed + i, the results don't depend on the count of threads.
+ */
+class Simulation
+{
+public:
+	/** Constructor.
+	 * \param threads The count of threads. 0 for one per hardware thread. */
+	explicit Simulation(unsigned threads = 0);
+
+	/** Play games.
+	 * \param dimensions The dimensions of the games.
+	 * \param strategy The player.
+	 * \param games The count of games.
+	 * \param firstSeed The seed of the first game.
+	 * \return The aggregated results. */
+	Statistics run(Dimensions const& dimensions, Strategy const& strategy, uint64_t games, uint32_t firstSeed = 0);
+
+	/** Play one game.
+	 * \param board The board to play on.
+	 * \param dimensions The dimensions of the game.
+	 * \param seed The seed of the game.
+	 * \param strategy The player.
+	 * \param log Receives the moves that changed the board, if not 0.
+	 * \return The result. */
+	static GameResult play(SimulationBoard& board, Dimensions const& dimensions, uint32_t seed,
+			Strategy const& strategy, std::vector<Move>* log = 0);
+
+private:
+	ThreadPool pool;
+};
+
+} // namespace msm
+
+#endif /* SIMULATION_HPP_ */
+
+///\}
@@ -0,0 +1,139 @@
+/**
+ * @file simulation_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include "simulation.hpp"
+
+namespace
+{
+/// Apply the moves of a simulated game to a matrix.
+void replay(msm::Matrix& matrix, std::vector<msm::Move> const& moves)
+{
+	uint16_t const width = matrix.getDimensions().getX();
+	for (std::vector<msm::Move>::const_iterator it = moves.begin(); it != moves.end(); ++it)
+	{
+		msm::Field& f = matrix.at(it->index % width, it->index / width);
+		if (it->type == msm::MT_REVEAL)
+			f.reveal();
+		else
+			f.cycleMark();
+	}
+}
+
+void checkSameBoard(msm::Matrix const& matrix, msm::SimulationBoard const& board)
+{
+	BOOST_CHECK(matrix.getStatus() == board.getStatus());
+	uint32_t i = 0;
+	for (msm::CellIterator it = matrix.begin(); it != matrix.end(); ++it, ++i)
+	{
+		BOOST_CHECK(it->getStatus() == board.getFieldStatus(i));
+		if (it->getStatus() == msm::FS_UNHIDDEN)
+			BOOST_CHECK(it->getAdjacentBombs() == board.getAdjacentBombs(i));
+	}
+}
+}
+
+BOOST_AUTO_TEST_SUITE(simulation_test_suite)
+
+BOOST_AUTO_TEST_CASE(board_test)
+{
+	msm::Dimensions d(20, 15, 40);
+	msm::Matrix matrix;
+	msm::SimulationBoard board;
+
+	matrix.reset(d, 12);
+	board.reset(d, 12);
+	BOOST_CHECK(300 == board.getSize());
+	BOOST_CHECK(msm::GS_READY == board.getStatus());
+
+	uint32_t neighbours[msm::MAX_NEIGHBOURS];
+	BOOST_CHECK(3 == board.getNeighbours(0, neighbours));
+	BOOST_CHECK(8 == board.getNeighbours(21, neighbours));
+
+	// Mark and query some fields, then reveal everything that is no bomb
+	for (uint32_t i = 0; i < 300; i += 7)
+	{
+		matrix.at(i % 20, i / 20).cycleMark();
+		board.cycleMark(i);
+		if (i % 2)
+		{
+			matrix.at(i % 20, i / 20).cycleMark();
+			board.cycleMark(i);
+		}
+	}
+	for (uint32_t i = 0; i < 300; ++i)
+	{
+		if (dynamic_cast<msm::Bomb*>(&matrix.at(i % 20, i / 20)))
+			continue;
+		matrix.at(i % 20, i / 20).reveal();
+		board.reveal(i);
+	}
+	checkSameBoard(matrix, board);
+	BOOST_CHECK(msm::GS_RUNNING == board.getStatus());
+	BOOST_CHECK(matrix.getRemainingBombs() == (int32_t) 40 - (int32_t) board.getMarked());
+}
+
+BOOST_AUTO_TEST_CASE(replay_test)
+{
+	msm::TOPOLOGY const topologies[] = { msm::TP_PLANE, msm::TP_TORUS, msm::TP_HEX };
+	msm::SimpleStrategy strategy;
+	msm::SimulationBoard board;
+	msm::Matrix matrix;
+	int won = 0, lost = 0;
+
+	for (int t = 0; t < 3; ++t)
+	{
+		msm::Dimensions d(16, 16, 30, topologies[t]);
+		for (uint32_t seed = 0; seed < 40; ++seed)
+		{
+			std::vector<msm::Move> log;
+			msm::GameResult r = msm::Simulation::play(board, d, seed, strategy, &log);
+			BOOST_CHECK(log.size() == r.moves);
+			won += r.status == msm::GS_WON;
+			lost += r.status == msm::GS_LOST;
+
+			// The same moves on a matrix with the same seed give the same game
+			matrix.reset(d, seed);
+			replay(matrix, log);
+			BOOST_CHECK(matrix.getStatus() == r.status);
+			checkSameBoard(matrix, board);
+		}
+	}
+	BOOST_CHECK(120 == won + lost);
+	BOOST_CHECK(won > 0 && lost > 0);
+}
+
+BOOST_AUTO_TEST_CASE(run_test)
+{
+	msm::Dimensions d(9, 9, 10);
+	msm::SimpleStrategy strategy;
+
+	msm::Statistics a = msm::Simulation(1).run(d, strategy, 500, 100);
+	msm::Statistics b = msm::Simulation(3).run(d, strategy, 500, 100);
+
+	// Independent of the count of threads
+	BOOST_CHECK(500 == a.games);
+	BOOST_CHECK(a.won == b.won && a.lost == b.lost && a.moves == b.moves);
+	BOOST_CHECK(a.revealed == b.revealed && a.guesses == b.guesses);
+	BOOST_CHECK(500 == a.won + a.lost);
+	BOOST_CHECK(a.getWinRate() > 0.3 && a.getWinRate() < 1.0);
+	BOOST_CHECK(a.getAverageGuesses() >= 1.0);
+	BOOST_CHECK(a.getAverageCascade() > 1.0);
+
+	// Trivial boards
+	msm::Statistics empty = msm::Simulation(2).run(msm::Dimensions(5, 5, 0), strategy, 10);
+	BOOST_CHECK(1.0 == empty.getWinRate());
+	BOOST_CHECK(25.0 == empty.getAverageCascade());
+	msm::Statistics full = msm::Simulation(2).run(msm::Dimensions(3, 3, 9), strategy, 10);
+	BOOST_CHECK(1.0 == full.getWinRate());
+	BOOST_CHECK(0 == full.guesses);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
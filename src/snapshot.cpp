@@ -0,0 +1,144 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file snapshot.cpp
+ *
+ * Implementation of \ref snapshot.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "snapshot.hpp"
+
+#include <algorithm>
+
+namespace msm
+{
+
+Snapshot::Snapshot(uint64_t version, MatrixClone const& board, Snapshot const* previous, uint32_t history,
+		bool reset) :
+		version(version), board(board), previous(previous), history(history), reset(reset)
+{
+}
+
+bool Snapshot::getChanges(uint64_t since, std::vector<uint32_t>& changes) const
+{
+	changes.clear();
+	if (since > version || since + history < version)
+		return false;
+
+	// The versions after since are retained as long as this one is acquired
+	for (Snapshot const* s = this; s->version > since; s = s->previous)
+	{
+		if (s->reset)
+		{
+			changes.clear();
+			return false;
+		}
+		changes.insert(changes.end(), s->changes.begin(), s->changes.end());
+	}
+	std::sort(changes.begin(), changes.end());
+	changes.erase(std::unique(changes.begin(), changes.end()), changes.end());
+	return true;
+}
+
+/*
+ * A reader announces the latest version in its slot before it loads the current
+ * snapshot. The game thread stores the current snapshot before it scans the slots. With
+ * sequentially consistent order either the scan sees the announcement, or the reader
+ * loads a snapshot that is newer than the versions freed by the scan. Since the game
+ * thread frees a version only if it is older than each announced version by more than
+ * the history, the acquired snapshot and its history stay valid until the release.
+ *
+ * The readers never copy a snapshot or its tiles, all reference counts are changed by
+ * the game thread only. So the copy-on-write of the matrix never races a reader.
+ */
+SnapshotPublisher::SnapshotPublisher(unsigned readers, uint32_t history) :
+		readers(readers), history(history), slots(new Slot[readers]), latest(0), current(0), resetPending(true),
+		changed(true)
+{
+}
+
+SnapshotPublisher::~SnapshotPublisher()
+{
+}
+
+uint64_t SnapshotPublisher::publish(Matrix const& matrix)
+{
+	uint64_t const last = latest.load(std::memory_order_relaxed);
+	if (!changed)
+		return last;
+
+	std::sort(pending.begin(), pending.end());
+	pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+	uint64_t const version = last + 1;
+	Snapshot* s = new Snapshot(version, matrix.clone(), current.load(std::memory_order_relaxed), history,
+			resetPending);
+	s->changes.swap(pending);
+	retained.push_back(std::unique_ptr<Snapshot const>(s));
+	pending.clear();
+	resetPending = false;
+	changed = false;
+
+	current.store(s);
+	latest.store(version);
+
+	// Free the versions no reader can refer to
+	uint64_t oldest = version;
+	for (unsigned r = 0; r < readers; ++r)
+	{
+		uint64_t const v = slots[r].version.load();
+		if (v && v < oldest)
+			oldest = v;
+	}
+	while (retained.front()->version + history < oldest)
+		retained.pop_front();
+	return version;
+}
+
+Snapshot const* SnapshotPublisher::acquire(unsigned reader) const
+{
+	uint64_t const version = latest.load();
+	if (!version)
+		return 0;
+	slots[reader].version.store(version);
+	return current.load();
+}
+
+void SnapshotPublisher::release(unsigned reader) const
+{
+	slots[reader].version.store(0, std::memory_order_release);
+}
+
+void SnapshotPublisher::onGameStatusChanged(Matrix const&, GAMESTATUS status)
+{
+	if (status == GS_READY)
+	{
+		pending.clear();
+		resetPending = true;
+	}
+	changed = true;
+}
+
+void SnapshotPublisher::onRemainingBombsChanged(Matrix const&, int32_t)
+{
+	changed = true;
+}
+
+void SnapshotPublisher::onFieldStatusChanged(Matrix const& matrix, Field const& field, FIELDSTATUS)
+{
+	Position const& p = field.getPosition();
+	pending.push_back((uint32_t) p.Y * matrix.getDimensions().getX() + p.X);
+	changed = true;
+}
+
+void SnapshotPublisher::onFieldDelete(Matrix const&, Field const&)
+{
+}
+
+} // namespace msm
+
+///\}
@@ -0,0 +1,243 @@
+/**
+ * \addtogroup lib
+ * \{
+ *
+ * \file snapshot.hpp
+ *
+ * Immutable, versioned snapshots of a \ref msm::Matrix "matrix" for many reader threads,
+ * e.g. the spectators of a tournament game.
+ *
+ * The game thread \ref msm::SnapshotPublisher::publish() "publishes" a new version after
+ * its moves. A version is a \ref msm::MatrixClone "clone" of the matrix, so it costs O(1)
+ * and shares all unchanged tiles with the previous version. Readers never block the game
+ * thread and never wait for each other: A reader announces the version it is about to
+ * read in a slot of its own and reads without any lock (read-copy-update). The game
+ * thread only frees a version when no slot can still refer to it.
+ *
+ * Each version knows the fields changed since the version before, so a reader can ask
+ * for the \ref msm::Snapshot::getChanges() "changes since" the last version it has seen
+ * instead of reading the whole board.
+ *
+ * \code
+ * // Game thread
+ * publisher.publish(matrix);
+ * // Reader thread r
+ * msm::SnapshotLock lock(publisher, r);
+ * if (!lock->getChanges(seen, changes))
+ *     ... send the whole board
+ * seen = lock->getVersion();
+ * \endcode
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef SNAPSHOT_HPP_
+#define SNAPSHOT_HPP_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "matrix.hpp"
+#include "matrixClone.hpp"
+
+namespace msm
+{
+
+/**
+ * An immutable version of a board, created by \ref SnapshotPublisher::publish().
+ * All methods are safe to call from any count of threads.
+ * \warning Accessing a position outside of the board is undefined behaviour.
+ */
+class Snapshot
+{
+public:
+	/// Get the version. The first version is 1.
+	uint64_t getVersion() const
+	{
+		return version;
+	}
+	/// Get the \ref Dimensions.
+	Dimensions const& getDimensions() const
+	{
+		return board.getDimensions();
+	}
+	/// Get the \ref #GAMESTATUS "game status".
+	GAMESTATUS getStatus() const
+	{
+		return board.getStatus();
+	}
+	/// Get the remaining bomb count.
+	int32_t getRemainingBombs() const
+	{
+		return board.getRemainingBombs();
+	}
+	/// Get the \ref #FIELDSTATUS "status" of a field.
+	FIELDSTATUS getFieldStatus(uint16_t x, uint16_t y) const
+	{
+		return board.getFieldStatus(x, y);
+	}
+	/// Get the count of adjacent bombs of a revealed field. 0 for all other fields.
+	uint8_t getAdjacentBombs(uint16_t x, uint16_t y) const
+	{
+		return board.getFieldStatus(x, y) == FS_UNHIDDEN ? board.getAdjacentBombs(x, y) : 0;
+	}
+
+	/** Get the fields that changed after a version up to this one.
+	 * \param since A version not newer than this one.
+	 * \param changes Receives the row-major indices of the changed fields in ascending order.
+	 * \return False if the changes are not known anymore: The version is older than the
+	 * \ref SnapshotPublisher "history" or the matrix was reset after it. Read the whole
+	 * board instead. */
+	bool getChanges(uint64_t since, std::vector<uint32_t>& changes) const;
+
+private:
+	friend class SnapshotPublisher;
+
+	Snapshot(uint64_t version, MatrixClone const& board, Snapshot const* previous, uint32_t history, bool reset);
+
+	uint64_t const version;
+	MatrixClone const board;
+	/// The version before. Only valid for the versions of the history.
+	Snapshot const* const previous;
+	uint32_t const history;
+	/// True if the matrix was reset since the previous version.
+	bool const reset;
+	/// The fields changed since the previous version, ascending.
+	std::vector<uint32_t> changes;
+};
+
+/**
+ * Publishes the \ref Snapshot "snapshots" of one matrix to reader threads.
+ *
+ * Register the publisher as \ref MatrixObserver of the matrix, it collects the changed
+ * fields between two versions. \ref publish() and the destructor must be called by the
+ * thread that manipulates the matrix. The readers use \ref acquire() and \ref release()
+ * or a \ref SnapshotLock, each with a reader slot of its own.
+ */
+class SnapshotPublisher: public MatrixObserver
+{
+public:
+	/** Constructor.
+	 * \param readers The count of reader slots, one per reader thread.
+	 * \param history The count of versions before the acquired one, for which
+	 * \ref Snapshot::getChanges() can tell the changes. */
+	explicit SnapshotPublisher(unsigned readers, uint32_t history = 64);
+	/// Destructor. No reader may hold a snapshot anymore.
+	virtual ~SnapshotPublisher();
+
+	/** Publish the current state of the matrix as a new version, if anything changed.
+	 * Frees the versions that no reader can refer to anymore.
+	 * \param matrix The matrix. The publisher must be registered as its observer.
+	 * \return The latest version. */
+	uint64_t publish(Matrix const& matrix);
+
+	/// Get the latest version. 0 before the first publish.
+	uint64_t getVersion() const
+	{
+		return latest.load(std::memory_order_acquire);
+	}
+	/// Get the count of reader slots.
+	unsigned getReaders() const
+	{
+		return readers;
+	}
+	/// Get the count of versions that are not freed yet. Game thread only.
+	size_t getRetained() const
+	{
+		return retained.size();
+	}
+
+	/** Get the latest snapshot for a reader. Lock-free, it never waits for the game thread.
+	 * The snapshot stays valid until \ref release().
+	 * \param reader The slot of the reader, less than \ref getReaders().
+	 * \return The snapshot. 0 before the first publish. */
+	Snapshot const* acquire(unsigned reader) const;
+	/** Give the snapshot of a reader back.
+	 * \param reader The slot of the reader. */
+	void release(unsigned reader) const;
+
+	/// \internal
+	void onGameStatusChanged(Matrix const& matrix, GAMESTATUS status);
+	/// \internal
+	void onRemainingBombsChanged(Matrix const& matrix, int32_t bombs);
+	/// \internal
+	void onFieldStatusChanged(Matrix const& matrix, Field const& field, FIELDSTATUS status);
+	/// \internal
+	void onFieldDelete(Matrix const& matrix, Field const& field);
+
+private:
+	/// The version a reader announced. The padding keeps two readers out of one cache line.
+	struct Slot
+	{
+		Slot() :
+				version(0)
+		{
+		}
+		std::atomic<uint64_t> version;
+		char padding[64 - sizeof(std::atomic<uint64_t>)];
+	};
+
+	unsigned const readers;
+	uint32_t const history;
+	std::unique_ptr<Slot[]> slots;
+	std::atomic<uint64_t> latest;
+	std::atomic<Snapshot const*> current;
+	/// The versions that are not freed yet, oldest first.
+	std::deque<std::unique_ptr<Snapshot const> > retained;
+
+	/// The fields changed since the latest version.
+	std::vector<uint32_t> pending;
+	bool resetPending;
+	bool changed;
+
+	SnapshotPublisher(SnapshotPublisher const& cp);
+	SnapshotPublisher& operator=(SnapshotPublisher const& cp);
+};
+
+/// Holds the latest snapshot of a \ref SnapshotPublisher for the scope of a reader.
+class SnapshotLock
+{
+public:
+	/** Acquire the latest snapshot.
+	 * \param publisher The publisher.
+	 * \param reader The slot of the reader. */
+	SnapshotLock(SnapshotPublisher const& publisher, unsigned reader) :
+			publisher(publisher), reader(reader), snapshot(publisher.acquire(reader))
+	{
+	}
+	/// Release the snapshot.
+	~SnapshotLock()
+	{
+		publisher.release(reader);
+	}
+
+	/// Get the snapshot. 0 before the first publish.
+	Snapshot const* get() const
+	{
+		return snapshot;
+	}
+	/// Access the snapshot.
+	Snapshot const* operator->() const
+	{
+		return snapshot;
+	}
+
+private:
+	SnapshotPublisher const& publisher;
+	unsigned const reader;
+	Snapshot const* const snapshot;
+
+	SnapshotLock(SnapshotLock const& cp);
+	SnapshotLock& operator=(SnapshotLock const& cp);
+};
+
+} // namespace msm
+
+#endif /* SNAPSHOT_HPP_ */
+
+///\}
@@ -0,0 +1,209 @@
+/**
+ * @file snapshot_test.cpp
+ *
+ * @date 18.10.2026
+ * @author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "snapshot.hpp"
+
+namespace
+{
+/// True if a snapshot shows the same board as the matrix.
+bool same(msm::Matrix const& matrix, msm::Snapshot const& snapshot)
+{
+	if (matrix.getStatus() != snapshot.getStatus() || matrix.getRemainingBombs() != snapshot.getRemainingBombs())
+		return false;
+	for (msm::CellIterator it = matrix.begin(); it != matrix.end(); ++it)
+	{
+		msm::Position const& p = it->getPosition();
+		if (it->getStatus() != snapshot.getFieldStatus(p.X, p.Y))
+			return false;
+	}
+	return true;
+}
+}
+
+BOOST_AUTO_TEST_SUITE(snapshot_test_suite)
+
+BOOST_AUTO_TEST_CASE(version_test)
+{
+	msm::Matrix matrix;
+	msm::SnapshotPublisher publisher(2);
+	matrix.addObserver(&publisher);
+	matrix.reset(msm::Dimensions(30, 16, 99), 4711);
+
+	BOOST_CHECK(0 == publisher.getVersion());
+	BOOST_CHECK(0 == publisher.acquire(0));
+	publisher.release(0);
+
+	BOOST_CHECK(1 == publisher.publish(matrix));
+	// Nothing changed
+	BOOST_CHECK(1 == publisher.publish(matrix));
+
+	msm::SnapshotLock first(publisher, 0);
+	BOOST_REQUIRE(first.get());
+	BOOST_CHECK(1 == first->getVersion());
+	BOOST_CHECK(same(matrix, *first.get()));
+	std::vector<uint32_t> changes;
+	BOOST_CHECK(first->getChanges(1, changes));
+	BOOST_CHECK(changes.empty());
+	// The reset is before the first version
+	BOOST_CHECK(!first->getChanges(0, changes));
+
+	matrix.at(3, 4).cycleMark();
+	matrix.at(20, 10).cycleMark();
+	BOOST_CHECK(2 == publisher.publish(matrix));
+	matrix.at(20, 10).cycleMark();
+	matrix.at(7, 2).cycleMark();
+	BOOST_CHECK(3 == publisher.publish(matrix));
+
+	{
+		msm::SnapshotLock last(publisher, 1);
+		BOOST_REQUIRE(last.get());
+		BOOST_CHECK(3 == last->getVersion());
+		BOOST_CHECK(same(matrix, *last.get()));
+		BOOST_CHECK(msm::FS_QUERIED == last->getFieldStatus(20, 10));
+
+		BOOST_CHECK(last->getChanges(1, changes));
+		BOOST_REQUIRE(3 == changes.size());
+		BOOST_CHECK(2 * 30 + 7 == changes[0]);
+		BOOST_CHECK(4 * 30 + 3 == changes[1]);
+		BOOST_CHECK(10 * 30 + 20 == changes[2]);
+		BOOST_CHECK(last->getChanges(2, changes));
+		BOOST_CHECK(2 == changes.size());
+		BOOST_CHECK(!last->getChanges(4, changes));
+	}
+
+	// The first version is immutable
+	BOOST_CHECK(msm::FS_HIDDEN == first->getFieldStatus(3, 4));
+	BOOST_CHECK(msm::FS_HIDDEN == first->getFieldStatus(20, 10));
+
+	// A reset can't be told as changes
+	matrix.reset(msm::Dimensions(8, 8, 10), 1);
+	BOOST_CHECK(4 == publisher.publish(matrix));
+	msm::SnapshotLock reset(publisher, 1);
+	BOOST_CHECK(8 == reset->getDimensions().getX());
+	BOOST_CHECK(!reset->getChanges(3, changes));
+	BOOST_CHECK(reset->getChanges(4, changes));
+
+	matrix.removeObserver(&publisher);
+}
+
+BOOST_AUTO_TEST_CASE(history_test)
+{
+	msm::Matrix matrix;
+	msm::SnapshotPublisher publisher(1, 2);
+	matrix.addObserver(&publisher);
+	matrix.reset(msm::Dimensions(16, 16, 40), 7);
+	publisher.publish(matrix);
+
+	for (uint16_t x = 0; x < 6; ++x)
+	{
+		matrix.at(x, 0).cycleMark();
+		publisher.publish(matrix);
+	}
+	// Without readers only the history of the latest version is retained
+	BOOST_CHECK(7 == publisher.getVersion());
+	BOOST_CHECK(3 == publisher.getRetained());
+
+	std::vector<uint32_t> changes;
+	{
+		msm::SnapshotLock lock(publisher, 0);
+		BOOST_CHECK(lock->getChanges(5, changes));
+		BOOST_CHECK(2 == changes.size());
+		BOOST_CHECK(!lock->getChanges(4, changes));
+		BOOST_CHECK(changes.empty());
+
+		// An acquired version keeps its history
+		for (uint16_t x = 0; x < 6; ++x)
+		{
+			matrix.at(x, 1).cycleMark();
+			publisher.publish(matrix);
+		}
+		BOOST_CHECK(9 == publisher.getRetained());
+		BOOST_CHECK(lock->getChanges(5, changes));
+		BOOST_CHECK(2 == changes.size());
+	}
+	matrix.at(0, 2).cycleMark();
+	publisher.publish(matrix);
+	BOOST_CHECK(3 == publisher.getRetained());
+
+	matrix.removeObserver(&publisher);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_test)
+{
+	unsigned const READERS = 4;
+	msm::Matrix matrix;
+	msm::SnapshotPublisher publisher(READERS, 8);
+	matrix.addObserver(&publisher);
+	matrix.reset(msm::Dimensions(40, 30, 150), 99);
+	publisher.publish(matrix);
+
+	// Each reader follows the versions with the changes and checks its copy of the board
+	std::atomic<bool> stop(false);
+	std::atomic<unsigned> failed(0);
+	std::vector<std::thread> threads;
+	for (unsigned r = 0; r < READERS; ++r)
+		threads.push_back(std::thread([&, r]()
+		{
+			std::vector<uint8_t> board(40 * 30);
+			std::vector<uint32_t> changes;
+			uint64_t seen = 0;
+			while (!stop)
+			{
+				msm::SnapshotLock lock(publisher, r);
+				msm::Snapshot const& s = *lock.get();
+				if (s.getVersion() < seen)
+					++failed;
+				if (s.getChanges(seen, changes))
+					for (size_t i = 0; i < changes.size(); ++i)
+						board[changes[i]] = s.getFieldStatus(changes[i] % 40, changes[i] / 40);
+				else
+					for (uint32_t i = 0; i < board.size(); ++i)
+						board[i] = s.getFieldStatus(i % 40, i / 40);
+				seen = s.getVersion();
+				for (uint32_t i = 0; i < board.size(); ++i)
+					failed += board[i] != s.getFieldStatus(i % 40, i / 40);
+			}
+		}));
+
+	for (unsigned i = 0; i < 3000; ++i)
+	{
+		uint16_t const x = (i * 7) % 40, y = (i * 13) % 30;
+		if (i % 3)
+			matrix.at(x, y).cycleMark();
+		else if (matrix.getStatus() != msm::GS_LOST)
+			matrix.reveal(x, y);
+		publisher.publish(matrix);
+		if (i % 1000 == 999)
+		{
+			matrix.reset(msm::Dimensions(40, 30, 150), i);
+			publisher.publish(matrix);
+		}
+		if (i % 100 == 0)
+			std::this_thread::yield();
+	}
+	stop = true;
+	for (size_t t = 0; t < threads.size(); ++t)
+		threads[t].join();
+
+	BOOST_CHECK(0 == failed);
+	// Without readers the next version frees all but its history
+	matrix.at(0, 0).cycleMark();
+	publisher.publish(matrix);
+	BOOST_CHECK(9 == publisher.getRetained());
+	msm::SnapshotLock lock(publisher, 0);
+	BOOST_CHECK(same(matrix, *lock.get()));
+
+	matrix.removeObserver(&publisher);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
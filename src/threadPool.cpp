@@ -0,0 +1,148 @@
+/**
+ * \addtogroup tools
+ * \{
+ *
+ * \file threadPool.cpp
+ *
+ * Implementation of \ref threadPool.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#include "threadPool.hpp"
+
+#include <stdint.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace msm
+{
+
+struct ThreadPool::Impl
+{
+	Impl(unsigned threads) :
+			threads(threads), task(0), count(0), next(0), generation(0), busy(0), stop(false)
+	{
+	}
+
+	unsigned const threads;
+	std::vector<std::thread> workers;
+
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+
+	/// The current job. Valid while busy > 0.
+	Task const* task;
+	size_t count;
+	std::atomic<size_t> next;
+
+	/// Incremented for each job, so the workers can tell a new job from a spurious wakeup.
+	uint64_t generation;
+	/// Count of workers still working on the current job.
+	unsigned busy;
+	bool stop;
+
+	void work(unsigned thread);
+	void loop(unsigned thread);
+};
+
+ThreadPool::ThreadPool(unsigned threads) :
+		pImpl(new ThreadPool::Impl(threads ? threads : hardwareThreads()))
+{
+	for (unsigned t = 1; t < pImpl->threads; ++t)
+		pImpl->workers.push_back(std::thread(&ThreadPool::Impl::loop, pImpl, t));
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(pImpl->mutex);
+		pImpl->stop = true;
+	}
+	pImpl->wake.notify_all();
+
+	for (size_t i = 0; i < pImpl->workers.size(); ++i)
+		pImpl->workers[i].join();
+
+	delete pImpl;
+}
+
+unsigned ThreadPool::getThreadCount() const
+{
+	return pImpl->threads;
+}
+
+void ThreadPool::run(size_t count, Task const& task)
+{
+	if (count == 0)
+		return;
+
+	if (pImpl->workers.empty() || count == 1)
+	{
+		for (size_t i = 0; i < count; ++i)
+			task(i, 0);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(pImpl->mutex);
+		pImpl->task = &task;
+		pImpl->count = count;
+		pImpl->next.store(0);
+		pImpl->busy = pImpl->workers.size();
+		++pImpl->generation;
+	}
+	pImpl->wake.notify_all();
+
+	pImpl->work(0);
+
+	std::unique_lock<std::mutex> lock(pImpl->mutex);
+	while (pImpl->busy > 0)
+		pImpl->done.wait(lock);
+	pImpl->task = 0;
+}
+
+unsigned ThreadPool::hardwareThreads()
+{
+	unsigned n = std::thread::hardware_concurrency();
+	return n ? n : 1;
+}
+
+void ThreadPool::Impl::work(unsigned thread)
+{
+	size_t i;
+	while ((i = next.fetch_add(1)) < count)
+		(*task)(i, thread);
+}
+
+void ThreadPool::Impl::loop(unsigned thread)
+{
+	uint64_t seen = 0;
+
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			while (!stop && generation == seen)
+				wake.wait(lock);
+			if (stop)
+				return;
+			seen = generation;
+		}
+
+		work(thread);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		if (--busy == 0)
+			done.notify_one();
+	}
+}
+
+} // namespace msm
+
+///\}
@@ -0,0 +1,62 @@
+/**
+ * \addtogroup tools
+ * \{
+ *
+ * \file threadPool.hpp
+ *
+ * \date 18.10.2026
+ * \author Moritz Nisblé moritz.nisble@gmx.de
+ */
+
+#ifndef THREADPOOL_HPP_
+#define THREADPOOL_HPP_
+
+#include <stddef.h>
+#include <functional>
+
+namespace msm
+{
+
+/**
+ * A fixed set of worker threads that process indexed tasks.
+ * The calling thread takes part in the work, so a pool with one thread
+ * doesn't start any worker and runs everything serially.
+ */
+class ThreadPool
+{
+public:
+	struct Impl;
+
+	/// A task. Gets the index of the task and the index of the executing thread (0 to getThreadCount() - 1).
+	typedef std::function<void(size_t task, unsigned thread)> Task;
+
+	/** Constructor.
+	 * \param threads The count of threads including the calling one. 0 for one per hardware thread. */
+	explicit ThreadPool(unsigned threads);
+	/// Destructor. Joins all workers.
+	~ThreadPool();
+
+	/// Get the count of threads including the calling one.
+	unsigned getThreadCount() const;
+
+	/** Run tasks 0 to count - 1 and wait for their completion.
+	 * The tasks are handed out dynamically in ascending order.
+	 * \param count The count of tasks.
+	 * \param task The function to execute for each task. It must not throw. */
+	void run(size_t count, Task const& task);
+
+	/// Get the count of hardware threads (at least 1).
+	static unsigned hardwareThreads();
+
+private:
+	Impl* pImpl;
+
+	ThreadPool(ThreadPool const& cp);
+	ThreadPool& operator=(ThreadPool const& cp);
+};
+
+} // namespace msm
+
+#endif /* THREADPOOL_HPP_ */
+
+///\}
@@ -12,8 +12,8 @@
 #define SRC_TOOLS_HPP_
 
 #include <stdint.h>
+#include <cstdio>
 #include <exception>
-#include <sstream>
 
 #include "field.hpp"
 
@@ -41,16 +41,19 @@ class IndexOutOfBoundsException: public std::exception
 {
 public:
 	/// Constructor.
-	IndexOutOfBoundsException() throw ();
+	IndexOutOfBoundsException() throw () :
+			idx(0), len(0), dim('?')
+	{
+		format();
+	}
 	/** Constructor.
 	 * \param index The index that was illegal accessed.
 	 * \param length The length of the array.
 	 * \param dimension A char describing the dimension in the Matrix (e.g. 'X'). */
-	IndexOutOfBoundsException(uint16_t index, uint16_t length, char dimension) throw ()
+	IndexOutOfBoundsException(uint16_t index, uint16_t length, char dimension) throw () :
+			idx(index), len(length), dim(dimension)
 	{
-		idx = index;
-		len = length;
-		dim = dimension;
+		format();
 	}
 	/// Destructor.
 	virtual ~IndexOutOfBoundsException() throw ()
@@ -60,23 +63,34 @@ public:
 	 * \return A c-style string with the error message. */
 	virtual const char* what() const throw ()
 	{
-		std::stringstream ss;
-		ss << "Matrix index out of bounds. Index: " << idx << " exceeding array length of: " << len << " in dimension: "
-				<< dim;
-		return ss.str().c_str();
+		return msg;
 	}
 
 	uint16_t idx;
 	uint16_t len;
 	char dim;
+
+private:
+	/// The message is built once and kept in the exception itself.
+	void format() throw ()
+	{
+		snprintf(msg, sizeof(msg), "Matrix index out of bounds. Index: %u exceeding array length of: %u in dimension: %c",
+				(unsigned) idx, (unsigned) len, dim);
+	}
+
+	char msg[96];
 };
 
 /// Helper class to enable overloading of the 2-dimensional array operator.
 class Proxy
 {
 public:
-	Proxy(Field** x, uint16_t maxY) :
-			x(x), maxY(maxY)
+	/** Constructor.
+	 * \param x The first field of the column in the row-major storage.
+	 * \param maxY The count of rows.
+	 * \param stride The distance between two rows (count of columns). */
+	Proxy(Field* const* x, uint16_t maxY, uint16_t stride) :
+			x(x), maxY(maxY), stride(stride)
 	{
 	}
 
@@ -89,11 +103,12 @@ public:
 		if (y >= maxY)
 			throw IndexOutOfBoundsException(y, maxY, 'Y');
 		else
-			return *x[y];
+			return *x[(size_t) y * stride];
 	}
 private:
-	Field** x;
+	Field* const* x;
 	uint16_t maxY;
+	uint16_t stride;
 };
 
 } // namespace msm